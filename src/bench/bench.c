@@ -0,0 +1,397 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../s21_internal.h"
+
+/*
+ * Счётчики выделений памяти. Бенчмарк линкуется с
+ * -Wl,--wrap=malloc,--wrap=calloc,--wrap=free,--wrap=aligned_alloc, поэтому
+ * все вызовы из библиотеки проходят через эти обёртки.
+ */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_aligned_alloc(size_t alignment, size_t size);
+void __real_free(void *memory);
+
+static long long alloc_count = 0;
+static long long alloc_bytes = 0;
+
+void *__wrap_malloc(size_t size) {
+  alloc_count++;
+  alloc_bytes += size;
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+  alloc_count++;
+  alloc_bytes += count * size;
+  return __real_calloc(count, size);
+}
+
+void *__wrap_aligned_alloc(size_t alignment, size_t size) {
+  alloc_count++;
+  alloc_bytes += size;
+  return __real_aligned_alloc(alignment, size);
+}
+
+void __wrap_free(void *memory) { __real_free(memory); }
+
+typedef struct bench_data {
+  matrix_t a;
+  matrix_t b;
+  matrix_t out;
+  arena_t arena;
+} bench_data;
+
+typedef enum bench_cost {
+  COST_WRITE,
+  COST_READ_WRITE,
+  COST_SCALE,
+  COST_BINARY,
+  COST_FUSED,
+  COST_GEMM,
+  COST_DETERMINANT,
+  COST_INVERSE
+} bench_cost;
+
+typedef struct bench_op {
+  const char *name;
+  int (*run)(bench_data *d);
+  int square;
+  int max_size;
+  bench_cost cost;
+} bench_op;
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void fill_matrix(matrix_t *A, unsigned seed) {
+  for (int i = 0; i < A->rows; i++) {
+    for (int j = 0; j < A->columns; j++) {
+      seed = seed * 1103515245 + 12345;
+      A->matrix[i][j] = (double)(seed >> 16 & 0x7fff) / 0x7fff - 0.5;
+    }
+    if (i < A->columns) A->matrix[i][i] += A->rows;
+  }
+}
+
+/**
+ * Функция op_cost оценивает объём работы операции над матрицами m x k и
+ * k x n (для поэлементных операций k = n): количество операций с плавающей
+ * точкой и объём памяти, который нужно прочитать и записать.
+ */
+static void op_cost(bench_cost cost, int m, int n, int k, double *flops,
+                    double *bytes) {
+  double mn = (double)m * n;
+  *flops = 0;
+  *bytes = 8 * mn;
+  if (cost == COST_READ_WRITE) {
+    *bytes = 16 * mn;
+  } else if (cost == COST_SCALE) {
+    *flops = mn;
+    *bytes = 16 * mn;
+  } else if (cost == COST_BINARY) {
+    *flops = mn;
+    *bytes = 24 * mn;
+  } else if (cost == COST_FUSED) {
+    *flops = 3 * mn;
+    *bytes = 32 * mn;
+  } else if (cost == COST_GEMM) {
+    *flops = 2 * mn * k;
+    *bytes = 8 * ((double)m * k + (double)k * n + mn);
+  } else if (cost == COST_DETERMINANT) {
+    *flops = 2.0 / 3 * mn * n;
+  } else if (cost == COST_INVERSE) {
+    *flops = 2 * mn * n;
+    *bytes = 16 * mn;
+  }
+}
+
+static int run_create(bench_data *d) {
+  matrix_t r = {0};
+  int res = s21_create_matrix(d->a.rows, d->a.columns, &r);
+  s21_remove_matrix(&r);
+  return res;
+}
+
+static int run_eq(bench_data *d) {
+  return s21_eq_matrix(&d->a, &d->b) == SUCCESS ? OK : CALC_ERROR;
+}
+
+#define RUN_CREATING(name, call)  \
+  static int name(bench_data *d) { \
+    matrix_t r = {0};              \
+    int res = call;                \
+    s21_remove_matrix(&r);         \
+    return res;                    \
+  }
+
+RUN_CREATING(run_sum, s21_sum_matrix(&d->a, &d->b, &r))
+RUN_CREATING(run_sub, s21_sub_matrix(&d->a, &d->b, &r))
+RUN_CREATING(run_mult_number, s21_mult_number(&d->a, 1.5, &r))
+RUN_CREATING(run_mult_matrix, s21_mult_matrix(&d->a, &d->b, &r))
+RUN_CREATING(run_transpose, s21_transpose(&d->a, &r))
+RUN_CREATING(run_complements, s21_calc_complements(&d->a, &r))
+RUN_CREATING(run_inverse, s21_inverse_matrix(&d->a, &r))
+RUN_CREATING(run_solve, s21_solve(&d->a, &d->b, &r))
+
+static int run_determinant(bench_data *d) {
+  double det = 0;
+  return s21_determinant(&d->a, &det);
+}
+
+static int run_sum_into(bench_data *d) {
+  return s21_sum_matrix_into(&d->a, &d->b, &d->out);
+}
+static int run_sub_into(bench_data *d) {
+  return s21_sub_matrix_into(&d->a, &d->b, &d->out);
+}
+static int run_mult_number_into(bench_data *d) {
+  return s21_mult_number_into(&d->a, 1.5, &d->out);
+}
+static int run_mult_matrix_into(bench_data *d) {
+  return s21_mult_matrix_into(&d->a, &d->b, &d->out);
+}
+static int run_transpose_into(bench_data *d) {
+  return s21_transpose_into(&d->a, &d->out);
+}
+static int run_sum_inplace(bench_data *d) {
+  return s21_sum_matrix_inplace(&d->a, &d->b);
+}
+static int run_sub_inplace(bench_data *d) {
+  return s21_sub_matrix_inplace(&d->a, &d->b);
+}
+static int run_mult_number_inplace(bench_data *d) {
+  return s21_mult_number_inplace(&d->a, 1.0);
+}
+static int run_transpose_inplace(bench_data *d) {
+  return s21_transpose_inplace(&d->a);
+}
+
+static int run_arena_matrix(bench_data *d) {
+  arena_mark_t mark = s21_arena_mark(&d->arena);
+  matrix_t r = {0};
+  int res = s21_arena_matrix(&d->arena, d->a.rows, d->a.columns, &r);
+  s21_arena_release(&d->arena, mark);
+  return res;
+}
+
+/*
+ * Выражение 1.5 * A + B - C двумя способами: цепочкой публичных операций с
+ * промежуточными матрицами и одним проходом через s21_expr_eval_into. В
+ * качестве C используется матрица out, в неё же записывается результат.
+ */
+static int run_chain(bench_data *d) {
+  matrix_t scaled = {0}, sum = {0}, r = {0};
+  int res = s21_mult_number(&d->a, 1.5, &scaled);
+  if (res == OK) res = s21_sum_matrix(&scaled, &d->b, &sum);
+  if (res == OK) res = s21_sub_matrix(&sum, &d->out, &r);
+  s21_remove_matrix(&scaled);
+  s21_remove_matrix(&sum);
+  s21_remove_matrix(&r);
+  return res;
+}
+
+static int run_expr(bench_data *d) {
+  s21_expr_t e;
+  s21_expr_init(&e);
+  s21_expr_load(&e, &d->a);
+  s21_expr_scale(&e, 1.5);
+  s21_expr_load(&e, &d->b);
+  s21_expr_add(&e);
+  s21_expr_load(&e, &d->out);
+  s21_expr_sub(&e);
+  return s21_expr_eval_into(&e, &d->out);
+}
+
+#define LAPLACE_MAX 8
+
+/*
+ * Эталонное обращение через алгебраические дополнения с разложением миноров
+ * по первой строке (формула Лапласа, O(n!)): так библиотека обращала матрицы
+ * до появления LU. Реализация живёт только в бенчмарке, чтобы замер
+ * inverse_laplace можно было сравнить с inverse_matrix.
+ */
+static void laplace_minor(const double *a, int n, int row, int column,
+                          double *minor) {
+  int k = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n && i != row; j++) {
+      if (j != column) minor[k++] = a[i * n + j];
+    }
+  }
+}
+
+static double laplace_determinant(const double *a, int n) {
+  if (n == 1) return a[0];
+  double minor[LAPLACE_MAX * LAPLACE_MAX];
+  double det = 0;
+  for (int j = 0; j < n; j++) {
+    laplace_minor(a, n, 0, j, minor);
+    det += (j % 2 ? -a[j] : a[j]) * laplace_determinant(minor, n - 1);
+  }
+  return det;
+}
+
+static int run_laplace_inverse(bench_data *d) {
+  int n = d->a.rows;
+  if (n > LAPLACE_MAX) return CALC_ERROR;
+  double a[LAPLACE_MAX * LAPLACE_MAX], minor[LAPLACE_MAX * LAPLACE_MAX];
+  for (int i = 0; i < n; i++) {
+    memcpy(a + i * n, d->a.matrix[i], sizeof(double) * n);
+  }
+  double det = laplace_determinant(a, n);
+  if (det == 0) return CALC_ERROR;
+
+  matrix_t r = {0};
+  int res = s21_create_matrix(n, n, &r);
+  for (int i = 0; i < n && res == OK; i++) {
+    for (int j = 0; j < n; j++) {
+      laplace_minor(a, n, i, j, minor);
+      double cofactor = n == 1 ? 1 : laplace_determinant(minor, n - 1);
+      r.matrix[j][i] = ((i + j) % 2 ? -cofactor : cofactor) / det;
+    }
+  }
+  s21_remove_matrix(&r);
+  return res;
+}
+
+static const bench_op ops[] = {
+    {"create_remove", run_create, 0, 4096, COST_WRITE},
+    {"eq_matrix", run_eq, 0, 4096, COST_READ_WRITE},
+    {"sum_matrix", run_sum, 0, 4096, COST_BINARY},
+    {"sub_matrix", run_sub, 0, 4096, COST_BINARY},
+    {"mult_number", run_mult_number, 0, 4096, COST_SCALE},
+    {"mult_matrix", run_mult_matrix, 0, 1024, COST_GEMM},
+    {"transpose", run_transpose, 0, 4096, COST_READ_WRITE},
+    {"determinant", run_determinant, 1, 1024, COST_DETERMINANT},
+    {"calc_complements", run_complements, 1, 1024, COST_INVERSE},
+    {"inverse_matrix", run_inverse, 1, 1024, COST_INVERSE},
+    {"inverse_laplace", run_laplace_inverse, 1, LAPLACE_MAX, COST_INVERSE},
+    {"solve", run_solve, 1, 1024, COST_INVERSE},
+    {"sum_matrix_into", run_sum_into, 0, 4096, COST_BINARY},
+    {"sub_matrix_into", run_sub_into, 0, 4096, COST_BINARY},
+    {"mult_number_into", run_mult_number_into, 0, 4096, COST_SCALE},
+    {"mult_matrix_into", run_mult_matrix_into, 0, 1024, COST_GEMM},
+    {"transpose_into", run_transpose_into, 0, 4096, COST_READ_WRITE},
+    {"sum_matrix_inplace", run_sum_inplace, 0, 4096, COST_BINARY},
+    {"sub_matrix_inplace", run_sub_inplace, 0, 4096, COST_BINARY},
+    {"mult_number_inplace", run_mult_number_inplace, 0, 4096, COST_SCALE},
+    {"transpose_inplace", run_transpose_inplace, 1, 4096, COST_READ_WRITE},
+    {"arena_matrix", run_arena_matrix, 0, 4096, COST_WRITE},
+    {"chain_scale_sum_sub", run_chain, 0, 4096, COST_FUSED},
+    {"expr_scale_sum_sub", run_expr, 0, 4096, COST_FUSED},
+};
+
+static const char *shapes[] = {"square", "tall", "wide"};
+
+/*
+ * Размеры операндов для формы shape: квадратная n x n, высокая n x n/16 и
+ * широкая n/16 x n. Для умножения B имеет транспонированную форму A, для
+ * поэлементных операций — ту же, что и A.
+ */
+static void shape_dims(const bench_op *op, int shape, int n, int *m, int *k,
+                       int *p) {
+  int small = n / 16 > 0 ? n / 16 : 1;
+  *m = shape == 2 ? small : n;
+  *k = shape == 1 ? small : n;
+  *p = *k;
+  if (op->cost == COST_GEMM) *p = *m;
+}
+
+static int prepare(const bench_op *op, int m, int k, int p, bench_data *d) {
+  int gemm = op->cost == COST_GEMM;
+  int res = s21_create_matrix(m, k, &d->a);
+  if (res == OK) res = s21_create_matrix(gemm ? k : m, p, &d->b);
+  if (res == OK) {
+    res = op->run == run_transpose_into ? s21_create_matrix(k, m, &d->out)
+                                        : s21_create_matrix(m, p, &d->out);
+  }
+  if (res == OK) res = s21_arena_create(0, &d->arena);
+  if (res == OK) {
+    fill_matrix(&d->a, 1);
+    fill_matrix(&d->b, op->run == run_eq ? 1 : 2);
+  }
+  return res;
+}
+
+static void release(bench_data *d) {
+  s21_remove_matrix(&d->a);
+  s21_remove_matrix(&d->b);
+  s21_remove_matrix(&d->out);
+  s21_arena_destroy(&d->arena);
+  memset(d, 0, sizeof(*d));
+}
+
+static int first_result = 1;
+
+static void measure(const bench_op *op, int shape, int n, double min_time) {
+  int m = 0, k = 0, p = 0;
+  shape_dims(op, shape, n, &m, &k, &p);
+  bench_data d = {0};
+  if (prepare(op, m, k, p, &d) != OK) {
+    release(&d);
+    return;
+  }
+
+  int status = op->run(&d);
+  long long reps = 0;
+  long long allocs = alloc_count, bytes = alloc_bytes;
+  double start = now_sec(), elapsed = 0;
+  do {
+    op->run(&d);
+    reps++;
+    elapsed = now_sec() - start;
+  } while (elapsed < min_time);
+  allocs = alloc_count - allocs;
+  bytes = alloc_bytes - bytes;
+  release(&d);
+
+  double seconds = elapsed / reps;
+  double flops = 0, traffic = 0;
+  op_cost(op->cost, m, p, k, &flops, &traffic);
+  printf("%s\n    {\"op\": \"%s\", \"shape\": \"%s\", \"rows\": %d, "
+         "\"columns\": %d, \"inner\": %d, \"status\": %d, \"reps\": %lld, "
+         "\"ns_per_op\": %.1f, \"gflops\": %.3f, \"gb_per_s\": %.3f, "
+         "\"allocs_per_op\": %.2f, \"alloc_bytes_per_op\": %.0f}",
+         first_result ? "" : ",", op->name, shapes[shape], m, p, k, status,
+         reps, seconds * 1e9, flops / seconds * 1e-9,
+         traffic / seconds * 1e-9, (double)allocs / reps,
+         (double)bytes / reps);
+  first_result = 0;
+  fflush(stdout);
+}
+
+/**
+ * Бенчмарк всех публичных операций библиотеки. Для каждой операции перебираются
+ * размеры 4, 8, ..., max_size (не больше предела операции) и формы операндов:
+ * квадратная, высокая и широкая (для операций над квадратными матрицами —
+ * только квадратная). Результат печатается в stdout в формате JSON.
+ *
+ * Аргументы: [max_size] [min_time в секундах на замер] [количество потоков].
+ */
+int main(int argc, char **argv) {
+  int max_size = argc > 1 ? atoi(argv[1]) : 4096;
+  double min_time = argc > 2 ? atof(argv[2]) : 0.05;
+  int threads = argc > 3 ? atoi(argv[3]) : 1;
+  s21_set_num_threads(threads);
+
+  printf("{\n  \"isa\": \"%s\",\n  \"threads\": %d,\n  \"min_time\": %g,\n"
+         "  \"results\": [",
+         simd_name(), s21_get_num_threads(), min_time);
+  size_t count = sizeof(ops) / sizeof(ops[0]);
+  for (size_t i = 0; i < count; i++) {
+    for (int shape = 0; shape < (ops[i].square ? 1 : 3); shape++) {
+      for (int n = 4; n <= max_size && n <= ops[i].max_size; n *= 2) {
+        measure(&ops[i], shape, n, min_time);
+      }
+    }
+  }
+  printf("\n  ]\n}\n");
+  return 0;
+}
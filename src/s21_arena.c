@@ -0,0 +1,202 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <string.h>
+
+#include "s21_internal.h"
+
+struct arena_block {
+  struct arena_block *next;
+  size_t size;
+  size_t used;
+};
+
+#define BLOCK_HEADER \
+  ((sizeof(arena_block) + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN)
+
+static size_t align_size(size_t size) {
+  return (size + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN;
+}
+
+static arena_block *new_block(size_t size) {
+  size = align_size(size);
+  arena_block *block = aligned_alloc(MATRIX_ALIGN, BLOCK_HEADER + size);
+  if (block != NULL) {
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+  }
+  return block;
+}
+
+/**
+ * Функция s21_arena_create создаёт арену — область памяти для временных
+ * матриц, из которой память выделяется сдвигом указателя и освобождается
+ * целиком (s21_arena_reset) или до сохранённой отметки (s21_arena_release).
+ * Когда текущий блок заканчивается, арена добавляет новый; блоки сохраняются
+ * для повторного использования до вызова s21_arena_destroy.
+ *
+ * @param capacity Размер первого блока в байтах; 0 означает ARENA_BLOCK_SIZE.
+ * @param arena Указатель на структуру арены, которую нужно инициализировать.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если arena равен NULL, или `CALC_ERROR`,
+ * если не удалось выделить память.
+ */
+int s21_arena_create(size_t capacity, arena_t *arena) {
+  if (arena == NULL) return INCORRECT_MATRIX;
+  if (capacity == 0) capacity = ARENA_BLOCK_SIZE;
+
+  arena->first = new_block(capacity);
+  arena->current = arena->first;
+  arena->block_size = capacity;
+  return arena->first != NULL ? OK : CALC_ERROR;
+}
+
+/**
+ * Функция s21_arena_destroy освобождает все блоки арены. Матрицы, выделенные
+ * из арены, после этого использовать нельзя.
+ *
+ * @param arena Указатель на арену; NULL допускается.
+ */
+void s21_arena_destroy(arena_t *arena) {
+  if (arena == NULL) return;
+  arena_block *block = arena->first;
+  while (block != NULL) {
+    arena_block *next = block->next;
+    free(block);
+    block = next;
+  }
+  arena->first = NULL;
+  arena->current = NULL;
+}
+
+/**
+ * Функция s21_arena_reset освобождает сразу все выделения арены, оставляя её
+ * блоки для повторного использования.
+ *
+ * @param arena Указатель на арену; NULL допускается.
+ */
+void s21_arena_reset(arena_t *arena) {
+  if (arena == NULL || arena->first == NULL) return;
+  arena->current = arena->first;
+  arena->first->used = 0;
+}
+
+/**
+ * Функция s21_arena_mark запоминает текущее состояние арены, чтобы потом
+ * освободить всё, что было выделено после этого момента. Для NULL возвращает
+ * пустую отметку, которую s21_arena_release игнорирует.
+ */
+arena_mark_t s21_arena_mark(arena_t *arena) {
+  arena_mark_t mark = {NULL, 0};
+  if (arena != NULL && arena->current != NULL) {
+    mark.block = arena->current;
+    mark.used = arena->current->used;
+  }
+  return mark;
+}
+
+/**
+ * Функция s21_arena_release освобождает все выделения, сделанные после
+ * получения отметки mark. Отметки должны освобождаться в обратном порядке.
+ */
+void s21_arena_release(arena_t *arena, arena_mark_t mark) {
+  if (mark.block != NULL) {
+    arena->current = mark.block;
+    arena->current->used = mark.used;
+  }
+}
+
+/**
+ * Функция arena_alloc выделяет из арены size байт, выровненных на
+ * MATRIX_ALIGN. Память не обнуляется.
+ *
+ * @return Указатель на выделенную память или NULL, если не удалось добавить
+ * новый блок.
+ */
+void *arena_alloc(arena_t *arena, size_t size) {
+  size = align_size(size);
+  arena_block *block = arena->current;
+  if (block == NULL) return NULL;
+
+  if (block->size - block->used < size) {
+    arena_block *next = block->next;
+    if (next != NULL && next->size >= size) {
+      next->used = 0;
+    } else {
+      size_t block_size = arena->block_size > size ? arena->block_size : size;
+      arena_block *fresh = new_block(block_size);
+      if (fresh == NULL) return NULL;
+      fresh->next = next;
+      block->next = fresh;
+      next = fresh;
+    }
+    arena->current = block = next;
+  }
+
+  void *memory = (char *)block + BLOCK_HEADER + block->used;
+  block->used += size;
+  return memory;
+}
+
+/**
+ * Функция s21_arena_matrix создаёт матрицу в памяти арены. Матрица устроена
+ * так же, как созданная s21_create_matrix (один непрерывный выровненный блок,
+ * элементы обнулены), но её нельзя передавать в s21_remove_matrix: память
+ * возвращается вместе с ареной.
+ *
+ * @param arena Указатель на арену.
+ * @param rows Количество строк.
+ * @param columns Количество столбцов.
+ * @param result Указатель на структуру создаваемой матрицы.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если параметры неверны, или `CALC_ERROR`,
+ * если не удалось выделить память.
+ */
+int s21_arena_matrix(arena_t *arena, int rows, int columns, matrix_t *result) {
+  if (arena == NULL || rows < 1 || columns < 1 || result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+
+  size_t header = align_size(sizeof(double *) * rows);
+  size_t data = sizeof(double) * rows * columns;
+  double **matrix = arena_alloc(arena, header + data);
+  if (matrix == NULL) return CALC_ERROR;
+
+  double *block = (double *)((char *)matrix + header);
+  memset(block, 0, data);
+  for (int i = 0; i < rows; i++) {
+    matrix[i] = block + (size_t)i * columns;
+  }
+
+  result->matrix = matrix;
+  result->rows = rows;
+  result->columns = columns;
+  return OK;
+}
+
+static pthread_key_t scratch_key;
+static pthread_once_t scratch_once = PTHREAD_ONCE_INIT;
+static _Thread_local arena_t scratch = {0};
+
+static void scratch_free(void *arena) { s21_arena_destroy(arena); }
+
+static void scratch_key_create(void) {
+  pthread_key_create(&scratch_key, scratch_free);
+}
+
+/**
+ * Функция scratch_arena возвращает временную арену текущего потока, которую
+ * библиотека использует для промежуточных данных. У каждого потока своя арена,
+ * поэтому параллельные вызовы не конкурируют за общий распределитель памяти.
+ * Пользователь арены обязан вернуть её к отметке, полученной до выделения.
+ *
+ * @return Указатель на арену потока или NULL, если её не удалось создать.
+ */
+arena_t *scratch_arena(void) {
+  if (scratch.first == NULL) {
+    pthread_once(&scratch_once, scratch_key_create);
+    if (s21_arena_create(ARENA_BLOCK_SIZE, &scratch) != OK) return NULL;
+    pthread_setspecific(scratch_key, &scratch);
+  }
+  return &scratch;
+}
@@ -0,0 +1,422 @@
+#include <string.h>
+
+#include "s21_internal.h"
+
+/*
+ * Пакет хранит элемент (i, j) всех матриц подряд: data[(i * columns + j) *
+ * stride + b], где stride — количество матриц, округлённое вверх до
+ * BATCH_LANES. Если плоскости элементов оказались бы кратны 4 КБ, stride
+ * увеличивается на BATCH_LANES: иначе соседние плоскости попадают в одни и те
+ * же наборы кэша и умножение замедляется в 2-3 раза.
+ *
+ * Ядра обрабатывают по BATCH_LANES матриц за раз векторами lanes_t (векторные
+ * расширения GCC): каждая полоса вектора считает свою матрицу, а выбор
+ * ведущего элемента, который у полос разный, делается масками без ветвлений.
+ * На x86 ядра собираются в вариантах для AVX-512, AVX2 и базового SSE2,
+ * нужный выбирается при загрузке.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define BATCH_KERNEL \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define BATCH_KERNEL
+#endif
+
+typedef double lanes_t
+    __attribute__((vector_size(sizeof(double) * BATCH_LANES)));
+typedef long long mask_t
+    __attribute__((vector_size(sizeof(double) * BATCH_LANES)));
+
+#define LANES_LOAD(v, p) memcpy(&(v), (p), sizeof(lanes_t))
+#define LANES_STORE(p, v) memcpy((p), &(v), sizeof(lanes_t))
+#define LANES_SELECT(mask, a, b) \
+  ((lanes_t)(((mask_t)(a) & (mask)) | ((mask_t)(b) & ~(mask))))
+#define LANES_ABS(v) ((lanes_t)((mask_t)(v) & 0x7fffffffffffffffLL))
+
+static int is_correct_batch(const s21_batch_t *batch) {
+  return batch == NULL || batch->data == NULL || batch->rows < 1 ||
+                 batch->columns < 1 || batch->count < 1
+             ? INCORRECT_MATRIX
+             : OK;
+}
+
+/**
+ * Функция check_batch_output проверяет, что пакет для записи результата уже
+ * создан и имеет ожидаемые размеры.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если пакет неверен, или `CALC_ERROR`, если
+ * размеры не совпадают.
+ */
+static int check_batch_output(const s21_batch_t *result, int rows,
+                              int columns, int count) {
+  int res = is_correct_batch(result);
+  if (res == OK && (result->rows != rows || result->columns != columns ||
+                    result->count != count)) {
+    res = CALC_ERROR;
+  }
+  return res;
+}
+
+/**
+ * Функция s21_create_batch создаёт пакет из count матриц размером
+ * rows x columns одним выровненным блоком памяти. Элементы обнуляются.
+ *
+ * @param rows Количество строк, от 1 до BATCH_MAX_ORDER.
+ * @param columns Количество столбцов, от 1 до BATCH_MAX_ORDER.
+ * @param count Количество матриц в пакете.
+ * @param result Указатель на структуру создаваемого пакета.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если параметры неверны, или `CALC_ERROR`,
+ * если не удалось выделить память.
+ */
+int s21_create_batch(int rows, int columns, int count, s21_batch_t *result) {
+  if (result == NULL || rows < 1 || columns < 1 || count < 1 ||
+      rows > BATCH_MAX_ORDER || columns > BATCH_MAX_ORDER) {
+    return INCORRECT_MATRIX;
+  }
+
+  int stride = (count + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES;
+  if (stride % 512 == 0) stride += BATCH_LANES;
+  size_t size = sizeof(double) * rows * columns * (size_t)stride;
+  size = (size + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN;
+  result->data = aligned_alloc(MATRIX_ALIGN, size);
+  if (result->data == NULL) return CALC_ERROR;
+
+  memset(result->data, 0, size);
+  result->rows = rows;
+  result->columns = columns;
+  result->count = count;
+  result->stride = stride;
+  return OK;
+}
+
+/**
+ * Функция s21_remove_batch освобождает память пакета.
+ */
+void s21_remove_batch(s21_batch_t *batch) {
+  if (batch != NULL) {
+    free(batch->data);
+    memset(batch, 0, sizeof(*batch));
+  }
+}
+
+/**
+ * Функция s21_batch_pack копирует в пакет матрицы из обычного массива, где
+ * матрица b хранится построчно начиная с src + b * matrix_stride.
+ *
+ * @param src Указатель на первую матрицу.
+ * @param matrix_stride Расстояние между началами соседних матриц в элементах,
+ * не меньше rows * columns.
+ * @param batch Пакет, созданный s21_create_batch.
+ *
+ * @return `OK` или `INCORRECT_MATRIX`, если параметры неверны.
+ */
+int s21_batch_pack(const double *src, size_t matrix_stride,
+                   s21_batch_t *batch) {
+  if (is_correct_batch(batch) != OK || src == NULL) return INCORRECT_MATRIX;
+  size_t size = (size_t)batch->rows * batch->columns;
+  if (matrix_stride < size) return INCORRECT_MATRIX;
+
+  for (int b = 0; b < batch->count; b++) {
+    const double *matrix = src + b * matrix_stride;
+    for (size_t e = 0; e < size; e++) {
+      batch->data[e * batch->stride + b] = matrix[e];
+    }
+  }
+  return OK;
+}
+
+/**
+ * Функция s21_batch_unpack копирует матрицы пакета в обычный массив, обратно
+ * s21_batch_pack.
+ *
+ * @return `OK` или `INCORRECT_MATRIX`, если параметры неверны.
+ */
+int s21_batch_unpack(const s21_batch_t *batch, double *dst,
+                     size_t matrix_stride) {
+  if (is_correct_batch(batch) != OK || dst == NULL) return INCORRECT_MATRIX;
+  size_t size = (size_t)batch->rows * batch->columns;
+  if (matrix_stride < size) return INCORRECT_MATRIX;
+
+  for (int b = 0; b < batch->count; b++) {
+    double *matrix = dst + b * matrix_stride;
+    for (size_t e = 0; e < size; e++) {
+      matrix[e] = batch->data[e * batch->stride + b];
+    }
+  }
+  return OK;
+}
+
+BATCH_KERNEL static void mult_lanes(int m, int n, int k, const double *a,
+                                    const double *b, double *c, int stride) {
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      lanes_t acc = {0}, x, y;
+      for (int p = 0; p < k; p++) {
+        LANES_LOAD(x, a + (size_t)(i * k + p) * stride);
+        LANES_LOAD(y, b + (size_t)(p * n + j) * stride);
+        acc += x * y;
+      }
+      LANES_STORE(c + (size_t)(i * n + j) * stride, acc);
+    }
+  }
+}
+
+static int check_mult(s21_batch_t *A, s21_batch_t *B) {
+  if (is_correct_batch(A) != OK || is_correct_batch(B) != OK) {
+    return INCORRECT_MATRIX;
+  }
+  return A->columns != B->rows || A->count != B->count ? CALC_ERROR : OK;
+}
+
+/**
+ * Функция s21_batch_mult_into перемножает матрицы пакетов попарно,
+ * result[b] = A[b] * B[b], и записывает произведения в уже созданный пакет
+ * result. result не может совпадать с A или B.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если один из пакетов неверен, или
+ * `CALC_ERROR`, если размеры или количество матриц не подходят либо result
+ * совпадает с A или B.
+ */
+int s21_batch_mult_into(s21_batch_t *A, s21_batch_t *B, s21_batch_t *result) {
+  int res = check_mult(A, B);
+  if (res == OK) {
+    res = check_batch_output(result, A->rows, B->columns, A->count);
+  }
+  if (res == OK && (result->data == A->data || result->data == B->data)) {
+    res = CALC_ERROR;
+  }
+  for (int b0 = 0; res == OK && b0 < A->stride; b0 += BATCH_LANES) {
+    mult_lanes(A->rows, B->columns, A->columns, A->data + b0, B->data + b0,
+               result->data + b0, A->stride);
+  }
+  return res;
+}
+
+/**
+ * Функция s21_batch_mult перемножает матрицы пакетов попарно так же, как
+ * s21_batch_mult_into, создавая для результата новый пакет result.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если пакет неверен или result равен NULL,
+ * или `CALC_ERROR`, если размеры или количество матриц не подходят.
+ */
+int s21_batch_mult(s21_batch_t *A, s21_batch_t *B, s21_batch_t *result) {
+  int res = check_mult(A, B);
+  if (res == OK && result == NULL) res = INCORRECT_MATRIX;
+  if (res == OK) res = s21_create_batch(A->rows, B->columns, A->count, result);
+  if (res == OK) res = s21_batch_mult_into(A, B, result);
+  return res;
+}
+
+/**
+ * Функция s21_batch_transpose_into транспонирует все матрицы пакета в уже
+ * созданный пакет result. В SoA-хранении это перестановка плоскостей
+ * элементов целиком. result не может совпадать с A.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если один из пакетов неверен, или
+ * `CALC_ERROR`, если размеры не подходят либо result совпадает с A.
+ */
+int s21_batch_transpose_into(s21_batch_t *A, s21_batch_t *result) {
+  int res = is_correct_batch(A);
+  if (res == OK) {
+    res = check_batch_output(result, A->columns, A->rows, A->count);
+  }
+  if (res == OK && result->data == A->data) res = CALC_ERROR;
+  for (int i = 0; res == OK && i < A->rows; i++) {
+    for (int j = 0; j < A->columns; j++) {
+      memcpy(result->data + (size_t)(j * A->rows + i) * A->stride,
+             A->data + (size_t)(i * A->columns + j) * A->stride,
+             sizeof(double) * A->stride);
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция s21_batch_transpose транспонирует все матрицы пакета, создавая для
+ * результата новый пакет result.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если пакет неверен или result равен NULL,
+ * или `CALC_ERROR`, если не удалось выделить память.
+ */
+int s21_batch_transpose(s21_batch_t *A, s21_batch_t *result) {
+  if (is_correct_batch(A) != OK || result == NULL) return INCORRECT_MATRIX;
+
+  int res = s21_create_batch(A->columns, A->rows, A->count, result);
+  if (res == OK) res = s21_batch_transpose_into(A, result);
+  return res;
+}
+
+/**
+ * Функция pivot_lanes выбирает в каждой полосе ведущую строку столбца k среди
+ * строк k..n-1 и переставляет её со строкой k в столбцах k..width-1 (левее в
+ * этих строках уже стоят нули). Выбор и перестановка выполняются масками, так
+ * что полосы с разными ведущими строками обрабатываются одними векторными
+ * инструкциями.
+ *
+ * @param w Матрица из n строк по width элементов.
+ * @param swapped Маска полос, в которых строки переставлены.
+ */
+static inline void pivot_lanes(lanes_t *w, int n, int width, int k,
+                               mask_t *swapped) {
+  lanes_t best = LANES_ABS(w[k * width + k]);
+  lanes_t row = best * 0 + k;
+  for (int i = k + 1; i < n; i++) {
+    lanes_t value = LANES_ABS(w[i * width + k]);
+    mask_t greater = (mask_t)(value > best);
+    row = LANES_SELECT(greater, best * 0 + i, row);
+    best = LANES_SELECT(greater, value, best);
+  }
+  for (int i = k + 1; i < n; i++) {
+    mask_t chosen = (mask_t)(row == i);
+    for (int j = k; j < width; j++) {
+      lanes_t top = w[k * width + j];
+      w[k * width + j] = LANES_SELECT(chosen, w[i * width + j], top);
+      w[i * width + j] = LANES_SELECT(chosen, top, w[i * width + j]);
+    }
+  }
+  *swapped = (mask_t)(row != k);
+}
+
+/**
+ * Функция reciprocal_lanes записывает в inverse 1 / pivot для полос с
+ * ненулевым pivot и 0 для остальных, не выполняя деления на ноль.
+ */
+static inline void reciprocal_lanes(const lanes_t *pivot, lanes_t *inverse) {
+  mask_t zero = (mask_t)(*pivot == 0);
+  lanes_t one = *pivot * 0 + 1;
+  *inverse = LANES_SELECT(zero, *pivot * 0,
+                          one / LANES_SELECT(zero, one, *pivot));
+}
+
+BATCH_KERNEL static void determinant_lanes(int n, const double *data,
+                                           int stride, double *result) {
+  lanes_t w[BATCH_MAX_ORDER * BATCH_MAX_ORDER];
+  for (int e = 0; e < n * n; e++) LANES_LOAD(w[e], data + (size_t)e * stride);
+  lanes_t det = {0}, inverse;
+  mask_t swapped;
+  det += 1;
+
+  for (int k = 0; k < n; k++) {
+    pivot_lanes(w, n, n, k, &swapped);
+    lanes_t pivot = w[k * n + k];
+    det *= LANES_SELECT(swapped, -pivot, pivot);
+    reciprocal_lanes(&pivot, &inverse);
+    for (int i = k + 1; i < n; i++) {
+      lanes_t f = w[i * n + k] * inverse;
+      for (int j = k + 1; j < n; j++) w[i * n + j] -= f * w[k * n + j];
+    }
+  }
+  LANES_STORE(result, det);
+}
+
+/**
+ * Функция s21_batch_determinant вычисляет определители всех матриц пакета
+ * методом Гаусса с выбором ведущего элемента отдельно в каждой полосе.
+ *
+ * @param A Пакет квадратных матриц.
+ * @param result Массив из A->count элементов для определителей.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если пакет неверен или result равен NULL,
+ * или `CALC_ERROR`, если матрицы не квадратные.
+ */
+int s21_batch_determinant(s21_batch_t *A, double *result) {
+  if (is_correct_batch(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  if (A->rows != A->columns) return CALC_ERROR;
+
+  for (int b0 = 0; b0 < A->stride; b0 += BATCH_LANES) {
+    double det[BATCH_LANES];
+    determinant_lanes(A->rows, A->data + b0, A->stride, det);
+    int lanes = A->count - b0 < BATCH_LANES ? A->count - b0 : BATCH_LANES;
+    memcpy(result + b0, det, sizeof(double) * lanes);
+  }
+  return OK;
+}
+
+/**
+ * Функция inverse_lanes обращает BATCH_LANES матриц методом Гаусса-Жордана
+ * над расширенной матрицей [A | E] и записывает правую половину в out.
+ * Матрицы вырожденных полос заполняются NaN.
+ *
+ * @return Количество вырожденных матриц среди первых lanes полос.
+ */
+BATCH_KERNEL static int inverse_lanes(int n, const double *data, double *out,
+                                      int stride, int lanes) {
+  lanes_t w[BATCH_MAX_ORDER * 2 * BATCH_MAX_ORDER];
+  lanes_t zero = {0}, inverse;
+  mask_t singular = {0}, swapped;
+  int width = 2 * n;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      LANES_LOAD(w[i * width + j], data + (size_t)(i * n + j) * stride);
+      w[i * width + n + j] = zero + (i == j);
+    }
+  }
+
+  for (int k = 0; k < n; k++) {
+    pivot_lanes(w, n, width, k, &swapped);
+    lanes_t pivot = w[k * width + k];
+    singular |= (mask_t)(pivot == 0);
+    reciprocal_lanes(&pivot, &inverse);
+    for (int j = k; j < width; j++) w[k * width + j] *= inverse;
+    for (int i = 0; i < n; i++) {
+      lanes_t f = w[i * width + k];
+      for (int j = k; j < width && i != k; j++) {
+        w[i * width + j] -= f * w[k * width + j];
+      }
+    }
+  }
+
+  lanes_t nan = zero + NAN;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      lanes_t value = LANES_SELECT(singular, nan, w[i * width + n + j]);
+      LANES_STORE(out + (size_t)(i * n + j) * stride, value);
+    }
+  }
+  int count = 0;
+  for (int l = 0; l < lanes; l++) count += singular[l] != 0;
+  return count;
+}
+
+/**
+ * Функция s21_batch_inverse_into обращает все матрицы пакета и записывает
+ * результат в уже созданный пакет result. result может совпадать с A. Если
+ * часть матриц вырождена, остальные всё равно обращаются, а на месте
+ * вырожденных записываются матрицы из NaN.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если один из пакетов неверен, или
+ * `CALC_ERROR`, если матрицы не квадратные, размеры result не подходят либо
+ * хотя бы одна матрица вырождена.
+ */
+int s21_batch_inverse_into(s21_batch_t *A, s21_batch_t *result) {
+  int res = is_correct_batch(A);
+  if (res == OK && A->rows != A->columns) res = CALC_ERROR;
+  if (res == OK) res = check_batch_output(result, A->rows, A->rows, A->count);
+
+  int bad = 0;
+  for (int b0 = 0; res == OK && b0 < A->stride; b0 += BATCH_LANES) {
+    int lanes = A->count - b0 < BATCH_LANES ? A->count - b0 : BATCH_LANES;
+    bad += inverse_lanes(A->rows, A->data + b0, result->data + b0, A->stride,
+                         lanes);
+  }
+  return res == OK && bad ? CALC_ERROR : res;
+}
+
+/**
+ * Функция s21_batch_inverse обращает все матрицы пакета так же, как
+ * s21_batch_inverse_into, создавая для результата новый пакет result.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если пакет неверен или result равен NULL,
+ * или `CALC_ERROR`, если матрицы не квадратные, хотя бы одна из них вырождена
+ * либо не удалось выделить память. Если причина в вырожденных матрицах, пакет
+ * result создан и его нужно освободить.
+ */
+int s21_batch_inverse(s21_batch_t *A, s21_batch_t *result) {
+  if (is_correct_batch(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  if (A->rows != A->columns) return CALC_ERROR;
+
+  int res = s21_create_batch(A->rows, A->columns, A->count, result);
+  if (res == OK) res = s21_batch_inverse_into(A, result);
+  return res;
+}
@@ -0,0 +1,110 @@
+#include "s21_internal.h"
+
+#define CHOLESKY_BLOCK 64
+
+/**
+ * Функция cholesky_panel вычисляет столбцы k0..k0 + nb - 1 множителя L в
+ * строках k0..n - 1: L[i][j] = (A[i][j] - сумма L[i][p] * L[j][p]) / L[j][j].
+ * Строки диагонального блока считаются до диагонали, а диагональный элемент —
+ * как корень из остатка; строки ниже используют уже готовый диагональный блок.
+ *
+ * @return `OK` или `CALC_ERROR`, если матрица не положительно определена.
+ */
+static int cholesky_panel(double *a, int n, int k0, int nb) {
+  int res = OK;
+  for (int i = k0; i < n && res == OK; i++) {
+    double *row_i = a + i * n;
+    int end = i < k0 + nb ? i : k0 + nb;
+    for (int j = k0; j < end; j++) {
+      const double *row_j = a + j * n;
+      double sum = row_i[j];
+      for (int p = k0; p < j; p++) sum -= row_i[p] * row_j[p];
+      row_i[j] = sum / row_j[j];
+    }
+    if (i < k0 + nb) {
+      double sum = row_i[i];
+      for (int p = k0; p < i; p++) sum -= row_i[p] * row_i[p];
+      if (!(sum > 0) || !isfinite(sum)) res = CALC_ERROR;
+      row_i[i] = sqrt(sum);
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция cholesky_decompose выполняет разложение Холецкого A = L * L^T
+ * симметричной положительно определённой матрицы на месте. Читается только
+ * нижний треугольник, туда же записывается L; элементы выше диагонали
+ * диагональных блоков портятся и должны игнорироваться.
+ *
+ * Матрица обрабатывается блоками по CHOLESKY_BLOCK столбцов: диагональный
+ * блок и панель под ним считаются построчно, а нижний треугольник остаточной
+ * матрицы обновляется по блочным столбцам через gemm_update.
+ *
+ * @param a Непрерывный буфер из n * n элементов, хранящий матрицу построчно.
+ * @param n Порядок матрицы.
+ *
+ * @return `OK` или `CALC_ERROR`, если матрица не положительно определена.
+ */
+int cholesky_decompose(double *a, int n) {
+  int res = OK;
+  for (int k0 = 0; k0 < n && res == OK; k0 += CHOLESKY_BLOCK) {
+    int nb = n - k0 < CHOLESKY_BLOCK ? n - k0 : CHOLESKY_BLOCK;
+    int rest = n - k0 - nb;
+    res = cholesky_panel(a, n, k0, nb);
+    if (res != OK || rest == 0) continue;
+
+    arena_t *arena = scratch_arena();
+    if (arena == NULL) return CALC_ERROR;
+    arena_mark_t mark = s21_arena_mark(arena);
+    double *panel_t = arena_alloc(arena, sizeof(double) * nb * rest);
+    if (panel_t == NULL) res = CALC_ERROR;
+    for (int i = 0; i < rest && res == OK; i++) {
+      for (int p = 0; p < nb; p++) {
+        panel_t[p * rest + i] = a[(k0 + nb + i) * n + k0 + p];
+      }
+    }
+    for (int j0 = 0; j0 < rest && res == OK; j0 += CHOLESKY_BLOCK) {
+      int width = rest - j0 < CHOLESKY_BLOCK ? rest - j0 : CHOLESKY_BLOCK;
+      double *block = a + (k0 + nb + j0) * n + k0 + nb + j0;
+      res = gemm_update(rest - j0, width, nb, block - nb - j0, n,
+                        panel_t + j0, rest, block, n);
+    }
+    s21_arena_release(arena, mark);
+  }
+  return res;
+}
+
+/**
+ * Функция cholesky_solve решает систему L * L^T * X = B по множителю L из
+ * cholesky_decompose. Правая часть задаётся строками и заменяется решением на
+ * месте; оба прохода идут по строкам L и X.
+ *
+ * @param l Буфер с результатом cholesky_decompose для матрицы порядка n.
+ * @param n Порядок матрицы.
+ * @param x Массив из n указателей на строки правой части длиной nrhs.
+ * @param nrhs Количество столбцов правой части.
+ */
+void cholesky_solve(const double *l, int n, double **x, int nrhs) {
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < i; k++) {
+      double value = l[i * n + k];
+      if (value != 0) {
+        for (int j = 0; j < nrhs; j++) x[i][j] -= value * x[k][j];
+      }
+    }
+    double d = 1 / l[i * n + i];
+    for (int j = 0; j < nrhs; j++) x[i][j] *= d;
+  }
+
+  for (int i = n - 1; i >= 0; i--) {
+    double d = 1 / l[i * n + i];
+    for (int j = 0; j < nrhs; j++) x[i][j] *= d;
+    for (int k = 0; k < i; k++) {
+      double value = l[i * n + k];
+      if (value != 0) {
+        for (int j = 0; j < nrhs; j++) x[k][j] -= value * x[i][j];
+      }
+    }
+  }
+}
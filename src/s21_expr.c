@@ -0,0 +1,236 @@
+#include <string.h>
+
+#include "s21_internal.h"
+
+/*
+ * Отложенное выражение хранится как программа в обратной польской записи:
+ * s21_expr_load кладёт матрицу на стек, операции снимают со стека операнды и
+ * кладут результат. При вычислении программа выполняется по фрагментам из
+ * EXPR_CHUNK элементов: промежуточные значения живут в буферах на стеке
+ * (EXPR_MAX_DEPTH x EXPR_CHUNK, 16 КБ — в пределах кэша первого уровня),
+ * поэтому каждая входная матрица читается один раз, результат записывается
+ * один раз, а промежуточные матрицы не создаются.
+ */
+
+static int push_node(s21_expr_t *expr, expr_op op, matrix_t *source,
+                     double number, int pops) {
+  if (expr->status != OK) return expr->status;
+
+  if (expr->count == EXPR_MAX_NODES || expr->depth < pops ||
+      expr->depth - pops + 1 > EXPR_MAX_DEPTH) {
+    expr->status = CALC_ERROR;
+  } else {
+    expr->nodes[expr->count++] = (expr_node){op, source, number};
+    expr->depth += 1 - pops;
+  }
+  return expr->status;
+}
+
+/**
+ * Функция s21_expr_init создаёт пустое выражение.
+ *
+ * @param expr Указатель на структуру выражения.
+ */
+void s21_expr_init(s21_expr_t *expr) { memset(expr, 0, sizeof(*expr)); }
+
+/**
+ * Функция s21_expr_load кладёт на стек выражения матрицу A. Матрица не
+ * копируется: выражение хранит указатель и читает её значения только при
+ * вычислении, поэтому одно выражение можно вычислять повторно после изменения
+ * входных матриц. Все матрицы выражения должны иметь одинаковый размер.
+ *
+ * Ошибка запоминается в выражении: последующие операции ничего не делают, а
+ * s21_expr_eval возвращает её код.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A неверна, или `CALC_ERROR`, если
+ * размер A не совпадает с размером уже добавленных матриц либо выражение
+ * переполнено (больше EXPR_MAX_NODES узлов или EXPR_MAX_DEPTH операндов на
+ * стеке).
+ */
+int s21_expr_load(s21_expr_t *expr, matrix_t *A) {
+  if (expr->status == OK && is_correct_matrix(A) != OK) {
+    expr->status = INCORRECT_MATRIX;
+  } else if (expr->status == OK && expr->count == 0) {
+    expr->rows = A->rows;
+    expr->columns = A->columns;
+  } else if (expr->status == OK &&
+             (A->rows != expr->rows || A->columns != expr->columns)) {
+    expr->status = CALC_ERROR;
+  }
+  return push_node(expr, EXPR_LOAD, A, 0, 0);
+}
+
+/**
+ * Функция s21_expr_add заменяет два верхних операнда стека X, Y на X + Y.
+ *
+ * @return `OK` или код ошибки выражения; `CALC_ERROR`, если на стеке меньше
+ * двух операндов.
+ */
+int s21_expr_add(s21_expr_t *expr) {
+  return push_node(expr, EXPR_ADD, NULL, 0, 2);
+}
+
+/**
+ * Функция s21_expr_sub заменяет два верхних операнда стека X, Y на X - Y.
+ *
+ * @return Коды ошибок такие же, как у s21_expr_add.
+ */
+int s21_expr_sub(s21_expr_t *expr) {
+  return push_node(expr, EXPR_SUB, NULL, 0, 2);
+}
+
+/**
+ * Функция s21_expr_hadamard заменяет два верхних операнда стека X, Y на их
+ * поэлементное произведение.
+ *
+ * @return Коды ошибок такие же, как у s21_expr_add.
+ */
+int s21_expr_hadamard(s21_expr_t *expr) {
+  return push_node(expr, EXPR_MUL, NULL, 0, 2);
+}
+
+/**
+ * Функция s21_expr_scale умножает верхний операнд стека на число.
+ *
+ * @return `OK` или код ошибки выражения; `CALC_ERROR`, если стек пуст.
+ */
+int s21_expr_scale(s21_expr_t *expr, double number) {
+  return push_node(expr, EXPR_SCALE, NULL, number, 1);
+}
+
+/**
+ * Функция eval_span вычисляет выражение для n подряд идущих элементов.
+ * base[i] указывает на первый элемент матрицы i-го узла EXPR_LOAD. Последняя
+ * операция пишет прямо в out, остальные — в буферы стека.
+ *
+ * @return 1, если в результате есть бесконечность или NaN, иначе 0.
+ */
+static int eval_span(const s21_expr_t *expr, const double *const *base,
+                     double *out, size_t n,
+                     double buffers[EXPR_MAX_DEPTH][EXPR_CHUNK]) {
+  int bad = 0;
+  for (size_t offset = 0; offset < n; offset += EXPR_CHUNK) {
+    size_t length = n - offset < EXPR_CHUNK ? n - offset : EXPR_CHUNK;
+    const double *stack[EXPR_MAX_DEPTH];
+    int depth = 0;
+
+    for (int i = 0; i < expr->count; i++) {
+      const expr_node *node = &expr->nodes[i];
+      int last = (i == expr->count - 1);
+      if (node->op == EXPR_LOAD) {
+        stack[depth++] = base[i] + offset;
+        if (last && stack[0] != out + offset) {
+          memmove(out + offset, stack[0], sizeof(double) * length);
+        }
+      } else if (node->op == EXPR_SCALE) {
+        double *target = last ? out + offset : buffers[depth - 1];
+        bad |= simd_scale(stack[depth - 1], node->number, target, length);
+        stack[depth - 1] = target;
+      } else {
+        double *target = last ? out + offset : buffers[depth - 2];
+        const double *x = stack[depth - 2];
+        const double *y = stack[depth - 1];
+        if (node->op == EXPR_ADD) {
+          bad |= simd_add(x, y, target, length);
+        } else if (node->op == EXPR_SUB) {
+          bad |= simd_sub(x, y, target, length);
+        } else {
+          bad |= simd_mul(x, y, target, length);
+        }
+        stack[--depth - 1] = target;
+      }
+    }
+  }
+  return bad;
+}
+
+/**
+ * Функция check_sources заново проверяет матрицы узлов EXPR_LOAD: между
+ * s21_expr_load и вычислением матрицу могли удалить или пересоздать с другим
+ * размером, а выражение хранит только указатель.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одна из матриц неверна, или
+ * `CALC_ERROR`, если её размер больше не совпадает с размером выражения.
+ */
+static int check_sources(const s21_expr_t *expr) {
+  int res = OK;
+  for (int i = 0; i < expr->count && res == OK; i++) {
+    matrix_t *source = expr->nodes[i].source;
+    if (expr->nodes[i].op != EXPR_LOAD) continue;
+    if (is_correct_matrix(source) != OK) {
+      res = INCORRECT_MATRIX;
+    } else if (source->rows != expr->rows ||
+               source->columns != expr->columns) {
+      res = CALC_ERROR;
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция s21_expr_eval_into вычисляет выражение за один проход и записывает
+ * результат в уже созданную матрицу result того же размера, что и матрицы
+ * выражения. result может совпадать с любой из них. Если все матрицы хранятся
+ * непрерывно, проход идёт по всему блоку сразу, иначе — по строкам.
+ *
+ * @return Функция s21_expr_eval_into возвращает:
+ * - `OK`, если выражение вычислено
+ * - `INCORRECT_MATRIX`, если result или одна из матриц выражения неверна
+ * (в том числе удалена после s21_expr_load)
+ * - `CALC_ERROR`, если выражение неполное (на стеке не ровно один операнд) или
+ * переполнено, размер result или одной из матриц выражения не совпадает, либо
+ * в результате появилась бесконечность или NaN
+ */
+int s21_expr_eval_into(s21_expr_t *expr, matrix_t *result) {
+  if (expr->status != OK) return expr->status;
+  if (expr->depth != 1) return CALC_ERROR;
+  int res = check_output(result, expr->rows, expr->columns);
+  if (res == OK) res = check_sources(expr);
+  if (res != OK) return res;
+
+  const double *data[EXPR_MAX_NODES];
+  double *out = matrix_data(result);
+  int contiguous = out != NULL;
+  for (int i = 0; i < expr->count; i++) {
+    data[i] = NULL;
+    if (expr->nodes[i].op == EXPR_LOAD) {
+      data[i] = matrix_data(expr->nodes[i].source);
+      contiguous &= data[i] != NULL;
+    }
+  }
+
+  _Alignas(MATRIX_ALIGN) double buffers[EXPR_MAX_DEPTH][EXPR_CHUNK];
+  int bad = 0;
+  if (contiguous) {
+    size_t n = (size_t)expr->rows * expr->columns;
+    bad = eval_span(expr, data, out, n, buffers);
+  } else {
+    const double *rows[EXPR_MAX_NODES];
+    for (int r = 0; r < expr->rows; r++) {
+      for (int i = 0; i < expr->count; i++) {
+        const expr_node *node = &expr->nodes[i];
+        rows[i] = node->op == EXPR_LOAD ? node->source->matrix[r] : NULL;
+      }
+      bad |= eval_span(expr, rows, result->matrix[r], expr->columns, buffers);
+    }
+  }
+  return bad ? CALC_ERROR : OK;
+}
+
+/**
+ * Функция s21_expr_eval вычисляет выражение так же, как s21_expr_eval_into,
+ * создавая для результата новую матрицу result. Если выражение содержит
+ * ошибку или одна из его матриц больше неверна, result не создаётся.
+ *
+ * @return Коды ошибок такие же, как у s21_expr_eval_into.
+ */
+int s21_expr_eval(s21_expr_t *expr, matrix_t *result) {
+  if (result == NULL) return INCORRECT_MATRIX;
+  if (expr->status != OK) return expr->status;
+  if (expr->depth != 1) return CALC_ERROR;
+
+  int res = check_sources(expr);
+  if (res == OK) res = s21_create_matrix(expr->rows, expr->columns, result);
+  if (res == OK) res = s21_expr_eval_into(expr, result);
+  return res;
+}
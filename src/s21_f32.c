@@ -0,0 +1,681 @@
+#include <float.h>
+#include <string.h>
+
+#include "s21_internal.h"
+
+#define F32_EQ_TOLERANCE 1e-6
+#define F32_MC 32
+#define F32_KC 256
+#define F32_NC 1024
+#define F32_LU_BLOCK 64
+#define F32_TRANSPOSE_TILE 32
+#define MIXED_MAX_ITERATIONS 30
+
+/*
+ * Матрицы float (matrix_f32_t) устроены так же, как matrix_t: элементы лежат
+ * одним блоком, выровненным на MATRIX_ALIGN, а массив указателей на строки —
+ * в начале того же блока. Вдвое меньший размер элемента вдвое уменьшает
+ * объём памяти и трафик и вдвое расширяет векторные регистры.
+ */
+
+/**
+ * Функция s21_create_matrix_f32 создаёт матрицу float rows x columns,
+ * заполненную нулями, по тем же правилам, что и s21_create_matrix.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если размеры меньше 1 или result равен
+ * NULL, или `CALC_ERROR`, если не хватило памяти.
+ */
+int s21_create_matrix_f32(int rows, int columns, matrix_f32_t *result) {
+  if (rows < 1 || columns < 1 || result == NULL) return INCORRECT_MATRIX;
+
+  size_t header = sizeof(float *) * rows;
+  header = (header + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN;
+  size_t data = sizeof(float) * rows * columns;
+  size_t total = header + data;
+  total = (total + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN;
+
+  float **matrix = aligned_alloc(MATRIX_ALIGN, total);
+  if (matrix == NULL) return CALC_ERROR;
+
+  float *block = (float *)((char *)matrix + header);
+  memset(block, 0, data);
+  for (int i = 0; i < rows; i++) matrix[i] = block + (size_t)i * columns;
+
+  result->matrix = matrix;
+  result->rows = rows;
+  result->columns = columns;
+  return OK;
+}
+
+/**
+ * Функция s21_remove_matrix_f32 освобождает матрицу, созданную
+ * s21_create_matrix_f32.
+ */
+void s21_remove_matrix_f32(matrix_f32_t *A) {
+  if (A != NULL && A->matrix != NULL) {
+    free(A->matrix);
+    A->matrix = NULL;
+  }
+}
+
+static int is_correct_f32(matrix_f32_t *M) {
+  return M == NULL || M->rows < 1 || M->columns < 1 || M->matrix == NULL
+             ? INCORRECT_MATRIX
+             : OK;
+}
+
+/**
+ * Функция f32_data — аналог matrix_data для матриц float: возвращает
+ * указатель на элементы, если строки лежат подряд, иначе NULL.
+ */
+static float *f32_data(matrix_f32_t *M) {
+  float *data = M->matrix[0];
+  for (int i = 1; i < M->rows && data != NULL; i++) {
+    if (M->matrix[i] != data + (size_t)i * M->columns) data = NULL;
+  }
+  return data;
+}
+
+/**
+ * Функция s21_eq_matrix_f32 сравнивает матрицы float. Элементы считаются
+ * равными, если отличаются не больше чем на F32_EQ_TOLERANCE, умноженное на
+ * больший из модулей (но не меньше 1): абсолютный допуск 1e-7 из
+ * s21_eq_matrix меньше шага float уже для чисел порядка единицы.
+ *
+ * @return `SUCCESS` или `FAILURE`.
+ */
+int s21_eq_matrix_f32(matrix_f32_t *A, matrix_f32_t *B) {
+  if (is_correct_f32(A) != OK || is_correct_f32(B) != OK) return FAILURE;
+  int res = A->rows == B->rows && A->columns == B->columns ? SUCCESS : FAILURE;
+  for (int i = 0; i < A->rows && res == SUCCESS; i++) {
+    for (int j = 0; j < A->columns && res == SUCCESS; j++) {
+      double a = A->matrix[i][j], b = B->matrix[i][j];
+      double scale = fmax(1, fmax(fabs(a), fabs(b)));
+      if (!(fabs(a - b) <= F32_EQ_TOLERANCE * scale)) res = FAILURE;
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция s21_matrix_to_f32 создаёт матрицу float с элементами A,
+ * округлёнными до ближайшего float.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A неверна или result равен NULL, или
+ * `CALC_ERROR`, если элемент не помещается во float (тогда result не
+ * создаётся) или не хватило памяти.
+ */
+int s21_matrix_to_f32(matrix_t *A, matrix_f32_t *result) {
+  if (is_correct_matrix(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  int res = s21_create_matrix_f32(A->rows, A->columns, result);
+  int bad = 0;
+  for (int i = 0; i < A->rows && res == OK; i++) {
+    const double *src = A->matrix[i];
+    float *dst = result->matrix[i];
+    for (int j = 0; j < A->columns; j++) {
+      dst[j] = (float)src[j];
+      bad |= !isfinite(dst[j]);
+    }
+  }
+  if (res == OK && bad) {
+    s21_remove_matrix_f32(result);
+    res = CALC_ERROR;
+  }
+  return res;
+}
+
+/**
+ * Функция s21_matrix_from_f32 создаёт матрицу double с элементами A.
+ * Преобразование точное.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A неверна или result равен NULL, или
+ * `CALC_ERROR`, если не хватило памяти.
+ */
+int s21_matrix_from_f32(matrix_f32_t *A, matrix_t *result) {
+  if (is_correct_f32(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  int res = s21_create_matrix(A->rows, A->columns, result);
+  for (int i = 0; i < A->rows && res == OK; i++) {
+    for (int j = 0; j < A->columns; j++) {
+      result->matrix[i][j] = A->matrix[i][j];
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция f32_binary применяет поэлементное ядро simd_add_f32 или
+ * simd_sub_f32 ко всему блоку, если матрицы хранятся непрерывно, иначе — по
+ * строкам.
+ */
+static int f32_binary(int (*kernel)(const float *, const float *, float *,
+                                    size_t),
+                      matrix_f32_t *A, matrix_f32_t *B, matrix_f32_t *result) {
+  int bad = 0;
+  float *a = f32_data(A), *b = f32_data(B), *r = f32_data(result);
+  if (a != NULL && b != NULL && r != NULL) {
+    bad = kernel(a, b, r, (size_t)A->rows * A->columns);
+  } else {
+    for (int i = 0; i < A->rows; i++) {
+      bad |= kernel(A->matrix[i], B->matrix[i], result->matrix[i], A->columns);
+    }
+  }
+  return bad ? CALC_ERROR : OK;
+}
+
+static int f32_elementwise(int (*kernel)(const float *, const float *,
+                                         float *, size_t),
+                           matrix_f32_t *A, matrix_f32_t *B,
+                           matrix_f32_t *result) {
+  if (is_correct_f32(A) != OK || is_correct_f32(B) != OK || result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  if (A->rows != B->rows || A->columns != B->columns) return CALC_ERROR;
+  int res = s21_create_matrix_f32(A->rows, A->columns, result);
+  if (res == OK) res = f32_binary(kernel, A, B, result);
+  return res;
+}
+
+/**
+ * Функции s21_sum_matrix_f32 и s21_sub_matrix_f32 складывают и вычитают
+ * матрицы float так же, как s21_sum_matrix и s21_sub_matrix. Отдельный режим
+ * с накоплением в double здесь не нужен: сумма двух float, посчитанная в
+ * double и округлённая до float, совпадает с суммой во float.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одна из матриц неверна, или
+ * `CALC_ERROR`, если размеры не совпадают либо в результате появилась
+ * бесконечность или NaN.
+ */
+int s21_sum_matrix_f32(matrix_f32_t *A, matrix_f32_t *B,
+                       matrix_f32_t *result) {
+  return f32_elementwise(simd_add_f32, A, B, result);
+}
+
+int s21_sub_matrix_f32(matrix_f32_t *A, matrix_f32_t *B,
+                       matrix_f32_t *result) {
+  return f32_elementwise(simd_sub_f32, A, B, result);
+}
+
+/**
+ * Функция s21_mult_number_f32 умножает матрицу float на число.
+ *
+ * @return Коды ошибок такие же, как у s21_mult_number.
+ */
+int s21_mult_number_f32(matrix_f32_t *A, float number, matrix_f32_t *result) {
+  if (is_correct_f32(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  int res = s21_create_matrix_f32(A->rows, A->columns, result);
+  int bad = 0;
+  float *a = f32_data(A);
+  if (res == OK && a != NULL) {
+    bad = simd_scale_f32(a, number, result->matrix[0],
+                         (size_t)A->rows * A->columns);
+  } else {
+    for (int i = 0; i < A->rows && res == OK; i++) {
+      bad |= simd_scale_f32(A->matrix[i], number, result->matrix[i],
+                            A->columns);
+    }
+  }
+  return res == OK && bad ? CALC_ERROR : res;
+}
+
+/**
+ * Функция s21_transpose_f32 создаёт транспонированную матрицу float,
+ * переставляя элементы блоками F32_TRANSPOSE_TILE x F32_TRANSPOSE_TILE.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A неверна или result равен NULL, или
+ * `CALC_ERROR`, если не хватило памяти.
+ */
+int s21_transpose_f32(matrix_f32_t *A, matrix_f32_t *result) {
+  if (is_correct_f32(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  int res = s21_create_matrix_f32(A->columns, A->rows, result);
+  for (int i0 = 0; i0 < A->rows && res == OK; i0 += F32_TRANSPOSE_TILE) {
+    int i1 = i0 + F32_TRANSPOSE_TILE < A->rows ? i0 + F32_TRANSPOSE_TILE
+                                               : A->rows;
+    for (int j0 = 0; j0 < A->columns; j0 += F32_TRANSPOSE_TILE) {
+      int j1 = j0 + F32_TRANSPOSE_TILE < A->columns ? j0 + F32_TRANSPOSE_TILE
+                                                    : A->columns;
+      for (int i = i0; i < i1; i++) {
+        for (int j = j0; j < j1; j++) result->matrix[j][i] = A->matrix[i][j];
+      }
+    }
+  }
+  return res;
+}
+
+typedef struct f32_gemm {
+  int m, n, k;
+  float *const *a;
+  float *const *b;
+  float **c;
+  int mixed;
+  int *status;
+} f32_gemm;
+
+/**
+ * Функция f32_gemm_rows прибавляет к строкам i0..i0 + rows - 1 матрицы C
+ * соответствующие строки A * B. C обходится блоками по F32_NC столбцов, k —
+ * блоками по F32_KC, так что строка блока C остаётся в кэше L1, а панель B —
+ * в L2; каждое обновление строки — векторный simd_axpy_f32. В смешанном
+ * режиме (mixed) блок накапливается в буфере double из арены потока
+ * (simd_axpy_mixed) и округляется до float один раз в конце.
+ *
+ * @return `OK` или `CALC_ERROR`, если в результате есть бесконечность или NaN
+ * либо не удалось выделить буфер.
+ */
+static int f32_gemm_rows(const f32_gemm *g, int i0, int rows) {
+  arena_t *arena = g->mixed ? scratch_arena() : NULL;
+  arena_mark_t mark = {0};
+  double *acc = NULL;
+  if (g->mixed) {
+    if (arena == NULL) return CALC_ERROR;
+    mark = s21_arena_mark(arena);
+    acc = arena_alloc(arena, sizeof(double) * F32_MC * F32_NC);
+    if (acc == NULL) return CALC_ERROR;
+  }
+
+  int bad = 0;
+  for (int jc = 0; jc < g->n; jc += F32_NC) {
+    int nc = g->n - jc < F32_NC ? g->n - jc : F32_NC;
+    if (acc != NULL) memset(acc, 0, sizeof(double) * rows * nc);
+    for (int pc = 0; pc < g->k; pc += F32_KC) {
+      int kc = g->k - pc < F32_KC ? g->k - pc : F32_KC;
+      for (int i = 0; i < rows; i++) {
+        const float *a_row = g->a[i0 + i] + pc;
+        float *c_row = g->c[i0 + i] + jc;
+        for (int p = 0; p < kc; p++) {
+          if (acc != NULL) {
+            simd_axpy_mixed(a_row[p], g->b[pc + p] + jc, acc + i * nc, nc);
+          } else {
+            simd_axpy_f32(a_row[p], g->b[pc + p] + jc, c_row, nc);
+          }
+        }
+      }
+    }
+    for (int i = 0; i < rows; i++) {
+      float *c_row = g->c[i0 + i] + jc;
+      for (int j = 0; j < nc; j++) {
+        if (acc != NULL) c_row[j] += (float)acc[i * nc + j];
+        bad |= !isfinite(c_row[j]);
+      }
+    }
+  }
+
+  if (arena != NULL) s21_arena_release(arena, mark);
+  return bad ? CALC_ERROR : OK;
+}
+
+static void f32_gemm_task(void *arg, int index) {
+  f32_gemm *g = arg;
+  int i0 = index * F32_MC;
+  int rows = g->m - i0 < F32_MC ? g->m - i0 : F32_MC;
+  g->status[index] = f32_gemm_rows(g, i0, rows);
+}
+
+/**
+ * Функция f32_gemm_kernel — аналог gemm_kernel для float: прибавляет к C
+ * произведение A * B, накапливая его во float или, если mixed не равен нулю,
+ * в double. Блоки по F32_MC строк распределяются по пулу потоков, если объём
+ * работы достаточен (pool_threads); каждая строка C считается одной задачей,
+ * поэтому результат не зависит от числа потоков.
+ *
+ * @return `OK` или `CALC_ERROR`, если в результате есть бесконечность или NaN
+ * либо не удалось выделить буферы.
+ */
+static int f32_gemm_kernel(int m, int n, int k, float *const *a,
+                           float *const *b, float **c, int mixed) {
+  f32_gemm g = {m, n, k, a, b, c, mixed, NULL};
+  int blocks = (m + F32_MC - 1) / F32_MC;
+  if (blocks < 2 || pool_threads((double)m * n * k) < 2) {
+    int res = OK;
+    for (int i0 = 0; i0 < m && res == OK; i0 += F32_MC) {
+      res = f32_gemm_rows(&g, i0, m - i0 < F32_MC ? m - i0 : F32_MC);
+    }
+    return res;
+  }
+
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  g.status = arena_alloc(arena, sizeof(int) * blocks);
+  if (g.status == NULL) return CALC_ERROR;
+  pool_run(f32_gemm_task, &g, blocks);
+  int res = OK;
+  for (int i = 0; i < blocks; i++) {
+    if (g.status[i] != OK) res = CALC_ERROR;
+  }
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+static int f32_mult(matrix_f32_t *A, matrix_f32_t *B, matrix_f32_t *result,
+                    int mixed) {
+  if (is_correct_f32(A) != OK || is_correct_f32(B) != OK || result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  if (A->columns != B->rows) return CALC_ERROR;
+  int res = s21_create_matrix_f32(A->rows, B->columns, result);
+  if (res == OK) {
+    res = f32_gemm_kernel(A->rows, B->columns, A->columns, A->matrix,
+                          B->matrix, result->matrix, mixed);
+  }
+  return res;
+}
+
+/**
+ * Функция s21_mult_matrix_f32 перемножает матрицы float, накапливая суммы во
+ * float.
+ *
+ * @return Коды ошибок такие же, как у s21_mult_matrix.
+ */
+int s21_mult_matrix_f32(matrix_f32_t *A, matrix_f32_t *B,
+                        matrix_f32_t *result) {
+  return f32_mult(A, B, result, 0);
+}
+
+/**
+ * Функция s21_mult_matrix_f32_mixed перемножает матрицы float, накапливая
+ * суммы в double и округляя до float только готовые элементы. Матрицы
+ * по-прежнему хранятся во float, а ошибка результата не растёт с длиной
+ * скалярных произведений.
+ *
+ * @return Коды ошибок такие же, как у s21_mult_matrix.
+ */
+int s21_mult_matrix_f32_mixed(matrix_f32_t *A, matrix_f32_t *B,
+                              matrix_f32_t *result) {
+  return f32_mult(A, B, result, 1);
+}
+
+/**
+ * Функция f32_widen копирует матрицу float в матрицу double из арены потока.
+ */
+static int f32_widen(matrix_f32_t *A, arena_t *arena, matrix_t *view) {
+  int res = s21_arena_matrix(arena, A->rows, A->columns, view);
+  for (int i = 0; i < A->rows && res == OK; i++) {
+    for (int j = 0; j < A->columns; j++) view->matrix[i][j] = A->matrix[i][j];
+  }
+  return res;
+}
+
+/**
+ * Функция f32_through_double выполняет для матрицы float операцию op над
+ * double (s21_calc_complements или s21_inverse_matrix) и округляет результат
+ * до float. Разложения во float теряют слишком много точности на плохо
+ * обусловленных матрицах, а копирование стоит O(n^2) против O(n^3) самой
+ * операции.
+ */
+static int f32_through_double(int (*op)(matrix_t *, matrix_t *),
+                              matrix_f32_t *A, matrix_f32_t *result) {
+  if (is_correct_f32(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  matrix_t view, wide = {0};
+  int res = f32_widen(A, arena, &view);
+  if (res == OK) res = op(&view, &wide);
+  if (res == OK) res = s21_matrix_to_f32(&wide, result);
+  s21_remove_matrix(&wide);
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+/**
+ * Функция s21_determinant_f32 вычисляет определитель матрицы float в double
+ * (см. f32_through_double), поэтому он не переполняется раньше, чем
+ * определитель той же матрицы в double.
+ *
+ * @return Коды ошибок такие же, как у s21_determinant.
+ */
+int s21_determinant_f32(matrix_f32_t *A, double *result) {
+  if (is_correct_f32(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  matrix_t view;
+  int res = f32_widen(A, arena, &view);
+  if (res == OK) res = s21_determinant(&view, result);
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+/**
+ * Функции s21_calc_complements_f32 и s21_inverse_matrix_f32 вычисляют
+ * матрицу алгебраических дополнений и обратную матрицу для матрицы float
+ * через double (см. f32_through_double).
+ *
+ * @return Коды ошибок такие же, как у s21_calc_complements и
+ * s21_inverse_matrix; `CALC_ERROR` также, если результат не помещается во
+ * float.
+ */
+int s21_calc_complements_f32(matrix_f32_t *A, matrix_f32_t *result) {
+  return f32_through_double(s21_calc_complements, A, result);
+}
+
+int s21_inverse_matrix_f32(matrix_f32_t *A, matrix_f32_t *result) {
+  return f32_through_double(s21_inverse_matrix, A, result);
+}
+
+/**
+ * Функция lu_panel_f32 — вариант lu_panel для буфера float.
+ *
+ * @return `OK` или `CALC_ERROR`, если ведущий элемент столбца равен нулю.
+ */
+static int lu_panel_f32(float *a, int n, int k0, int nb, int *pivots) {
+  int res = OK;
+  for (int k = k0; k < k0 + nb && res == OK; k++) {
+    int p = k;
+    float max = fabsf(a[k * n + k]);
+    for (int i = k + 1; i < n; i++) {
+      if (fabsf(a[i * n + k]) > max) {
+        max = fabsf(a[i * n + k]);
+        p = i;
+      }
+    }
+    pivots[k] = p;
+    if (max == 0) {
+      res = CALC_ERROR;
+      continue;
+    }
+    float *row_k = a + k * n;
+    if (p != k) {
+      float *row_p = a + p * n;
+      for (int j = 0; j < n; j++) {
+        float tmp = row_k[j];
+        row_k[j] = row_p[j];
+        row_p[j] = tmp;
+      }
+    }
+    for (int i = k + 1; i < n; i++) {
+      float *row_i = a + i * n;
+      float l = row_i[k] / row_k[k];
+      row_i[k] = l;
+      simd_axpy_f32(-l, row_k + k + 1, row_i + k + 1, k0 + nb - k - 1);
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция lu_decompose_f32 — блочное LU-разложение буфера float n x n на
+ * месте, устроенное так же, как lu_decompose: панель по F32_LU_BLOCK
+ * столбцов, прямая подстановка для строк U справа от неё и обновление
+ * остаточной матрицы через f32_gemm_kernel.
+ *
+ * @return `OK` или `CALC_ERROR`, если матрица вырождена во float, в
+ * разложении появилась бесконечность или не удалось выделить буфер.
+ */
+static int lu_decompose_f32(float *a, int n, int *pivots) {
+  int res = OK;
+  for (int k0 = 0; k0 < n && res == OK; k0 += F32_LU_BLOCK) {
+    int nb = n - k0 < F32_LU_BLOCK ? n - k0 : F32_LU_BLOCK;
+    int rest = n - k0 - nb;
+    res = lu_panel_f32(a, n, k0, nb, pivots);
+    if (res != OK || rest == 0) continue;
+
+    for (int k = k0; k < k0 + nb; k++) {
+      for (int i = k + 1; i < k0 + nb; i++) {
+        simd_axpy_f32(-a[i * n + k], a + k * n + k0 + nb, a + i * n + k0 + nb,
+                      rest);
+      }
+    }
+
+    arena_t *arena = scratch_arena();
+    arena_mark_t mark = s21_arena_mark(arena);
+    float *negated =
+        arena ? arena_alloc(arena, sizeof(float) * rest * nb) : NULL;
+    float **rows =
+        arena ? arena_alloc(arena, sizeof(float *) * (2 * rest + nb)) : NULL;
+    res = negated != NULL && rows != NULL ? OK : CALC_ERROR;
+    if (res == OK) {
+      float **l_rows = rows, **c_rows = rows + rest;
+      float **u_rows = rows + 2 * rest;
+      for (int i = 0; i < rest; i++) {
+        const float *src = a + (k0 + nb + i) * n + k0;
+        l_rows[i] = negated + (size_t)i * nb;
+        for (int p = 0; p < nb; p++) l_rows[i][p] = -src[p];
+        c_rows[i] = a + (k0 + nb + i) * n + k0 + nb;
+      }
+      for (int p = 0; p < nb; p++) u_rows[p] = a + (k0 + p) * n + k0 + nb;
+      res = f32_gemm_kernel(rest, rest, nb, l_rows, u_rows, c_rows, 0);
+    }
+    s21_arena_release(arena, mark);
+  }
+  return res;
+}
+
+/**
+ * Функция lu_solve_f32 — вариант lu_solve с множителями во float и правой
+ * частью в double: множители расширяются до double по ходу подстановки.
+ */
+static void lu_solve_f32(const float *lu, int n, const int *pivots,
+                         double **x, int nrhs) {
+  for (int k = 0; k < n; k++) {
+    for (int j = 0; j < nrhs && pivots[k] != k; j++) {
+      double tmp = x[k][j];
+      x[k][j] = x[pivots[k]][j];
+      x[pivots[k]][j] = tmp;
+    }
+  }
+  for (int i = 1; i < n; i++) {
+    for (int k = 0; k < i; k++) {
+      double l = lu[i * n + k];
+      if (l != 0) {
+        for (int j = 0; j < nrhs; j++) x[i][j] -= l * x[k][j];
+      }
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    for (int k = i + 1; k < n; k++) {
+      double u = lu[i * n + k];
+      if (u != 0) {
+        for (int j = 0; j < nrhs; j++) x[i][j] -= u * x[k][j];
+      }
+    }
+    double d = 1.0 / lu[i * n + i];
+    for (int j = 0; j < nrhs; j++) x[i][j] *= d;
+  }
+}
+
+static double max_abs(double *const *rows, int m, int n) {
+  double max = 0;
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) max = fmax(max, fabs(rows[i][j]));
+  }
+  return max;
+}
+
+/**
+ * Функция mixed_refine решает систему по LU-разложению во float и уточняет
+ * решение в double: на каждом шаге невязка R = B - A * X считается в double,
+ * поправка находится по тем же множителям float и прибавляется к X. Решение
+ * принято, когда max|R| <= max|X| * ||A|| * DBL_EPSILON * sqrt(n).
+ *
+ * @param r Массив из n указателей на строки невязки.
+ * @param residual Буфер n * nrhs для невязки.
+ *
+ * @return `OK` или `CALC_ERROR`, если уточнение не сошлось за
+ * MIXED_MAX_ITERATIONS шагов.
+ */
+static int mixed_refine(matrix_t *A, matrix_t *B, matrix_t *X,
+                        const float *lu, const int *pivots, double **r,
+                        double *residual) {
+  int n = A->rows, nrhs = B->columns;
+  double norm = 0;
+  for (int i = 0; i < n; i++) {
+    double sum = 0;
+    for (int j = 0; j < n; j++) sum += fabs(A->matrix[i][j]);
+    norm = fmax(norm, sum);
+  }
+  double limit = norm * DBL_EPSILON * sqrt(n);
+
+  for (int i = 0; i < n; i++) {
+    memcpy(X->matrix[i], B->matrix[i], sizeof(double) * nrhs);
+    r[i] = residual + (size_t)i * nrhs;
+  }
+  lu_solve_f32(lu, n, pivots, X->matrix, nrhs);
+
+  int res = CALC_ERROR;
+  for (int step = 0; step <= MIXED_MAX_ITERATIONS && res != OK; step++) {
+    memset(residual, 0, sizeof(double) * n * nrhs);
+    int bad = gemm_kernel(n, nrhs, n, A->matrix, X->matrix, r);
+    for (int i = 0; i < n; i++) {
+      bad |= simd_sub(B->matrix[i], r[i], r[i], nrhs);
+    }
+    if (bad) break;
+    if (max_abs(r, n, nrhs) <= max_abs(X->matrix, n, nrhs) * limit) {
+      res = OK;
+    } else if (step < MIXED_MAX_ITERATIONS) {
+      lu_solve_f32(lu, n, pivots, r, nrhs);
+      for (int i = 0; i < n; i++) {
+        simd_add(X->matrix[i], r[i], X->matrix[i], nrhs);
+      }
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция s21_solve_mixed решает систему A * X = B так же, как s21_solve, но
+ * LU-разложение строится во float: оно требует вдвое меньше памяти и
+ * пропускной способности, чем разложение в double. Точность double
+ * восстанавливается итерационным уточнением (mixed_refine). Если A не
+ * помещается во float, вырождена во float или уточнение не сходится
+ * (обусловленность порядка 1 / FLT_EPSILON и хуже), система решается
+ * s21_solve.
+ *
+ * @return Коды ошибок такие же, как у s21_solve.
+ */
+int s21_solve_mixed(matrix_t *A, matrix_t *B, matrix_t *X) {
+  if (is_correct_matrix(A) != OK || is_correct_matrix(B) != OK || X == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  if (A->rows != A->columns || B->rows != A->rows) return CALC_ERROR;
+
+  int n = A->rows, nrhs = B->columns;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  float *lu = arena_alloc(arena, sizeof(float) * n * n);
+  double *residual = arena_alloc(arena, sizeof(double) * n * nrhs);
+  double **rows = arena_alloc(arena, sizeof(double *) * n);
+  int *pivots = arena_alloc(arena, sizeof(int) * n);
+  int res = lu && residual && rows && pivots ? OK : CALC_ERROR;
+
+  int bad = 0;
+  for (int i = 0; i < n && res == OK; i++) {
+    for (int j = 0; j < n; j++) {
+      lu[i * n + j] = (float)A->matrix[i][j];
+      bad |= !isfinite(lu[i * n + j]);
+    }
+  }
+  if (res == OK && !bad && lu_decompose_f32(lu, n, pivots) == OK) {
+    res = s21_create_matrix(n, nrhs, X);
+    if (res == OK && mixed_refine(A, B, X, lu, pivots, rows, residual) != OK) {
+      s21_remove_matrix(X);
+      res = s21_solve(A, B, X);
+    }
+  } else if (res == OK) {
+    res = s21_solve(A, B, X);
+  }
+
+  s21_arena_release(arena, mark);
+  return res;
+}
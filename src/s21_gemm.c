@@ -0,0 +1,298 @@
+#include "s21_internal.h"
+
+#define GEMM_MR 4
+#define GEMM_NR 4
+#define GEMM_MC 128
+#define GEMM_KC 256
+#define GEMM_NC 2048
+#define GEMM_SMALL 32768
+
+/**
+ * Функция pack_b копирует блок kc x nc матрицы B в буфер панелями по GEMM_NR
+ * столбцов, чтобы микроядро читало B последовательно. Недостающие столбцы
+ * последней панели заполняются нулями.
+ */
+static void pack_b(int kc, int nc, double *const *b, int pc, int jc,
+                   double *packed) {
+  for (int jr = 0; jr < nc; jr += GEMM_NR) {
+    int nr = nc - jr < GEMM_NR ? nc - jr : GEMM_NR;
+    for (int p = 0; p < kc; p++) {
+      const double *src = b[pc + p] + jc + jr;
+      for (int j = 0; j < nr; j++) packed[j] = src[j];
+      for (int j = nr; j < GEMM_NR; j++) packed[j] = 0;
+      packed += GEMM_NR;
+    }
+  }
+}
+
+/**
+ * Функция pack_a копирует блок mc x kc матрицы A в буфер панелями по GEMM_MR
+ * строк с чередованием по k. Недостающие строки последней панели заполняются
+ * нулями.
+ */
+static void pack_a(int mc, int kc, double *const *a, int ic, int pc,
+                   double *packed) {
+  for (int ir = 0; ir < mc; ir += GEMM_MR) {
+    int mr = mc - ir < GEMM_MR ? mc - ir : GEMM_MR;
+    for (int p = 0; p < kc; p++) {
+      for (int i = 0; i < mr; i++) packed[i] = a[ic + ir + i][pc + p];
+      for (int i = mr; i < GEMM_MR; i++) packed[i] = 0;
+      packed += GEMM_MR;
+    }
+  }
+}
+
+/**
+ * Функция micro_kernel вычисляет произведение упакованных панелей A и B
+ * размером GEMM_MR x GEMM_NR, накапливая результат в регистровом блоке acc.
+ */
+static void micro_kernel(int kc, const double *a, const double *b,
+                         double acc[GEMM_MR][GEMM_NR]) {
+  for (int i = 0; i < GEMM_MR; i++) {
+    for (int j = 0; j < GEMM_NR; j++) acc[i][j] = 0;
+  }
+  for (int p = 0; p < kc; p++) {
+    for (int i = 0; i < GEMM_MR; i++) {
+      double a_ip = a[i];
+      for (int j = 0; j < GEMM_NR; j++) acc[i][j] += a_ip * b[j];
+    }
+    a += GEMM_MR;
+    b += GEMM_NR;
+  }
+}
+
+/**
+ * Функция store_tile прибавляет блок acc к элементам C и, если check не равен
+ * нулю, проверяет получившиеся значения на переполнение и NaN.
+ *
+ * @return 1, если в блоке встретилось бесконечное значение или NaN, иначе 0.
+ */
+static int store_tile(double acc[GEMM_MR][GEMM_NR], double **c, int i0, int j0,
+                      int mr, int nr, int check) {
+  int bad = 0;
+  for (int i = 0; i < mr; i++) {
+    double *row = c[i0 + i] + j0;
+    for (int j = 0; j < nr; j++) row[j] += acc[i][j];
+    if (check) {
+      for (int j = 0; j < nr; j++) bad |= !isfinite(row[j]);
+    }
+  }
+  return bad;
+}
+
+static int gemm_small(int m, int n, int k, double *const *a, double *const *b,
+                      double **c) {
+  int bad = 0;
+  for (int i = 0; i < m; i++) {
+    double *row = c[i];
+    for (int p = 0; p < k; p++) {
+      double a_ip = a[i][p];
+      const double *b_p = b[p];
+      for (int j = 0; j < n; j++) row[j] += a_ip * b_p[j];
+    }
+    for (int j = 0; j < n; j++) bad |= !isfinite(row[j]);
+  }
+  return bad ? CALC_ERROR : OK;
+}
+
+static int gemm_blocked(int m, int n, int k, double *const *a,
+                        double *const *b, double **c) {
+  int kc_max = k < GEMM_KC ? k : GEMM_KC;
+  int nc_max = n < GEMM_NC ? n : GEMM_NC;
+  int mc_max = m < GEMM_MC ? m : GEMM_MC;
+  int nc_pad = (nc_max + GEMM_NR - 1) / GEMM_NR * GEMM_NR;
+  int mc_pad = (mc_max + GEMM_MR - 1) / GEMM_MR * GEMM_MR;
+
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  double *b_pack = arena_alloc(arena, sizeof(double) * kc_max * nc_pad);
+  double *a_pack = arena_alloc(arena, sizeof(double) * kc_max * mc_pad);
+  int bad = (a_pack == NULL || b_pack == NULL);
+
+  for (int jc = 0; jc < n && !bad; jc += GEMM_NC) {
+    int nc = n - jc < GEMM_NC ? n - jc : GEMM_NC;
+    for (int pc = 0; pc < k; pc += GEMM_KC) {
+      int kc = k - pc < GEMM_KC ? k - pc : GEMM_KC;
+      int last = (pc + kc == k);
+      pack_b(kc, nc, b, pc, jc, b_pack);
+      for (int ic = 0; ic < m; ic += GEMM_MC) {
+        int mc = m - ic < GEMM_MC ? m - ic : GEMM_MC;
+        pack_a(mc, kc, a, ic, pc, a_pack);
+        for (int jr = 0; jr < nc; jr += GEMM_NR) {
+          int nr = nc - jr < GEMM_NR ? nc - jr : GEMM_NR;
+          for (int ir = 0; ir < mc; ir += GEMM_MR) {
+            int mr = mc - ir < GEMM_MR ? mc - ir : GEMM_MR;
+            double acc[GEMM_MR][GEMM_NR];
+            micro_kernel(kc, a_pack + (size_t)ir * kc, b_pack + (size_t)jr * kc,
+                         acc);
+            bad |= store_tile(acc, c, ic + ir, jc + jr, mr, nr, last);
+          }
+        }
+      }
+    }
+  }
+
+  s21_arena_release(arena, mark);
+  return bad ? CALC_ERROR : OK;
+}
+
+typedef struct gemm_task {
+  int m, n, k;
+  double *const *a;
+  double ***b_cols;
+  double ***c_cols;
+  int row_step, row_blocks;
+  int col_step;
+  int *status;
+} gemm_task;
+
+static void gemm_task_run(void *arg, int index) {
+  gemm_task *t = arg;
+  int rb = index % t->row_blocks;
+  int cb = index / t->row_blocks;
+  int i0 = rb * t->row_step;
+  int j0 = cb * t->col_step;
+  int mi = t->m - i0 < t->row_step ? t->m - i0 : t->row_step;
+  int nj = t->n - j0 < t->col_step ? t->n - j0 : t->col_step;
+  t->status[index] =
+      gemm_blocked(mi, nj, t->k, t->a + i0, t->b_cols[cb], t->c_cols[cb] + i0);
+}
+
+static int round_up(int value, int step) {
+  return (value + step - 1) / step * step;
+}
+
+/**
+ * Функция gemm_parallel делит C на блоки строк (и, если строк мало, столбцов)
+ * и считает их на пуле потоков через gemm_blocked. Каждый элемент C
+ * вычисляется одной задачей в том же порядке суммирования, что и в
+ * однопоточном режиме, поэтому результат побитово совпадает при любом
+ * количестве потоков.
+ */
+static int gemm_parallel(int m, int n, int k, double *const *a,
+                         double *const *b, double **c, int threads) {
+  int row_blocks = (m + GEMM_MR - 1) / GEMM_MR;
+  if (row_blocks > threads * 2) row_blocks = threads * 2;
+  int row_step = round_up((m + row_blocks - 1) / row_blocks, GEMM_MR);
+  row_blocks = (m + row_step - 1) / row_step;
+
+  int col_blocks = 1;
+  if (row_blocks < threads) {
+    col_blocks = (threads + row_blocks - 1) / row_blocks;
+    if (col_blocks > (n + GEMM_NR - 1) / GEMM_NR) {
+      col_blocks = (n + GEMM_NR - 1) / GEMM_NR;
+    }
+  }
+  int col_step = round_up((n + col_blocks - 1) / col_blocks, GEMM_NR);
+  col_blocks = (n + col_step - 1) / col_step;
+
+  int tasks = row_blocks * col_blocks;
+  size_t pointers = (size_t)(k + m) * col_blocks;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return gemm_blocked(m, n, k, a, b, c);
+  arena_mark_t mark = s21_arena_mark(arena);
+  void *memory = arena_alloc(arena, sizeof(double **) * 2 * col_blocks +
+                                        sizeof(double *) * pointers +
+                                        sizeof(int) * tasks);
+  if (memory == NULL) return gemm_blocked(m, n, k, a, b, c);
+
+  gemm_task t = {m, n, k, a, memory, (double ***)memory + col_blocks,
+                 row_step, row_blocks, col_step, NULL};
+  double **shifted = (double **)((double ***)memory + 2 * col_blocks);
+  t.status = (int *)(shifted + pointers);
+  for (int cb = 0; cb < col_blocks; cb++) {
+    int j0 = cb * col_step;
+    t.b_cols[cb] = shifted;
+    for (int p = 0; p < k; p++) *shifted++ = b[p] + j0;
+    t.c_cols[cb] = shifted;
+    for (int i = 0; i < m; i++) *shifted++ = c[i] + j0;
+  }
+
+  pool_run(gemm_task_run, &t, tasks);
+
+  int res = OK;
+  for (int i = 0; i < tasks; i++) {
+    if (t.status[i] != OK) res = CALC_ERROR;
+  }
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+/**
+ * Функция gemm_kernel прибавляет к матрице C произведение A * B. Квадратные
+ * матрицы порядка до SMALL_MAX_ORDER умножаются развёрнутым ядром small_mult.
+ * Маленькие произведения (не больше GEMM_SMALL умножений) считаются простым
+ * построчным циклом, остальные — блочным умножением: панели B размером
+ * GEMM_KC x GEMM_NC и блоки A размером GEMM_MC x GEMM_KC упаковываются в
+ * непрерывные буферы, а развёрнутое микроядро считает блоки GEMM_MR x GEMM_NR
+ * в регистрах. Буферы упаковки берутся из арены потока. Проверка на
+ * переполнение и NaN выполняется один раз для каждого готового блока C.
+ *
+ * Если параллельный режим включён (s21_set_num_threads) и объём работы не
+ * меньше порога s21_set_parallel_threshold, блоки C распределяются по пулу
+ * потоков; результат при этом побитово совпадает с однопоточным.
+ *
+ * @param m Количество строк A и C.
+ * @param n Количество столбцов B и C.
+ * @param k Количество столбцов A и строк B.
+ * @param a Указатели на строки A.
+ * @param b Указатели на строки B.
+ * @param c Указатели на строки C.
+ *
+ * @return Функция gemm_kernel возвращает:
+ * - `OK`, если все элементы результата конечны
+ * - `CALC_ERROR`, если в результате есть бесконечность или NaN, либо не
+ * удалось выделить буферы упаковки
+ */
+int gemm_kernel(int m, int n, int k, double *const *a, double *const *b,
+                double **c) {
+  if (m == n && n == k && n >= 2 && n <= SMALL_MAX_ORDER) {
+    return small_mult(n, a, b, c);
+  }
+  double flops = (double)m * n * k;
+  if (flops <= GEMM_SMALL) return gemm_small(m, n, k, a, b, c);
+
+  int threads = pool_threads(flops);
+  if (threads > 1) return gemm_parallel(m, n, k, a, b, c, threads);
+  return gemm_blocked(m, n, k, a, b, c);
+}
+
+/**
+ * Функция gemm_update вычитает из C произведение A * B для матриц, хранящихся
+ * построчно в непрерывных буферах с шагом строк lda, ldb и ldc. Используется
+ * разложениями для обновления остаточной матрицы: A копируется с обратным
+ * знаком в буфер арены потока, и дальше работает gemm_kernel.
+ *
+ * @param m Количество строк A и C.
+ * @param n Количество столбцов B и C.
+ * @param k Количество столбцов A и строк B.
+ *
+ * @return `OK` или `CALC_ERROR`, если не удалось выделить буферы или в
+ * результате есть бесконечность или NaN.
+ */
+int gemm_update(int m, int n, int k, const double *a, int lda,
+                const double *b, int ldb, double *c, int ldc) {
+  if (m < 1 || n < 1 || k < 1) return OK;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  double *negated = arena_alloc(arena, sizeof(double) * m * k);
+  double **rows = arena_alloc(arena, sizeof(double *) * (2 * m + k));
+  if (negated == NULL || rows == NULL) {
+    s21_arena_release(arena, mark);
+    return CALC_ERROR;
+  }
+
+  double **a_rows = rows, **c_rows = rows + m, **b_rows = rows + 2 * m;
+  for (int i = 0; i < m; i++) {
+    a_rows[i] = negated + (size_t)i * k;
+    c_rows[i] = c + (size_t)i * ldc;
+    for (int p = 0; p < k; p++) a_rows[i][p] = -a[(size_t)i * lda + p];
+  }
+  for (int p = 0; p < k; p++) b_rows[p] = (double *)b + (size_t)p * ldb;
+
+  int res = gemm_kernel(m, n, k, a_rows, b_rows, c_rows);
+  s21_arena_release(arena, mark);
+  return res;
+}
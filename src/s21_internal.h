@@ -0,0 +1,86 @@
+#ifndef SRC_S21_INTERNAL_H_
+#define SRC_S21_INTERNAL_H_
+#include "s21_matrix.h"
+
+// Внутренние ядра и служебные функции библиотеки; в s21_matrix.h не входят.
+
+#define SMALL_MAX_ORDER 4
+#define MATRIX_ALIGN 64
+#define ARENA_BLOCK_SIZE (1 << 20)
+#define EXPR_CHUNK 256
+#define BATCH_LANES 8
+
+#ifdef S21_INSTRUMENT
+typedef struct probe_struct {
+  s21_probe id;
+  unsigned long long start;
+  unsigned long long bytes;
+  double flops;
+} probe_t;
+
+probe_t probe_begin(s21_probe id);
+void probe_finish(probe_t *probe);
+
+#define PROBE(id) \
+  probe_t probe_ __attribute__((cleanup(probe_finish))) = probe_begin(id)
+#define PROBE_FLOPS(value) (probe_.flops = (value))
+#define PROBE_BYTES(value) (probe_.bytes = (value))
+#else
+#define PROBE(id) (void)0
+#define PROBE_FLOPS(value) (void)0
+#define PROBE_BYTES(value) (void)0
+#endif
+
+double *matrix_data(matrix_t *M);
+int check_output(matrix_t *result, int rows, int columns);
+void copy_to_buffer(matrix_t *A, double *buffer);
+int lu_decompose(double *a, int n, int *pivots, int *sign);
+int lu_determinant(matrix_t *A, double *result);
+void lu_solve(const double *lu, int n, const int *pivots, double **x,
+              int nrhs);
+int lu_inverse(matrix_t *A, matrix_t *result);
+int lu_complements(matrix_t *A, matrix_t *result);
+int cholesky_decompose(double *a, int n);
+void cholesky_solve(const double *l, int n, double **x, int nrhs);
+int qr_decompose(double *a, int m, int n, double *tau, int *perm, int *sign);
+int qr_rank(const double *r, int m, int n);
+void qr_solve(const double *qr, const double *tau, const int *perm, int m,
+              int n, double **b, int nrhs, double *w, double **x);
+double small_determinant(double *const *a, int n);
+void small_complements(double *const *a, int n, double **r);
+int small_inverse(double *const *a, int n, double **r);
+int small_mult(int n, double *const *a, double *const *b, double **c);
+int gemm_kernel(int m, int n, int k, double *const *a, double *const *b,
+                double **c);
+int gemm_update(int m, int n, int k, const double *a, int lda,
+                const double *b, int ldb, double *c, int ldc);
+int use_strassen(int m, int n, int k);
+int gemv_kernel(int m, int n, double *const *a, const double *x, double *y);
+int gemv_t_kernel(int m, int n, double *const *a, const double *x,
+                  double *y);
+int strassen_kernel(int n, double *const *a, double *const *b, double **c);
+int pool_threads(double flops);
+void pool_run(void (*task)(void *arg, int index), void *arg, int count);
+int simd_add(const double *a, const double *b, double *r, size_t n);
+int simd_sub(const double *a, const double *b, double *r, size_t n);
+int simd_mul(const double *a, const double *b, double *r, size_t n);
+int simd_scale(const double *a, double k, double *r, size_t n);
+double simd_dot(const double *x, const double *y, size_t n);
+void simd_axpy(double a, const double *x, double *y, size_t n);
+double simd_asum(const double *x, size_t n);
+double simd_amax(const double *x, size_t n);
+void simd_transpose(double *const *src, int i0, int j0, int rows, int cols,
+                    double **dst);
+int simd_add_f32(const float *a, const float *b, float *r, size_t n);
+int simd_sub_f32(const float *a, const float *b, float *r, size_t n);
+int simd_scale_f32(const float *a, float k, float *r, size_t n);
+void simd_axpy_f32(float a, const float *x, float *y, size_t n);
+void simd_axpy_mixed(double a, const float *x, double *y, size_t n);
+const char *simd_name(void);
+void transpose_blocked(double *const *src, int i0, int j0, int rows, int cols,
+                       double **dst);
+void transpose_square(double **a, int n);
+void *arena_alloc(arena_t *arena, size_t size);
+arena_t *scratch_arena(void);
+
+#endif  // SRC_S21_INTERNAL_H_
@@ -0,0 +1,496 @@
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "s21_internal.h"
+
+/*
+ * Двоичный формат файла матрицы: заголовок из 64 байт и сразу за ним
+ * элементы double построчно, в порядке байтов машины, которая записала файл.
+ * Данные начинаются со смещения MATRIX_FILE_HEADER, поэтому в отображённом в
+ * память файле они выровнены на MATRIX_ALIGN, как и в s21_create_matrix.
+ */
+
+#define MATRIX_FILE_MAGIC "S21M"
+#define MATRIX_FILE_VERSION 1
+#define MATRIX_FILE_HEADER 64
+#define MATRIX_FILE_DOUBLE 1
+#define MATRIX_FILE_ROW_MAJOR 0
+#define MATRIX_FILE_BYTE_ORDER 0x01020304u
+#define MATRIX_FILE_IOV 1024
+
+typedef struct matrix_file_header {
+  char magic[4];
+  uint16_t version;
+  uint16_t dtype;
+  uint16_t layout;
+  uint16_t header_size;
+  uint32_t alignment;
+  uint32_t byte_order;
+  uint32_t reserved;
+  uint64_t rows;
+  uint64_t columns;
+  uint64_t data_offset;
+  uint64_t data_size;
+  uint8_t padding[8];
+} matrix_file_header;
+
+_Static_assert(sizeof(matrix_file_header) == MATRIX_FILE_HEADER,
+               "matrix file header must be 64 bytes");
+
+/**
+ * Функция check_header проверяет заголовок файла: сигнатуру, версию, тип и
+ * порядок элементов, порядок байтов и согласованность размеров с размером
+ * файла file_size. Размер данных сначала проверяется на переполнение: иначе
+ * подобранные rows и columns дают маленький data_size, и по файлу в сотни
+ * килобайт строились бы указатели далеко за его пределы.
+ *
+ * @return `OK` или `INCORRECT_MATRIX`, если файл не является матрицей в
+ * поддерживаемом формате.
+ */
+static int check_header(const matrix_file_header *header, uint64_t file_size) {
+  int res = OK;
+  if (memcmp(header->magic, MATRIX_FILE_MAGIC, 4) != 0 ||
+      header->version != MATRIX_FILE_VERSION ||
+      header->dtype != MATRIX_FILE_DOUBLE ||
+      header->layout != MATRIX_FILE_ROW_MAJOR ||
+      header->header_size != MATRIX_FILE_HEADER ||
+      header->byte_order != MATRIX_FILE_BYTE_ORDER ||
+      header->data_offset != MATRIX_FILE_HEADER) {
+    res = INCORRECT_MATRIX;
+  } else if (header->rows < 1 || header->rows > INT32_MAX ||
+             header->columns < 1 || header->columns > INT32_MAX ||
+             header->columns > SIZE_MAX / sizeof(double) / header->rows ||
+             header->data_size !=
+                 header->rows * header->columns * sizeof(double) ||
+             file_size < header->data_offset + header->data_size) {
+    res = INCORRECT_MATRIX;
+  }
+  return res;
+}
+
+/**
+ * Функция write_all записывает буферы iov целиком, повторяя writev после
+ * частичной записи или прерывания сигналом.
+ *
+ * @return `OK` или `CALC_ERROR` при ошибке записи.
+ */
+static int write_all(int fd, struct iovec *iov, int count) {
+  while (count > 0) {
+    ssize_t written = writev(fd, iov, count);
+    if (written < 0 && errno == EINTR) continue;
+    if (written < 0) return CALC_ERROR;
+    while (count > 0 && (size_t)written >= iov->iov_len) {
+      written -= iov->iov_len;
+      iov++;
+      count--;
+    }
+    if (count > 0) {
+      iov->iov_base = (char *)iov->iov_base + written;
+      iov->iov_len -= written;
+    }
+  }
+  return OK;
+}
+
+/**
+ * Функция s21_save_matrix записывает матрицу A в файл path в двоичном формате.
+ * Заголовок и данные непрерывной матрицы уходят одним вызовом writev без
+ * промежуточного буфера; строки матрицы, хранящейся не одним блоком,
+ * передаются пачками по MATRIX_FILE_IOV строк.
+ *
+ * @param A Сохраняемая матрица.
+ * @param path Путь к файлу; существующий файл перезаписывается.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A неверна или path равен NULL, или
+ * `CALC_ERROR`, если файл не удалось создать или записать.
+ */
+int s21_save_matrix(matrix_t *A, const char *path) {
+  if (is_correct_matrix(A) != OK || path == NULL) return INCORRECT_MATRIX;
+
+  size_t row_size = sizeof(double) * A->columns;
+  matrix_file_header header = {
+      .magic = MATRIX_FILE_MAGIC,
+      .version = MATRIX_FILE_VERSION,
+      .dtype = MATRIX_FILE_DOUBLE,
+      .layout = MATRIX_FILE_ROW_MAJOR,
+      .header_size = MATRIX_FILE_HEADER,
+      .alignment = MATRIX_ALIGN,
+      .byte_order = MATRIX_FILE_BYTE_ORDER,
+      .rows = A->rows,
+      .columns = A->columns,
+      .data_offset = MATRIX_FILE_HEADER,
+      .data_size = (uint64_t)A->rows * row_size};
+
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) return CALC_ERROR;
+
+  struct iovec iov[MATRIX_FILE_IOV + 1] = {{&header, sizeof(header)}};
+  double *data = matrix_data(A);
+  int res = OK;
+  if (data != NULL) {
+    iov[1] = (struct iovec){data, header.data_size};
+    res = write_all(fd, iov, 2);
+  } else {
+    int count = 1;
+    for (int i = 0; i < A->rows && res == OK; i++) {
+      iov[count++] = (struct iovec){A->matrix[i], row_size};
+      if (count == MATRIX_FILE_IOV + 1 || i == A->rows - 1) {
+        res = write_all(fd, iov, count);
+        count = 0;
+      }
+    }
+  }
+  if (close(fd) != 0) res = CALC_ERROR;
+  return res;
+}
+
+/**
+ * Функция pread_all читает size байт со смещения offset, повторяя pread после
+ * частичного чтения или прерывания сигналом.
+ *
+ * @return `OK` или `CALC_ERROR` при ошибке чтения или конце файла.
+ */
+static int pread_all(int fd, char *buffer, size_t size, off_t offset) {
+  while (size > 0) {
+    ssize_t got = pread(fd, buffer, size, offset);
+    if (got < 0 && errno == EINTR) continue;
+    if (got <= 0) return CALC_ERROR;
+    buffer += got;
+    size -= got;
+    offset += got;
+  }
+  return OK;
+}
+
+/**
+ * Функция open_matrix_file открывает файл матрицы, читает и проверяет
+ * заголовок.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если формат неверен, или `CALC_ERROR`,
+ * если файл не удалось открыть или прочитать. При ошибке файл закрывается.
+ */
+static int open_matrix_file(const char *path, int *fd,
+                            matrix_file_header *header) {
+  if (path == NULL) return INCORRECT_MATRIX;
+  *fd = open(path, O_RDONLY);
+  if (*fd < 0) return CALC_ERROR;
+
+  struct stat info;
+  int res = fstat(*fd, &info) == 0 ? OK : CALC_ERROR;
+  if (res == OK && (size_t)info.st_size < sizeof(*header)) {
+    res = INCORRECT_MATRIX;
+  }
+  if (res == OK &&
+      pread(*fd, header, sizeof(*header), 0) != (ssize_t)sizeof(*header)) {
+    res = CALC_ERROR;
+  }
+  if (res == OK) res = check_header(header, (uint64_t)info.st_size);
+  if (res != OK) close(*fd);
+  return res;
+}
+
+/**
+ * Функция s21_load_matrix создаёт матрицу result и читает в неё данные из
+ * файла, записанного s21_save_matrix. Данные читаются сразу в блок
+ * элементов матрицы без промежуточного буфера.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если path или result равны NULL или файл
+ * не является матрицей в поддерживаемом формате, или `CALC_ERROR`, если файл
+ * не удалось прочитать или не хватило памяти. При ошибке result не создаётся.
+ */
+int s21_load_matrix(const char *path, matrix_t *result) {
+  if (result == NULL) return INCORRECT_MATRIX;
+  int fd = -1;
+  matrix_file_header header;
+  int res = open_matrix_file(path, &fd, &header);
+  if (res != OK) return res;
+
+  res = s21_create_matrix(header.rows, header.columns, result);
+  if (res == OK) {
+    res = pread_all(fd, (char *)result->matrix[0], header.data_size,
+                    header.data_offset);
+    if (res != OK) s21_remove_matrix(result);
+  }
+  close(fd);
+  return res;
+}
+
+/**
+ * Функция s21_map_matrix отображает файл матрицы в память только для чтения
+ * и заполняет result указателями на строки внутри отображения. Данные не
+ * копируются и не читаются заранее: выделяется только массив указателей на
+ * строки, а страницы подгружаются системой при первом обращении, поэтому
+ * открытие не зависит от размера файла. Запись в такую матрицу недопустима.
+ * Отображение освобождается функцией s21_unmap_matrix, а не
+ * s21_remove_matrix.
+ *
+ * @return Коды ошибок такие же, как у s21_load_matrix.
+ */
+int s21_map_matrix(const char *path, matrix_t *result) {
+  if (result == NULL) return INCORRECT_MATRIX;
+  int fd = -1;
+  matrix_file_header header;
+  int res = open_matrix_file(path, &fd, &header);
+  if (res != OK) return res;
+
+  size_t length = header.data_offset + header.data_size;
+  char *base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) return CALC_ERROR;
+
+  double **rows = malloc(sizeof(double *) * header.rows);
+  if (rows == NULL) {
+    munmap(base, length);
+    return CALC_ERROR;
+  }
+  double *data = (double *)(base + header.data_offset);
+  for (uint64_t i = 0; i < header.rows; i++) {
+    rows[i] = data + i * header.columns;
+  }
+  result->matrix = rows;
+  result->rows = header.rows;
+  result->columns = header.columns;
+  return OK;
+}
+
+/**
+ * Функция s21_unmap_matrix освобождает матрицу, созданную s21_map_matrix.
+ * Начало отображения находится по первой строке: данные лежат на странице,
+ * с которой начинается заголовок, а размер отображения берётся из него.
+ */
+void s21_unmap_matrix(matrix_t *A) {
+  if (A == NULL || A->matrix == NULL) return;
+  uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+  char *base = (char *)((uintptr_t)A->matrix[0] & ~(page - 1));
+  const matrix_file_header *header = (const matrix_file_header *)base;
+  munmap(base, header->data_offset + header->data_size);
+  free(A->matrix);
+  A->matrix = NULL;
+}
+
+/*
+ * Умножение матриц, хранящихся в файлах, при ограниченной памяти: C = A * B
+ * считается плитками MB x NB, для каждой плитки по очереди читаются панели
+ * A (MB x KB) и B (KB x NB) и накапливаются через gemm_kernel. Готовая плитка
+ * сразу записывается в файл результата. Перед вычислением очередных панелей
+ * системе сообщается (posix_fadvise), какие участки файлов понадобятся
+ * следующими, чтобы чтение с диска шло параллельно с вычислениями.
+ */
+
+typedef struct file_operand {
+  int fd;
+  matrix_file_header header;
+} file_operand;
+
+/** Функция pwrite_all — то же, что pread_all, для записи. */
+static int pwrite_all(int fd, const char *buffer, size_t size, off_t offset) {
+  while (size > 0) {
+    ssize_t put = pwrite(fd, buffer, size, offset);
+    if (put < 0 && errno == EINTR) continue;
+    if (put <= 0) return CALC_ERROR;
+    buffer += put;
+    size -= put;
+    offset += put;
+  }
+  return OK;
+}
+
+static off_t element_offset(const matrix_file_header *header, int row,
+                            int column) {
+  return (off_t)(header->data_offset +
+                 ((uint64_t)row * header->columns + column) * sizeof(double));
+}
+
+/**
+ * Функция transfer_block читает (или, если write не равен нулю, записывает)
+ * блок rows x width файла, начиная с элемента (row, column), из непрерывного
+ * буфера block. Блок во всю ширину матрицы передаётся одним вызовом, иначе —
+ * по строкам.
+ */
+static int transfer_block(const file_operand *file, int row, int column,
+                          int rows, int width, double *block, int write) {
+  int full = (uint64_t)width == file->header.columns;
+  int count = full ? 1 : rows;
+  size_t size = sizeof(double) * width * (full ? rows : 1);
+  int res = OK;
+  for (int i = 0; i < count && res == OK; i++) {
+    char *buffer = (char *)(block + (size_t)i * width);
+    off_t offset = element_offset(&file->header, row + i, column);
+    res = write ? pwrite_all(file->fd, buffer, size, offset)
+                : pread_all(file->fd, buffer, size, offset);
+  }
+  return res;
+}
+
+static void prefetch_block(const file_operand *file, int row, int column,
+                           int rows, int width) {
+  int full = (uint64_t)width == file->header.columns;
+  int count = full ? 1 : rows;
+  off_t size = (off_t)sizeof(double) * width * (full ? rows : 1);
+  for (int i = 0; i < count; i++) {
+    posix_fadvise(file->fd, element_offset(&file->header, row + i, column),
+                  size, POSIX_FADV_WILLNEED);
+  }
+}
+
+static int min_int(int a, int b) { return a < b ? a : b; }
+
+/**
+ * Функция file_tile возвращает наибольший размер плитки T, при котором три
+ * плитки T x T и 3 * T указателей на их строки помещаются в memory_limit
+ * байт, или 0, если не помещается даже плитка 1 x 1.
+ */
+static int file_tile(size_t memory_limit) {
+  double square = 3.0 * sizeof(double), linear = 3.0 * sizeof(double *);
+  double root = (-linear + sqrt(linear * linear + 4 * square * memory_limit)) /
+                (2 * square);
+  size_t tile = root < INT32_MAX ? (size_t)root : INT32_MAX;
+  while (tile > 0 && tile * tile * square + tile * linear > memory_limit) {
+    tile--;
+  }
+  return (int)tile;
+}
+
+/**
+ * Функция same_file сообщает, указывает ли path на тот же файл, что и
+ * открытый дескриптор fd.
+ */
+static int same_file(int fd, const char *path) {
+  struct stat opened, named;
+  return fstat(fd, &opened) == 0 && stat(path, &named) == 0 &&
+         opened.st_dev == named.st_dev && opened.st_ino == named.st_ino;
+}
+
+/**
+ * Функция multiply_tiles выполняет основной цикл по плиткам. buffer содержит
+ * панели A и B, плитку C и массивы указателей на их строки.
+ */
+static int multiply_tiles(const file_operand *a, const file_operand *b,
+                          const file_operand *c, int tile, double *buffer) {
+  int m = a->header.rows, k = a->header.columns, n = b->header.columns;
+  int mb = min_int(m, tile), kb = min_int(k, tile), nb = min_int(n, tile);
+  double *a_panel = buffer, *b_panel = a_panel + (size_t)mb * kb;
+  double *c_tile = b_panel + (size_t)kb * nb;
+  double **rows = (double **)(c_tile + (size_t)mb * nb);
+
+  int res = OK, bad = 0;
+  for (int i0 = 0; i0 < m && res == OK; i0 += mb) {
+    int mi = min_int(mb, m - i0);
+    for (int j0 = 0; j0 < n && res == OK; j0 += nb) {
+      int nj = min_int(nb, n - j0);
+      memset(c_tile, 0, sizeof(double) * mi * nj);
+      for (int p0 = 0; p0 < k && res == OK; p0 += kb) {
+        int kp = min_int(kb, k - p0);
+        res = transfer_block(a, i0, p0, mi, kp, a_panel, 0);
+        if (res == OK) res = transfer_block(b, p0, j0, kp, nj, b_panel, 0);
+
+        if (p0 + kb < k) {
+          prefetch_block(a, i0, p0 + kb, mi, min_int(kb, k - p0 - kb));
+          prefetch_block(b, p0 + kb, j0, min_int(kb, k - p0 - kb), nj);
+        } else if (j0 + nb < n) {
+          prefetch_block(a, i0, 0, mi, kb);
+          prefetch_block(b, 0, j0 + nb, kb, min_int(nb, n - j0 - nb));
+        } else if (i0 + mb < m) {
+          prefetch_block(a, i0 + mb, 0, min_int(mb, m - i0 - mb), kb);
+          prefetch_block(b, 0, 0, kb, nb);
+        }
+
+        for (int i = 0; i < mi; i++) rows[i] = a_panel + (size_t)i * kp;
+        for (int p = 0; p < kp; p++) {
+          rows[mi + p] = b_panel + (size_t)p * nj;
+        }
+        for (int i = 0; i < mi; i++) {
+          rows[mi + kp + i] = c_tile + (size_t)i * nj;
+        }
+        if (res == OK) {
+          bad |= gemm_kernel(mi, nj, kp, rows, rows + mi, rows + mi + kp);
+        }
+      }
+      if (res == OK) res = transfer_block(c, i0, j0, mi, nj, c_tile, 1);
+    }
+  }
+  return res == OK && bad ? CALC_ERROR : res;
+}
+
+/**
+ * Функция s21_mult_matrix_file перемножает матрицы из файлов a_path и b_path
+ * (в формате s21_save_matrix) и записывает результат в файл result_path, не
+ * загружая матрицы в память целиком. Размер плиток T подбирается так, чтобы
+ * панели A и B, плитка результата T x T и 3 * T указателей на их строки
+ * занимали не больше memory_limit байт. A читается n / T раз, B — m / T раз,
+ * поэтому чем больше memory_limit, тем меньше объём чтения.
+ *
+ * В memory_limit не входят буферы упаковки, которые gemm_kernel берёт из
+ * арены потока: до (GEMM_KC * GEMM_NC + GEMM_MC * GEMM_KC) элементов, около
+ * 4,5 МБ на каждый поток, для плиток меньше GEMM_NC — пропорционально меньше.
+ *
+ * @param memory_limit Ограничение памяти для плиток в байтах.
+ *
+ * @return Функция s21_mult_matrix_file возвращает:
+ * - `OK`, если произведение записано
+ * - `INCORRECT_MATRIX`, если путь равен NULL, файл не является матрицей в
+ * поддерживаемом формате или result_path указывает на один из входных файлов
+ * (он был бы обрезан до чтения)
+ * - `CALC_ERROR`, если размеры не согласованы, memory_limit меньше одной
+ * плитки 1 x 1, файлы не удалось прочитать или записать либо в результате
+ * есть бесконечность или NaN
+ */
+int s21_mult_matrix_file(const char *a_path, const char *b_path,
+                         const char *result_path, size_t memory_limit) {
+  if (result_path == NULL) return INCORRECT_MATRIX;
+  file_operand a = {.fd = -1}, b = {.fd = -1}, c = {.fd = -1};
+  int res = open_matrix_file(a_path, &a.fd, &a.header);
+  if (res == OK) {
+    res = open_matrix_file(b_path, &b.fd, &b.header);
+    if (res != OK) close(a.fd);
+  }
+  if (res == OK &&
+      (same_file(a.fd, result_path) || same_file(b.fd, result_path))) {
+    close(a.fd);
+    close(b.fd);
+    res = INCORRECT_MATRIX;
+  }
+  if (res != OK) return res;
+
+  int tile = file_tile(memory_limit);
+  uint64_t largest = a.header.rows > a.header.columns ? a.header.rows
+                                                      : a.header.columns;
+  if (b.header.columns > largest) largest = b.header.columns;
+  if ((uint64_t)tile > largest) tile = (int)largest;
+  double *buffer = NULL;
+  if (a.header.columns != b.header.rows || tile < 1) {
+    res = CALC_ERROR;
+  } else {
+    buffer = malloc(3 * sizeof(double) * tile * tile +
+                    3 * sizeof(double *) * tile);
+    if (buffer == NULL) res = CALC_ERROR;
+  }
+
+  if (res == OK) {
+    c.header = a.header;
+    c.header.columns = b.header.columns;
+    c.header.data_size = c.header.rows * c.header.columns * sizeof(double);
+    c.fd = open(result_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (c.fd < 0) res = CALC_ERROR;
+  }
+  if (res == OK &&
+      (ftruncate(c.fd, c.header.data_offset + c.header.data_size) != 0 ||
+       pwrite_all(c.fd, (const char *)&c.header, sizeof(c.header), 0) !=
+           OK)) {
+    res = CALC_ERROR;
+  }
+  if (res == OK) res = multiply_tiles(&a, &b, &c, tile, buffer);
+
+  if (c.fd >= 0 && close(c.fd) != 0) res = CALC_ERROR;
+  close(a.fd);
+  close(b.fd);
+  free(buffer);
+  return res;
+}
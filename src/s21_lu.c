@@ -0,0 +1,395 @@
+#include <float.h>
+#include <string.h>
+
+#include "s21_internal.h"
+
+#define LU_BLOCK 64
+
+/**
+ * Функция copy_to_buffer копирует элементы матрицы A построчно в непрерывный
+ * буфер из A->rows * A->columns элементов.
+ */
+void copy_to_buffer(matrix_t *A, double *buffer) {
+  double *data = matrix_data(A);
+  if (data != NULL) {
+    memcpy(buffer, data, sizeof(double) * A->rows * A->columns);
+  } else {
+    for (int i = 0; i < A->rows; i++) {
+      memcpy(buffer + i * A->columns, A->matrix[i],
+             sizeof(double) * A->columns);
+    }
+  }
+}
+
+/**
+ * Функция lu_panel раскладывает столбцы k0..k0 + nb - 1 (панель) в строках
+ * k0..n - 1: выбирает ведущие элементы, переставляет строки целиком и
+ * обновляет только столбцы панели.
+ *
+ * @return `OK` или `CALC_ERROR`, если модуль ведущего элемента столбца не
+ * больше tolerance; в этом случае по указателю sign записывается 0.
+ */
+static int lu_panel(double *a, int n, int k0, int nb, double tolerance,
+                    int *pivots, int *sign) {
+  int res = OK;
+  for (int k = k0; k < k0 + nb && res == OK; k++) {
+    int p = k;
+    double max = fabs(a[k * n + k]);
+    for (int i = k + 1; i < n; i++) {
+      double value = fabs(a[i * n + k]);
+      if (value > max) {
+        max = value;
+        p = i;
+      }
+    }
+    pivots[k] = p;
+
+    if (max <= tolerance) {
+      *sign = 0;
+      res = CALC_ERROR;
+    } else {
+      double *row_k = a + k * n;
+      if (p != k) {
+        double *row_p = a + p * n;
+        for (int j = 0; j < n; j++) {
+          double tmp = row_k[j];
+          row_k[j] = row_p[j];
+          row_p[j] = tmp;
+        }
+        *sign = -*sign;
+      }
+      for (int i = k + 1; i < n; i++) {
+        double *row_i = a + i * n;
+        double l = row_i[k] / row_k[k];
+        row_i[k] = l;
+        for (int j = k + 1; j < k0 + nb; j++) {
+          row_i[j] -= l * row_k[j];
+        }
+      }
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция lu_decompose выполняет LU-разложение квадратной матрицы с частичным
+ * выбором ведущего элемента по столбцу. Разложение выполняется на месте: после
+ * завершения под главной диагональю хранятся множители L (единичная диагональ
+ * не хранится), а на диагонали и выше — элементы U.
+ *
+ * Матрица обрабатывается панелями по LU_BLOCK столбцов: панель раскладывается
+ * построчным алгоритмом (lu_panel), строки U справа от неё получаются прямой
+ * подстановкой, а остаточная матрица обновляется одним умножением
+ * gemm_update, на которое приходится почти вся работа. Для матриц порядка не
+ * больше LU_BLOCK это обычный построчный алгоритм.
+ *
+ * Матрица считается вырожденной, если модуль ведущего элемента не больше
+ * n * DBL_EPSILON * max|A|: точный ноль на диагонали после исключения почти
+ * никогда не получается, и без этого порога линейно зависимые строки дают
+ * ведущий элемент порядка ошибки округления и «обратную» матрицу с
+ * элементами порядка 1e15. Если в матрице есть бесконечность, порог равен
+ * нулю, чтобы переполнение обнаружил gemm_update, а не проверка вырожденности.
+ *
+ * @param a Указатель на непрерывный буфер из n * n элементов, хранящий матрицу
+ * построчно. Содержимое буфера перезаписывается результатом разложения.
+ * @param n Порядок матрицы.
+ * @param pivots Массив из n элементов, в который записываются номера строк,
+ * переставленных на k-м шаге с k-й строкой.
+ * @param sign Указатель, по которому записывается знак перестановки: 1 при
+ * чётном числе перестановок строк и -1 при нечётном. Для вырожденной матрицы
+ * записывается 0, так что вырожденность можно отличить от других ошибок.
+ *
+ * @return Функция lu_decompose возвращает:
+ * - `OK`, если разложение выполнено полностью
+ * - `CALC_ERROR`, если матрица вырождена (ведущий элемент столбца не больше
+ * порога, *sign равен 0), если gemm_update не смог выделить буферы или получил
+ * бесконечность либо NaN (*sign равен ±1); в этом случае разложение
+ * прерывается на соответствующем шаге
+ */
+int lu_decompose(double *a, int n, int *pivots, int *sign) {
+  int res = OK;
+  double scale = 0;
+  *sign = 1;
+  for (int i = 0; i < n * n; i++) {
+    if (fabs(a[i]) > scale) scale = fabs(a[i]);
+  }
+  double tolerance = isfinite(scale) ? n * DBL_EPSILON * scale : 0;
+
+  for (int k0 = 0; k0 < n && res == OK; k0 += LU_BLOCK) {
+    int nb = n - k0 < LU_BLOCK ? n - k0 : LU_BLOCK;
+    int rest = n - k0 - nb;
+    res = lu_panel(a, n, k0, nb, tolerance, pivots, sign);
+    if (res != OK || rest == 0) continue;
+
+    for (int k = k0; k < k0 + nb; k++) {
+      const double *row_k = a + k * n + k0 + nb;
+      for (int i = k + 1; i < k0 + nb; i++) {
+        double l = a[i * n + k];
+        double *row_i = a + i * n + k0 + nb;
+        for (int j = 0; j < rest; j++) row_i[j] -= l * row_k[j];
+      }
+    }
+    double *corner = a + (k0 + nb) * n + k0;
+    res = gemm_update(rest, rest, nb, corner, n, a + k0 * n + k0 + nb, n,
+                      corner + nb, n);
+  }
+  return res;
+}
+
+/**
+ * Функция lu_determinant вычисляет определитель квадратной матрицы через
+ * LU-разложение за O(n^3). Исходная матрица не изменяется: разложение
+ * выполняется в одном временном буфере из арены потока (scratch_arena).
+ *
+ * @param A Указатель на корректную квадратную матрицу.
+ * @param result Указатель, по которому записывается определитель. Для
+ * вырожденной матрицы записывается 0.
+ *
+ * @return Функция lu_determinant возвращает:
+ * - `OK`, если определитель вычислен (в том числе равный нулю)
+ * - `CALC_ERROR`, если не удалось выделить временный буфер или при обновлении
+ * остаточной матрицы появилась бесконечность или NaN
+ */
+int lu_determinant(matrix_t *A, double *result) {
+  int n = A->rows;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  double *a = arena_alloc(arena, sizeof(double) * n * n + sizeof(int) * n);
+  if (a == NULL) return CALC_ERROR;
+
+  int *pivots = (int *)(a + n * n);
+  copy_to_buffer(A, a);
+
+  int sign = 1;
+  int res = lu_decompose(a, n, pivots, &sign);
+  if (res == OK) {
+    double det = sign;
+    for (int i = 0; i < n; i++) {
+      det *= a[i * n + i];
+    }
+    *result = det;
+  } else if (sign == 0) {
+    *result = 0;
+    res = OK;
+  }
+
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+/**
+ * Функция lu_solve решает систему A * X = B по готовому LU-разложению матрицы
+ * A. Правая часть задаётся строками и заменяется решением на месте, поэтому
+ * все проходы прямой и обратной подстановки идут по непрерывным строкам.
+ *
+ * @param lu Буфер с результатом lu_decompose для матрицы порядка n.
+ * @param n Порядок матрицы.
+ * @param pivots Перестановки строк, полученные от lu_decompose.
+ * @param x Массив из n указателей на строки правой части, каждая длиной nrhs.
+ * После завершения строки содержат решение.
+ * @param nrhs Количество столбцов правой части.
+ */
+void lu_solve(const double *lu, int n, const int *pivots, double **x,
+              int nrhs) {
+  for (int k = 0; k < n; k++) {
+    if (pivots[k] != k) {
+      double *row_k = x[k];
+      double *row_p = x[pivots[k]];
+      for (int j = 0; j < nrhs; j++) {
+        double tmp = row_k[j];
+        row_k[j] = row_p[j];
+        row_p[j] = tmp;
+      }
+    }
+  }
+
+  for (int i = 1; i < n; i++) {
+    for (int k = 0; k < i; k++) {
+      double l = lu[i * n + k];
+      if (l != 0) {
+        for (int j = 0; j < nrhs; j++) x[i][j] -= l * x[k][j];
+      }
+    }
+  }
+
+  for (int i = n - 1; i >= 0; i--) {
+    for (int k = i + 1; k < n; k++) {
+      double u = lu[i * n + k];
+      if (u != 0) {
+        for (int j = 0; j < nrhs; j++) x[i][j] -= u * x[k][j];
+      }
+    }
+    double d = 1 / lu[i * n + i];
+    for (int j = 0; j < nrhs; j++) x[i][j] *= d;
+  }
+}
+
+/**
+ * Функция lu_inverse вычисляет обратную матрицу за O(n^3) через одно
+ * LU-разложение: единичная матрица записывается прямо в result и решается
+ * система A * X = E. Промежуточные матрицы не создаются.
+ *
+ * @param A Указатель на корректную квадратную матрицу.
+ * @param result Указатель на структуру, в которой создаётся обратная матрица.
+ * Для вырожденной матрицы result не создаётся.
+ *
+ * @return Функция lu_inverse возвращает:
+ * - `OK`, если обратная матрица вычислена
+ * - `CALC_ERROR`, если матрица вырождена или не удалось выделить память
+ */
+int lu_inverse(matrix_t *A, matrix_t *result) {
+  int n = A->rows;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  double *a = arena_alloc(arena, sizeof(double) * n * n + sizeof(int) * n);
+  if (a == NULL) return CALC_ERROR;
+
+  int *pivots = (int *)(a + n * n);
+  copy_to_buffer(A, a);
+
+  int sign = 1;
+  int res = lu_decompose(a, n, pivots, &sign);
+  if (res == OK) res = s21_create_matrix(n, n, result);
+  if (res == OK) {
+    for (int i = 0; i < n; i++) result->matrix[i][i] = 1;
+    lu_solve(a, n, pivots, result->matrix, n);
+  }
+
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+typedef struct cofactor_task {
+  double *const *a;
+  double **r;
+  int n;
+  int *status;
+} cofactor_task;
+
+/**
+ * Функция cofactor_row вычисляет строку index матрицы алгебраических
+ * дополнений: каждый минор копируется в непрерывный буфер и его определитель
+ * находится через lu_decompose. Буфер берётся из арены того потока, который
+ * выполняет задачу, поэтому строки можно считать параллельно. Вырожденный
+ * минор даёт 0, остальные ошибки разложения записываются в status.
+ */
+static void cofactor_row(void *arg, int index) {
+  cofactor_task *t = arg;
+  int m = t->n - 1;
+  arena_t *arena = scratch_arena();
+  arena_mark_t mark = s21_arena_mark(arena);
+  double *minor =
+      arena ? arena_alloc(arena, sizeof(double) * m * m + sizeof(int) * m)
+            : NULL;
+  t->status[index] = minor ? OK : CALC_ERROR;
+
+  for (int j = 0; j < t->n && minor != NULL; j++) {
+    double *dst = minor;
+    for (int i = 0; i < t->n; i++) {
+      if (i == index) continue;
+      memcpy(dst, t->a[i], sizeof(double) * j);
+      memcpy(dst + j, t->a[i] + j + 1, sizeof(double) * (m - j));
+      dst += m;
+    }
+    int sign = 1;
+    double det = 0;
+    if (lu_decompose(minor, m, (int *)(minor + m * m), &sign) == OK) {
+      det = sign;
+      for (int i = 0; i < m; i++) det *= minor[i * m + i];
+    } else if (sign != 0) {
+      t->status[index] = CALC_ERROR;
+    }
+    t->r[index][j] = (index + j) % 2 == 0 ? det : -det;
+  }
+  s21_arena_release(arena, mark);
+}
+
+/**
+ * Функция cofactor_minors заполняет матрицу алгебраических дополнений r через
+ * n^2 независимых миноров. Если объём работы не меньше порога
+ * s21_set_parallel_threshold, строки распределяются по пулу потоков.
+ *
+ * @return `OK` или `CALC_ERROR`, если не удалось выделить временный буфер или
+ * разложение минора завершилось ошибкой, отличной от вырожденности.
+ */
+static int cofactor_minors(double *const *a, int n, double **r) {
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  int *status = arena_alloc(arena, sizeof(int) * n);
+  if (status == NULL) return CALC_ERROR;
+
+  cofactor_task t = {a, r, n, status};
+  double flops = (double)n * n * (n - 1) * (n - 1) * (n - 1) / 3;
+  if (pool_threads(flops) > 1) {
+    pool_run(cofactor_row, &t, n);
+  } else {
+    for (int i = 0; i < n; i++) cofactor_row(&t, i);
+  }
+
+  int res = OK;
+  for (int i = 0; i < n; i++) {
+    if (status[i] != OK) res = CALC_ERROR;
+  }
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+/**
+ * Функция lu_complements вычисляет матрицу алгебраических дополнений за
+ * O(n^3) через одно LU-разложение: для невырожденной матрицы она равна
+ * det(A) * (A^-1)^T. Обратная матрица решается во временном буфере, а в
+ * result сразу записывается транспонированный и умноженный на определитель
+ * результат. Если матрица вырождена, дополнения считаются по минорам
+ * (cofactor_minors).
+ *
+ * @param A Указатель на корректную квадратную матрицу порядка не меньше 2.
+ * @param result Указатель на структуру, в которой создаётся результат.
+ *
+ * @return Функция lu_complements возвращает:
+ * - `OK`, если матрица дополнений вычислена
+ * - `CALC_ERROR`, если не удалось выделить память или при разложении
+ * появилась бесконечность или NaN; result в этом случае не создаётся
+ */
+int lu_complements(matrix_t *A, matrix_t *result) {
+  int n = A->rows;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  double *a = arena_alloc(arena, sizeof(double) * 2 * n * n +
+                                     sizeof(double *) * n + sizeof(int) * n);
+  if (a == NULL) return CALC_ERROR;
+
+  double *inverse = a + n * n;
+  double **rows = (double **)(inverse + n * n);
+  int *pivots = (int *)(rows + n);
+  copy_to_buffer(A, a);
+
+  int sign = 1;
+  int res = lu_decompose(a, n, pivots, &sign);
+  int singular = res != OK && sign == 0;
+  if (res == OK || singular) res = s21_create_matrix(n, n, result);
+  if (res == OK && singular) {
+    res = cofactor_minors(A->matrix, n, result->matrix);
+    if (res != OK) s21_remove_matrix(result);
+  } else if (res == OK) {
+    double det = sign;
+    for (int i = 0; i < n; i++) det *= a[i * n + i];
+    memset(inverse, 0, sizeof(double) * n * n);
+    for (int i = 0; i < n; i++) {
+      rows[i] = inverse + i * n;
+      rows[i][i] = 1;
+    }
+    lu_solve(a, n, pivots, rows, n);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        result->matrix[i][j] = det * inverse[j * n + i];
+      }
+    }
+  }
+
+  s21_arena_release(arena, mark);
+  return res;
+}
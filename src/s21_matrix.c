@@ -1,7 +1,9 @@
-#include "s21_matrix.h"
+#include "s21_internal.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define OK 0
 #define INVALID_MATRIX 1
@@ -21,19 +23,40 @@
  * матрицы, количество строк и количество столбцов. Функция `s21_create_matrix`
  * инициализирует матрицу указанным количеством строк.
  *
+ * Все элементы матрицы хранятся в одном непрерывном блоке, выровненном на
+ * MATRIX_ALIGN байт, с ведущей размерностью, равной columns; массив указателей
+ * на строки размещается в начале того же блока и указывает внутрь него. Таким
+ * образом создание и удаление матрицы требуют по одному обращению к
+ * распределителю памяти.
+ *
  * @return Функция s21_create_matrix вернет либо INCORRECT_MATRIX, если входные
  * параметры недействительны (строки или столбцы меньше 1, либо результат равен
- * NULL), либо OK, если создание матрицы прошло успешно.
+ * NULL), либо OK, если создание матрицы прошло успешно, либо CALC_ERROR, если
+ * размер блока не помещается в size_t или память не выделена.
  */
 int s21_create_matrix(int rows, int columns, matrix_t *result) {
+  PROBE(PROBE_CREATE_MATRIX);
   if ((rows < 1 || columns < 1) || (result == NULL)) {
     return INCORRECT_MATRIX;
   }
 
-  double **matrix = calloc(rows, sizeof(double *));
-
+  size_t header = sizeof(double *) * rows;
+  header = (header + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN;
+  if ((size_t)columns > SIZE_MAX / sizeof(double) / rows ||
+      sizeof(double) * rows * columns > SIZE_MAX - header - MATRIX_ALIGN) {
+    return CALC_ERROR;
+  }
+  size_t data = sizeof(double) * rows * columns;
+  size_t total = header + data;
+  total = (total + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN;
+  double **matrix = aligned_alloc(MATRIX_ALIGN, total);
+  if (matrix == NULL) return CALC_ERROR;
+  PROBE_BYTES(total);
+
+  double *block = (double *)((char *)matrix + header);
+  memset(block, 0, data);
   for (int i = 0; i < rows; i++) {
-    matrix[i] = calloc(columns, sizeof(double));
+    matrix[i] = block + (size_t)i * columns;
   }
 
   result->matrix = matrix;
@@ -49,7 +72,8 @@ int s21_create_matrix(int rows, int columns, matrix_t *result) {
  * @param A Параметр «A» является указателем на структуру типа «matrix_t».
  * Структура matrix_t, скорее всего, содержит информацию о матрице, такую как
  * количество строк, столбцов и сами данные матрицы. Функция `s21_remove_matrix`
- * предназначена для освобождения выделенной памяти.
+ * предназначена для освобождения выделенной памяти. Поскольку матрица
+ * хранится одним блоком, освобождение выполняется одним вызовом free.
  *
  * @return В предоставленном фрагменте кода функция `s21_remove_matrix` является
  * пустой функцией, что означает, что она не возвращает никакого значения явно.
@@ -61,14 +85,29 @@ int s21_create_matrix(int rows, int columns, matrix_t *result) {
 void s21_remove_matrix(matrix_t *A) {
   if (!A) return;
   if (A->matrix) {
-    for (int i = 0; i < A->rows; i++) {
-      free(A->matrix[i]);
-    }
     free(A->matrix);
     A->matrix = NULL;
   }
 }
 
+/**
+ * Функция matrix_data возвращает указатель на элементы матрицы как на плоский
+ * массив из rows * columns значений, если строки матрицы лежат в памяти подряд
+ * (так устроены все матрицы, созданные s21_create_matrix).
+ *
+ * @param M Указатель на корректную матрицу.
+ *
+ * @return Указатель на первый элемент матрицы или NULL, если строки матрицы
+ * расположены в памяти не подряд.
+ */
+double *matrix_data(matrix_t *M) {
+  double *data = M->matrix[0];
+  for (int i = 1; i < M->rows && data != NULL; i++) {
+    if (M->matrix[i] != data + (size_t)i * M->columns) data = NULL;
+  }
+  return data;
+}
+
 /**
  * Функция `s21_eq_matrix` сравнивает две матрицы на предмет равенства в
  * пределах указанного допуска и возвращает статус успеха или неудачи.
@@ -153,6 +192,103 @@ int calc_errors(matrix_t *A, matrix_t *B, matrix_t *result) {
 
   return code;
 }
+
+/**
+ * Функция check_output проверяет, что матрица, переданная для записи
+ * результата, уже создана и имеет ожидаемый размер.
+ *
+ * @param result Матрица для записи результата.
+ * @param rows Ожидаемое количество строк.
+ * @param columns Ожидаемое количество столбцов.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если матрица неверна, или `CALC_ERROR`,
+ * если её размер не совпадает с ожидаемым.
+ */
+int check_output(matrix_t *result, int rows, int columns) {
+  int code = is_correct_matrix(result);
+  if (code == OK && (result->rows != rows || result->columns != columns)) {
+    code = CALC_ERROR;
+  }
+  return code;
+}
+
+static void row_span(const matrix_t *M, const double **low,
+                     const double **high) {
+  *low = M->matrix[0];
+  *high = M->matrix[0] + M->columns;
+  for (int i = 1; i < M->rows; i++) {
+    if (M->matrix[i] < *low) *low = M->matrix[i];
+    if (M->matrix[i] + M->columns > *high) *high = M->matrix[i] + M->columns;
+  }
+}
+
+/**
+ * Функция matrices_overlap сообщает, пересекаются ли в памяти элементы матриц
+ * X и Y, например двух блоков одной матрицы, полученных s21_view_as_matrix.
+ * Сначала сравниваются границы занятой памяти; если они пересекаются,
+ * сравниваются все пары строк, так что соседние блоки одной матрицы (строки
+ * которых чередуются в памяти) не считаются пересекающимися.
+ */
+static int matrices_overlap(const matrix_t *X, const matrix_t *Y) {
+  const double *x_low, *x_high, *y_low, *y_high;
+  row_span(X, &x_low, &x_high);
+  row_span(Y, &y_low, &y_high);
+  if (x_high <= y_low || y_high <= x_low) return 0;
+  int overlap = 0;
+  for (int i = 0; i < X->rows && !overlap; i++) {
+    for (int j = 0; j < Y->rows && !overlap; j++) {
+      overlap = X->matrix[i] < Y->matrix[j] + Y->columns &&
+                Y->matrix[j] < X->matrix[i] + X->columns;
+    }
+  }
+  return overlap;
+}
+
+/**
+ * Функция apply_binary применяет поэлементное векторное ядро (simd_add или
+ * simd_sub) к матрицам одинакового размера. Если все три матрицы хранятся
+ * непрерывно, ядро вызывается один раз для всего блока, иначе — для каждой
+ * строки.
+ *
+ * @return `OK` или `CALC_ERROR`, если в результате есть бесконечность или NaN.
+ */
+static int apply_binary(int (*kernel)(const double *, const double *,
+                                      double *, size_t),
+                        matrix_t *A, matrix_t *B, matrix_t *result) {
+  int bad = 0;
+  double *a = matrix_data(A);
+  double *b = matrix_data(B);
+  double *r = matrix_data(result);
+  if (a != NULL && b != NULL && r != NULL) {
+    bad = kernel(a, b, r, (size_t)A->rows * A->columns);
+  } else {
+    for (int i = 0; i < A->rows; i++) {
+      bad |= kernel(A->matrix[i], B->matrix[i], result->matrix[i], A->columns);
+    }
+  }
+  return bad ? CALC_ERROR : OK;
+}
+
+/**
+ * Функция apply_scale умножает элементы матрицы A на число, записывая
+ * результат в result, по тем же правилам, что и apply_binary.
+ *
+ * @return `OK` или `CALC_ERROR`, если в результате есть бесконечность или NaN.
+ */
+static int apply_scale(matrix_t *A, double number, matrix_t *result) {
+  int bad = 0;
+  double *a = matrix_data(A);
+  double *r = matrix_data(result);
+  if (a != NULL && r != NULL) {
+    bad = simd_scale(a, number, r, (size_t)A->rows * A->columns);
+  } else {
+    for (int i = 0; i < A->rows; i++) {
+      bad |= simd_scale(A->matrix[i], number, result->matrix[i], A->columns);
+    }
+  }
+  return bad ? CALC_ERROR : OK;
+}
+
 /**
  * Функция s21_sub_matrix поэлементно вычитает две матрицы A и B и сохраняет
  * результат в новой матрице result, обрабатывая случаи ошибок, связанные с
@@ -176,23 +312,46 @@ int calc_errors(matrix_t *A, matrix_t *B, matrix_t *result) {
  * ошибок, либо `CALC_ERROR`, если во время операции возникли какие-либо ошибки.
  */
 int s21_sub_matrix(matrix_t *A, matrix_t *B, matrix_t *result) {
+  PROBE(PROBE_SUB_MATRIX);
   int res = calc_errors(A, B, result);
   if (res != OK) {
     return res;
   }
+  PROBE_FLOPS((double)A->rows * A->columns);
 
   res = s21_create_matrix(A->rows, A->columns, result);
+  if (res == OK) res = apply_binary(simd_sub, A, B, result);
+  return res;
+}
 
-  for (int i = 0; i < A->rows && res == OK; i++) {
-    for (int j = 0; j < A->columns && res == OK; j++) {
-      result->matrix[i][j] = A->matrix[i][j] - B->matrix[i][j];
-      if (isinf(result->matrix[i][j]) || isnan(result->matrix[i][j])) {
-        res = CALC_ERROR;
-      }
-    }
+/**
+ * Функция s21_sub_matrix_into вычитает матрицы так же, как s21_sub_matrix, но
+ * записывает результат в уже созданную матрицу result того же размера, не
+ * выделяя память. result может совпадать с A или B.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одна из матриц неверна, или
+ * `CALC_ERROR`, если размеры не совпадают либо в результате появилась
+ * бесконечность или NaN.
+ */
+int s21_sub_matrix_into(matrix_t *A, matrix_t *B, matrix_t *result) {
+  PROBE(PROBE_SUB_MATRIX);
+  int res = calc_errors(A, B, result);
+  if (res == OK) res = check_output(result, A->rows, A->columns);
+  if (res == OK) {
+    PROBE_FLOPS((double)A->rows * A->columns);
+    res = apply_binary(simd_sub, A, B, result);
   }
   return res;
 }
+
+/**
+ * Функция s21_sub_matrix_inplace выполняет A -= B без выделения памяти.
+ *
+ * @return Коды ошибок такие же, как у s21_sub_matrix_into.
+ */
+int s21_sub_matrix_inplace(matrix_t *A, matrix_t *B) {
+  return s21_sub_matrix_into(A, B, A);
+}
 /**
  * Функция `s21_sum_matrix` вычисляет сумму соответствующих элементов в двух
  * матрицах и сохраняет результат в третьей матрице.
@@ -207,29 +366,51 @@ int s21_sub_matrix(matrix_t *A, matrix_t *B, matrix_t *result) {
  * результат в матрице `result`.
  *
  * @return Функция `s21_sum_matrix` возвращает целочисленное значение. Если
- * вычисление прошло успешно, оно возвращает «ОК». Если во время вычислений
- * возникают какие-либо ошибки, например несовместимые размеры матриц или
- * проблемы с созданием результирующей матрицы, возвращается COMPUTATION_ERROR.
+ * вычисление прошло успешно, оно возвращает «ОК». Если входные матрицы неверны
+ * или result равен NULL, возвращается INCORRECT_MATRIX. Если размеры матриц
+ * несовместимы или в результате появилась бесконечность либо NaN,
+ * возвращается CALC_ERROR.
  */
 int s21_sum_matrix(matrix_t *A, matrix_t *B, matrix_t *result) {
-  int rows = A->rows;
-  int columns = A->columns;
-
-  if (rows != B->rows || columns != B->columns) {
-    return COMPUTATION_ERROR;  // Несовместимые размеры матриц
+  PROBE(PROBE_SUM_MATRIX);
+  int res = calc_errors(A, B, result);
+  if (res != OK) {
+    return res;
   }
+  PROBE_FLOPS((double)A->rows * A->columns);
 
-  if (s21_create_matrix(rows, columns, result) != OK) {
-    return COMPUTATION_ERROR;  // Ошибка создания матрицы
-  }
+  res = s21_create_matrix(A->rows, A->columns, result);
+  if (res == OK) res = apply_binary(simd_add, A, B, result);
+  return res;
+}
 
-  for (int i = 0; i < rows; i++) {
-    for (int j = 0; j < columns; j++) {
-      result->matrix[i][j] = A->matrix[i][j] + B->matrix[i][j];
-    }
+/**
+ * Функция s21_sum_matrix_into складывает матрицы так же, как s21_sum_matrix,
+ * но записывает результат в уже созданную матрицу result того же размера, не
+ * выделяя память. result может совпадать с A или B.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одна из матриц неверна, или
+ * `CALC_ERROR`, если размеры не совпадают либо в результате появилась
+ * бесконечность или NaN.
+ */
+int s21_sum_matrix_into(matrix_t *A, matrix_t *B, matrix_t *result) {
+  PROBE(PROBE_SUM_MATRIX);
+  int res = calc_errors(A, B, result);
+  if (res == OK) res = check_output(result, A->rows, A->columns);
+  if (res == OK) {
+    PROBE_FLOPS((double)A->rows * A->columns);
+    res = apply_binary(simd_add, A, B, result);
   }
+  return res;
+}
 
-  return OK;
+/**
+ * Функция s21_sum_matrix_inplace выполняет A += B без выделения памяти.
+ *
+ * @return Коды ошибок такие же, как у s21_sum_matrix_into.
+ */
+int s21_sum_matrix_inplace(matrix_t *A, matrix_t *B) {
+  return s21_sum_matrix_into(A, B, A);
 }
 
 /**
@@ -250,20 +431,77 @@ int s21_sum_matrix(matrix_t *A, matrix_t *B, matrix_t *result) {
  * матрица «A» неверна или если матрица «результата» равна NULL, она вернет код
  * ошибки «INCORRECT_MATRIX». В противном случае он вернет результат функции
  * s21_create_matrix, которая используется для создания новой матрицы для
- * операции умножения.
+ * операции умножения, либо CALC_ERROR, если в результате появилась
+ * бесконечность или NaN.
  */
 int s21_mult_number(matrix_t *A, double number, matrix_t *result) {
+  PROBE(PROBE_MULT_NUMBER);
   int res = OK;
   if (is_correct_matrix(A) != OK || result == NULL) {
     return INCORRECT_MATRIX;
   }
+  PROBE_FLOPS((double)A->rows * A->columns);
 
   res = s21_create_matrix(A->rows, A->columns, result);
+  if (res == OK) res = apply_scale(A, number, result);
+  return res;
+}
+
+/**
+ * Функция s21_mult_number_into умножает матрицу на число так же, как
+ * s21_mult_number, но записывает результат в уже созданную матрицу result того
+ * же размера. result может совпадать с A.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одна из матриц неверна, или
+ * `CALC_ERROR`, если размеры не совпадают либо в результате появилась
+ * бесконечность или NaN.
+ */
+int s21_mult_number_into(matrix_t *A, double number, matrix_t *result) {
+  PROBE(PROBE_MULT_NUMBER);
+  int res = is_correct_matrix(A);
+  if (res == OK) res = check_output(result, A->rows, A->columns);
+  if (res == OK) {
+    PROBE_FLOPS((double)A->rows * A->columns);
+    res = apply_scale(A, number, result);
+  }
+  return res;
+}
+
+/**
+ * Функция s21_mult_number_inplace выполняет A *= number без выделения памяти.
+ *
+ * @return Коды ошибок такие же, как у s21_mult_number_into.
+ */
+int s21_mult_number_inplace(matrix_t *A, double number) {
+  return s21_mult_number_into(A, number, A);
+}
 
-  for (int i = 0; i < A->rows; i++) {
-    for (int j = 0; j < A->columns; j++) {
-      result->matrix[i][j] = A->matrix[i][j] * number;
+/**
+ * Функция product_kernel записывает в result (уже созданную матрицу нужного
+ * размера) произведение A * B, выбирая ядро по форме операндов: квадратные
+ * матрицы порядка не меньше s21_get_strassen_crossover умножает
+ * strassen_kernel, произведение на столбец и строку на матрицу — gemv_kernel и
+ * gemv_t_kernel, остальные — блочный gemm_kernel. zeroed сообщает, что result
+ * уже заполнена нулями и её не нужно очищать перед gemm_kernel.
+ */
+static int product_kernel(matrix_t *A, matrix_t *B, matrix_t *result,
+                          int zeroed) {
+  double *column = B->columns == 1 ? matrix_data(B) : NULL;
+  double *y = column != NULL ? matrix_data(result) : NULL;
+  int res = OK;
+  if (use_strassen(A->rows, B->columns, A->columns)) {
+    res = strassen_kernel(A->rows, A->matrix, B->matrix, result->matrix);
+  } else if (y != NULL) {
+    res = gemv_kernel(A->rows, A->columns, A->matrix, column, y);
+  } else if (A->rows == 1) {
+    res = gemv_t_kernel(B->rows, B->columns, B->matrix, A->matrix[0],
+                        result->matrix[0]);
+  } else {
+    for (int i = 0; i < result->rows && !zeroed; i++) {
+      memset(result->matrix[i], 0, sizeof(double) * result->columns);
     }
+    res = gemm_kernel(A->rows, B->columns, A->columns, A->matrix, B->matrix,
+                      result->matrix);
   }
   return res;
 }
@@ -290,8 +528,11 @@ int s21_mult_number(matrix_t *A, double number, matrix_t *result) {
  * результирующая матрица равна NULL.
  * - `CALC_ERROR`, если размеры входных матриц не подходят для умножения матриц,
  * или если есть
+ *
+ * Само умножение выполняет product_kernel.
  */
 int s21_mult_matrix(matrix_t *A, matrix_t *B, matrix_t *result) {
+  PROBE(PROBE_MULT_MATRIX);
   int res = OK;
   if (is_correct_matrix(A) != OK || is_correct_matrix(B) != OK ||
       result == NULL) {
@@ -299,18 +540,54 @@ int s21_mult_matrix(matrix_t *A, matrix_t *B, matrix_t *result) {
   } else if (A->columns != B->rows) {
     return CALC_ERROR;
   }
+  PROBE_FLOPS(2.0 * A->rows * B->columns * A->columns);
 
   res = s21_create_matrix(A->rows, B->columns, result);
+  if (res == OK) res = product_kernel(A, B, result, 1);
+  return res;
+}
 
-  for (int i = 0; i < A->rows && res == OK; i++) {
-    for (int j = 0; j < B->columns && res == OK; j++) {
-      for (int k = 0; k < A->columns && res == OK; k++) {
-        result->matrix[i][j] += A->matrix[i][k] * B->matrix[k][j];
-        if (isinf(result->matrix[i][j]) || isnan(result->matrix[i][j])) {
-          res = CALC_ERROR;
-        }
-      }
-    }
+/**
+ * Функция s21_mult_matrix_into перемножает матрицы так же, как
+ * s21_mult_matrix, но записывает результат в уже созданную матрицу result
+ * размером A->rows x B->columns. Предыдущее содержимое result
+ * перезаписывается. result не может пересекаться в памяти с A или B.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одна из матриц неверна, или
+ * `CALC_ERROR`, если размеры не подходят для умножения, result пересекается с
+ * одним из аргументов либо в результате появилась бесконечность или NaN.
+ */
+int s21_mult_matrix_into(matrix_t *A, matrix_t *B, matrix_t *result) {
+  PROBE(PROBE_MULT_MATRIX);
+  if (is_correct_matrix(A) != OK || is_correct_matrix(B) != OK) {
+    return INCORRECT_MATRIX;
+  } else if (A->columns != B->rows) {
+    return CALC_ERROR;
+  }
+
+  int res = check_output(result, A->rows, B->columns);
+  if (res == OK &&
+      (matrices_overlap(result, A) || matrices_overlap(result, B))) {
+    res = CALC_ERROR;
+  }
+  if (res == OK) {
+    PROBE_FLOPS(2.0 * A->rows * B->columns * A->columns);
+    res = product_kernel(A, B, result, 0);
+  }
+  return res;
+}
+
+/**
+ * Функция transpose_single обрабатывает матрицу 1x1, для которой
+ * s21_transpose исторически возвращает обратное число 1 / x, а для нуля — код
+ * 2. Особый случай вынесен отдельно, чтобы не проверять его в общем пути.
+ */
+static int transpose_single(matrix_t *A, matrix_t *result) {
+  int res = s21_create_matrix(1, 1, result);
+  if (res == OK && A->matrix[0][0] != 0) {
+    result->matrix[0][0] = 1 / A->matrix[0][0];
+  } else if (res == OK) {
+    res = 2;
   }
   return res;
 }
@@ -333,33 +610,65 @@ int s21_mult_matrix(matrix_t *A, matrix_t *B, matrix_t *result) {
  * - `2`, если в функции было выполнено определенное условие
  */
 int s21_transpose(matrix_t *A, matrix_t *result) {
-  int res = OK;
-  if (is_correct_matrix(A) != OK || result == NULL) res = INCORRECT_MATRIX;
+  PROBE(PROBE_TRANSPOSE);
+  if (is_correct_matrix(A) != OK || result == NULL) return INCORRECT_MATRIX;
 
-  res = s21_create_matrix(A->columns, A->rows, result);
+  if (A->rows == 1 && A->columns == 1) return transpose_single(A, result);
 
+  int res = s21_create_matrix(A->columns, A->rows, result);
   if (res == OK) {
-    for (int i = 0; i < A->rows; i++) {
-      for (int j = 0; j < A->columns; j++) {
-        result->matrix[j][i] = A->matrix[i][j];
-      }
-    }
-  }
-  if ((A->columns == A->rows) && A->rows == 1) {
-    if (result->matrix[0][0] != 0) {
-      result->matrix[0][0] = 1 / result->matrix[0][0];
-    } else {
-      res = 2;
-    }
+    transpose_blocked(A->matrix, 0, 0, A->rows, A->columns, result->matrix);
   }
+  return res;
+}
+
+/**
+ * Функция s21_transpose_into записывает транспонированную матрицу A в уже
+ * созданную матрицу result размером A->columns x A->rows. В отличие от
+ * s21_transpose, матрица 1x1 копируется без изменений. result не может
+ * пересекаться в памяти с A; для транспонирования на месте есть
+ * s21_transpose_inplace.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одна из матриц неверна, или
+ * `CALC_ERROR`, если размер result не подходит или result пересекается с A.
+ */
+int s21_transpose_into(matrix_t *A, matrix_t *result) {
+  PROBE(PROBE_TRANSPOSE);
+  if (is_correct_matrix(A) != OK) return INCORRECT_MATRIX;
 
+  int res = check_output(result, A->columns, A->rows);
+  if (res == OK && matrices_overlap(result, A)) res = CALC_ERROR;
+  if (res == OK) {
+    transpose_blocked(A->matrix, 0, 0, A->rows, A->columns, result->matrix);
+  }
   return res;
 }
 
+/**
+ * Функция s21_transpose_inplace транспонирует квадратную матрицу на месте,
+ * меняя местами симметричные блоки через буфер размером в один блок.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если матрица неверна, или `CALC_ERROR`,
+ * если матрица не квадратная.
+ */
+int s21_transpose_inplace(matrix_t *A) {
+  PROBE(PROBE_TRANSPOSE);
+  if (is_correct_matrix(A) != OK) return INCORRECT_MATRIX;
+  if (A->rows != A->columns) return CALC_ERROR;
+
+  transpose_square(A->matrix, A->rows);
+  return OK;
+}
+
 /**
  * Функция `s21_calc_complements` вычисляет матрицу сомножителей для заданной
  * квадратной матрицы.
  *
+ * Матрицы порядка не выше SMALL_MAX_ORDER обрабатываются развёрнутыми
+ * формулами (small_complements), большие — через одно LU-разложение
+ * (lu_complements). Для вырожденной матрицы дополнения считаются по минорам,
+ * строки которых распределяются по пулу потоков.
+ *
  * @param A Функция s21_calc_complements принимает в качестве параметров два
  * указателя матрицы: A и result. Матрица «А» имеет тип «matrix_t» и
  * используется для вычислений, а матрица «результат» также имеет тип «matrix_t»
@@ -374,27 +683,17 @@ int s21_transpose(matrix_t *A, matrix_t *result) {
  * функции s21_create_matrix.
  */
 int s21_calc_complements(matrix_t *A, matrix_t *result) {
+  PROBE(PROBE_CALC_COMPLEMENTS);
   if (is_correct_matrix(A) != OK || result == NULL) return INCORRECT_MATRIX;
   if (A->columns != A->rows) return CALC_ERROR;
+  PROBE_FLOPS(8.0 / 3 * A->rows * A->rows * A->rows);
 
   int res = 2;
-  if ((A->rows == A->columns) && (A->rows > 1)) {
-    res = s21_create_matrix(A->columns, A->rows, result);
-    if (A->rows != 1) {
-      matrix_t local = {0};
-
-      s21_create_matrix(A->rows, A->rows, &local);
-      for (int i = 0, x = 0; x < A->rows; x += 1) {
-        for (int j = 0; j < A->columns; j += 1) {
-          get_minor(A->matrix, local.matrix, x, j, A->rows);
-          i = ((x + j) % 2 == 0) ? 1 : (-1);
-          result->matrix[x][j] = i * get_determinant(&local, A->rows - 1);
-        }
-      }
-      s21_remove_matrix(&local);
-    } else {
-      result->matrix[0][0] = 1;
-    }
+  if (A->rows > 1 && A->rows <= SMALL_MAX_ORDER) {
+    res = s21_create_matrix(A->rows, A->rows, result);
+    if (res == OK) small_complements(A->matrix, A->rows, result->matrix);
+  } else if (A->rows > 1) {
+    res = lu_complements(A, result);
   }
   return res;
 }
@@ -409,89 +708,41 @@ int s21_calc_complements(matrix_t *A, matrix_t *result) {
  * на двойное значение. Этот указатель используется для хранения результата
  * вычисления определителя, выполненного внутри функции.
  *
+ * Матрицы порядка не выше SMALL_MAX_ORDER считаются по развёрнутым формулам
+ * (small_determinant), матрицы большего порядка — через LU-разложение
+ * (lu_determinant).
+ *
  * @return Функция `s21_determinant` вернет одно из следующих значений:
  * - INCORRECT_MATRIX, если входная матрица неверна или указатель результата
  * равен NULL.
- * - `CALC_ERROR`, если количество столбцов не равно количеству строк в матрице
+ * - `CALC_ERROR`, если количество столбцов не равно количеству строк в матрице,
+ * либо если в LU-разложении большой матрицы не удалось выделить буфер или
+ * появилась бесконечность или NaN
  * - `OK`, если вычисление определителя прошло успешно
  */
 int s21_determinant(matrix_t *A, double *result) {
+  PROBE(PROBE_DETERMINANT);
   if (is_correct_matrix(A) != OK || result == NULL) return INCORRECT_MATRIX;
   if (A->columns != A->rows) return CALC_ERROR;
+  PROBE_FLOPS(2.0 / 3 * A->rows * A->rows * A->rows);
+  int res = OK;
   if (A->rows == 1)
     *result = A->matrix[0][0];
+  else if (A->rows <= SMALL_MAX_ORDER)
+    *result = small_determinant(A->matrix, A->rows);
   else
-    *result = get_determinant(A, A->rows);
-  return OK;
-}
-
-/**
- * Функция вычисляет определитель матрицы, используя рекурсию и миноры.
- *
- * @param A Функция get_determinant вычисляет определитель квадратной матрицы.
- * Параметр «A» является указателем на структуру «matrix_t», которая содержит
- * данные матрицы. Данные матрицы хранятся в двумерном массиве «matrix» внутри
- * структуры «matrix_t».
- * @param size Параметр size в функции get_determinant представляет размер
- * квадратной матрицы, для которой вы хотите вычислить определитель. Это
- * целочисленное значение, указывающее количество строк или столбцов в
- * квадратной матрице.
- *
- * @return определитель матрицы, представленный входными данными `matrix_t *A`
- * размера `size`.
- */
-double get_determinant(matrix_t *A, int size) {
-  if (size == 1) return A->matrix[0][0];
-
-  matrix_t local = {0};
-  double result = 0;
-
-  s21_create_matrix(size, size, &local);
-  for (int i = 1, j = 0; j < size; j += 1, i *= (-1)) {
-    get_minor(A->matrix, local.matrix, 0, j, size);
-    result += i * A->matrix[0][j] * get_determinant(&local, size - 1);
-  }
-
-  s21_remove_matrix(&local);
-  return result;
-}
-
-/**
- * Функция get_minor извлекает второстепенную матрицу из заданной матрицы,
- * исключая указанную строку и столбец.
- *
- * @param A A — указатель на двумерный массив типа double.
- * @param local Параметр local — это указатель на двумерный массив типа double.
- * Он представляет собой матрицу, в которой будет храниться второстепенная
- * матрица после ее извлечения из исходной матрицы `A`.
- * @param new_row Параметр new_row в функции get_minor представляет индекс
- * строки элемента, для которого вы хотите найти минор в матрице A. Функция
- * создаст новую матрицу «local», которая является младшей по отношению к
- * матрице «A», исключив строку «new_row».
- * @param new_col Параметр new_col в функции get_minor представляет индекс
- * столбца элемента, для которого вы хотите найти минор матрицы A. Минор матрицы
- * получается путем удаления строки и столбца, содержащих этот элемент.
- * @param size Параметр size в функции get_minor представляет размер квадратной
- * матрицы A. Он указывает количество строк и столбцов в матрице, поскольку это
- * квадратная матрица.
- */
-void get_minor(double **A, double **local, int new_row, int new_col, int size) {
-  for (int row = 0, x = 0; row < size; row += 1) {
-    for (int col = 0, y = 0; col < size; col += 1) {
-      if (row != new_row && col != new_col) {
-        local[x][y++] = A[row][col];
-        if (y == size - 1) {
-          y = 0;
-          x++;
-        }
-      }
-    }
-  }
+    res = lu_determinant(A, result);
+  return res;
 }
 
 /**
  * Функция `s21_inverse_matrix` вычисляет обратную матрицу, если она существует.
  *
+ * Матрицы порядка не выше SMALL_MAX_ORDER обращаются по развёрнутым формулам
+ * (small_inverse), остальные — через одно LU-разложение (lu_inverse), которое
+ * записывает результат прямо в result, без вычисления матрицы алгебраических
+ * дополнений.
+ *
  * @param A A — указатель на матричную структуру, представляющую входную
  * матрицу, для которой необходимо вычислить обратную матрицу.
  * @param result Параметр result в функции s21_inverse_matrix является
@@ -505,34 +756,15 @@ void get_minor(double **A, double **local, int new_row, int new_col, int size) {
  * - `CALC_ERROR` если при расчете произошла ошибка
  */
 int s21_inverse_matrix(matrix_t *A, matrix_t *result) {
+  PROBE(PROBE_INVERSE_MATRIX);
   if (is_correct_matrix(A) != OK || result == NULL) return INCORRECT_MATRIX;
   if (A->columns != A->rows) return CALC_ERROR;
+  PROBE_FLOPS(8.0 / 3 * A->rows * A->rows * A->rows);
+  if (A->rows == 1 || A->rows > SMALL_MAX_ORDER) return lu_inverse(A, result);
 
-  double det = 0;
-  int res = OK;
-  res = s21_determinant(A, &det);
-
-  if (res == OK && det == 0) {
-    res = CALC_ERROR;
-  }
-  if (res == OK && A->rows == 1) {
-    res = s21_create_matrix(A->rows, A->columns, result);
-    result->matrix[0][0] = 1 / A->matrix[0][0];
-  } else if (res == OK) {
-    matrix_t first = {0};
-    matrix_t second = {0};
-    res = s21_calc_complements(A, &first);
-    if (res == OK) {
-      res = s21_transpose(&first, &second);
-    }
-    if (res == OK) {
-      res = s21_mult_number(&second, 1 / det, result);
-    }
-
-    s21_remove_matrix(&first);
-    s21_remove_matrix(&second);
-  }
-
+  int res = s21_create_matrix(A->rows, A->rows, result);
+  if (res == OK) res = small_inverse(A->matrix, A->rows, result->matrix);
+  if (res != OK) s21_remove_matrix(result);
   return res;
 }
 
@@ -1,10 +1,18 @@
 #ifndef SRC_S21_MATRIX_H_
 #define SRC_S21_MATRIX_H_
 #include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
 
 #define SUCCESS 1
 #define FAILURE 0
+#define POOL_MAX_THREADS 256
+#define POOL_DEFAULT_THRESHOLD 2097152.0
+#define STRASSEN_DEFAULT_CROSSOVER 2048
+#define EXPR_MAX_NODES 32
+#define EXPR_MAX_DEPTH 8
+#define BATCH_MAX_ORDER 8
+#define STATS_BUCKETS 32
 typedef struct matrix_struct {
   double **matrix;
   int rows;
@@ -13,20 +21,301 @@ typedef struct matrix_struct {
 
 typedef enum code_result { OK, INCORRECT_MATRIX, CALC_ERROR } code_result;
 
+typedef struct arena_block arena_block;
+
+typedef struct arena_struct {
+  arena_block *first;
+  arena_block *current;
+  size_t block_size;
+} arena_t;
+
+typedef struct arena_mark_struct {
+  arena_block *block;
+  size_t used;
+} arena_mark_t;
+
+typedef enum expr_op {
+  EXPR_LOAD,
+  EXPR_ADD,
+  EXPR_SUB,
+  EXPR_MUL,
+  EXPR_SCALE
+} expr_op;
+
+typedef struct expr_node {
+  expr_op op;
+  matrix_t *source;
+  double number;
+} expr_node;
+
+typedef struct expr_struct {
+  expr_node nodes[EXPR_MAX_NODES];
+  int count;
+  int depth;
+  int rows;
+  int columns;
+  int status;
+} s21_expr_t;
+
+typedef struct batch_struct {
+  double *data;
+  int rows;
+  int columns;
+  int count;
+  int stride;
+} s21_batch_t;
+
+typedef enum factor_kind {
+  FACTOR_LU,
+  FACTOR_CHOLESKY,
+  FACTOR_QR
+} factor_kind;
+
+typedef struct factor_struct {
+  factor_kind kind;
+  double *data;
+  double *tau;
+  int *pivots;
+  int rows;
+  int columns;
+  int sign;
+  int rank;
+  double determinant;
+} s21_factor_t;
+
+typedef enum sparse_format { SPARSE_CSR, SPARSE_CSC } sparse_format;
+
+typedef struct sparse_struct {
+  sparse_format format;
+  int rows;
+  int columns;
+  size_t nonzeros;
+  size_t *offsets;
+  int *indices;
+  double *values;
+} s21_sparse_t;
+
+typedef struct matrix_f32_struct {
+  float **matrix;
+  int rows;
+  int columns;
+} matrix_f32_t;
+
+typedef struct view_struct {
+  double *base;
+  ptrdiff_t offset;
+  int rows;
+  int columns;
+  ptrdiff_t row_stride;
+  ptrdiff_t column_stride;
+} s21_view_t;
+
+typedef enum structure_kind {
+  STRUCTURE_SYMMETRIC,
+  STRUCTURE_LOWER,
+  STRUCTURE_UPPER,
+  STRUCTURE_BANDED
+} structure_kind;
+
+typedef struct structured_struct {
+  structure_kind kind;
+  double *data;
+  int size;
+  int lower;
+  int upper;
+} s21_structured_t;
+
+typedef struct vector_struct {
+  double *data;
+  int size;
+} vector_t;
+
+typedef enum s21_probe {
+  PROBE_CREATE_MATRIX,
+  PROBE_SUM_MATRIX,
+  PROBE_SUB_MATRIX,
+  PROBE_MULT_NUMBER,
+  PROBE_MULT_MATRIX,
+  PROBE_TRANSPOSE,
+  PROBE_DETERMINANT,
+  PROBE_CALC_COMPLEMENTS,
+  PROBE_INVERSE_MATRIX,
+  PROBE_SOLVE,
+  PROBE_COUNT
+} s21_probe;
+
+typedef enum s21_trace_event { TRACE_BEGIN, TRACE_END } s21_trace_event;
+
+typedef void (*s21_trace_hook)(s21_probe probe, s21_trace_event event,
+                               void *user);
+
+typedef struct stats_struct {
+  unsigned long long calls;
+  unsigned long long total_ns;
+  unsigned long long max_ns;
+  unsigned long long bytes;
+  unsigned long long flops;
+  unsigned long long histogram[STATS_BUCKETS];
+} s21_stats_t;
+
 int s21_create_matrix(int rows, int columns, matrix_t *result);
 void s21_remove_matrix(matrix_t *A);
 int s21_eq_matrix(matrix_t *A, matrix_t *B);
 int is_correct_matrix(matrix_t *M);
 int calc_errors(matrix_t *A, matrix_t *B, matrix_t *result);
-double get_determinant(matrix_t *A, int size);
-void get_minor(double **A, double **local, int new_row, int new_col, int size);
+void s21_set_num_threads(int threads);
+int s21_get_num_threads(void);
+void s21_set_parallel_threshold(double flops);
+void s21_set_strassen_crossover(int order);
+int s21_get_strassen_crossover(void);
 int s21_sum_matrix(matrix_t *A, matrix_t *B, matrix_t *result);
 int s21_sub_matrix(matrix_t *A, matrix_t *B, matrix_t *result);
 int s21_mult_number(matrix_t *A, double number, matrix_t *result);
 int s21_mult_matrix(matrix_t *A, matrix_t *B, matrix_t *result);
 int s21_transpose(matrix_t *A, matrix_t *result);
+int s21_sum_matrix_into(matrix_t *A, matrix_t *B, matrix_t *result);
+int s21_sub_matrix_into(matrix_t *A, matrix_t *B, matrix_t *result);
+int s21_mult_number_into(matrix_t *A, double number, matrix_t *result);
+int s21_mult_matrix_into(matrix_t *A, matrix_t *B, matrix_t *result);
+int s21_transpose_into(matrix_t *A, matrix_t *result);
+int s21_sum_matrix_inplace(matrix_t *A, matrix_t *B);
+int s21_sub_matrix_inplace(matrix_t *A, matrix_t *B);
+int s21_mult_number_inplace(matrix_t *A, double number);
+int s21_transpose_inplace(matrix_t *A);
 int s21_calc_complements(matrix_t *A, matrix_t *result);
 int s21_determinant(matrix_t *A, double *result);
 int s21_inverse_matrix(matrix_t *A, matrix_t *result);
 
+int s21_arena_create(size_t capacity, arena_t *arena);
+void s21_arena_destroy(arena_t *arena);
+void s21_arena_reset(arena_t *arena);
+arena_mark_t s21_arena_mark(arena_t *arena);
+void s21_arena_release(arena_t *arena, arena_mark_t mark);
+int s21_arena_matrix(arena_t *arena, int rows, int columns, matrix_t *result);
+
+void s21_expr_init(s21_expr_t *expr);
+int s21_expr_load(s21_expr_t *expr, matrix_t *A);
+int s21_expr_add(s21_expr_t *expr);
+int s21_expr_sub(s21_expr_t *expr);
+int s21_expr_hadamard(s21_expr_t *expr);
+int s21_expr_scale(s21_expr_t *expr, double number);
+int s21_expr_eval(s21_expr_t *expr, matrix_t *result);
+int s21_expr_eval_into(s21_expr_t *expr, matrix_t *result);
+
+int s21_create_batch(int rows, int columns, int count, s21_batch_t *result);
+void s21_remove_batch(s21_batch_t *batch);
+int s21_batch_pack(const double *src, size_t matrix_stride,
+                   s21_batch_t *batch);
+int s21_batch_unpack(const s21_batch_t *batch, double *dst,
+                     size_t matrix_stride);
+int s21_batch_mult(s21_batch_t *A, s21_batch_t *B, s21_batch_t *result);
+int s21_batch_mult_into(s21_batch_t *A, s21_batch_t *B, s21_batch_t *result);
+int s21_batch_transpose(s21_batch_t *A, s21_batch_t *result);
+int s21_batch_transpose_into(s21_batch_t *A, s21_batch_t *result);
+int s21_batch_determinant(s21_batch_t *A, double *result);
+int s21_batch_inverse(s21_batch_t *A, s21_batch_t *result);
+int s21_batch_inverse_into(s21_batch_t *A, s21_batch_t *result);
+
+int s21_factor_lu(matrix_t *A, s21_factor_t *factor);
+int s21_factor_cholesky(matrix_t *A, s21_factor_t *factor);
+int s21_factor_qr(matrix_t *A, s21_factor_t *factor);
+int s21_factor_determinant(s21_factor_t *factor, double *result);
+int s21_factor_rank(s21_factor_t *factor, int *result);
+int s21_factor_inverse(s21_factor_t *factor, matrix_t *result);
+int s21_factor_solve(s21_factor_t *factor, matrix_t *B, matrix_t *X);
+int s21_factor_solve_into(s21_factor_t *factor, matrix_t *B, matrix_t *X);
+void s21_factor_remove(s21_factor_t *factor);
+int s21_solve(matrix_t *A, matrix_t *B, matrix_t *X);
+
+int s21_create_sparse(int rows, int columns, size_t nonzeros,
+                      sparse_format format, s21_sparse_t *result);
+void s21_remove_sparse(s21_sparse_t *A);
+int s21_sparse_from_dense(matrix_t *A, sparse_format format,
+                          s21_sparse_t *result);
+int s21_sparse_to_dense(s21_sparse_t *A, matrix_t *result);
+int s21_sparse_from_triplets(int rows, int columns, size_t count,
+                             const int *row, const int *column,
+                             const double *value, sparse_format format,
+                             s21_sparse_t *result);
+int s21_sparse_convert(s21_sparse_t *A, sparse_format format,
+                       s21_sparse_t *result);
+int s21_sparse_transpose(s21_sparse_t *A, s21_sparse_t *result);
+int s21_sparse_add(s21_sparse_t *A, s21_sparse_t *B, s21_sparse_t *result);
+int s21_sparse_mult_vector(s21_sparse_t *A, const double *x, double *y);
+int s21_sparse_mult_dense(s21_sparse_t *A, matrix_t *B, matrix_t *result);
+int s21_sparse_mult_dense_into(s21_sparse_t *A, matrix_t *B,
+                               matrix_t *result);
+
+int s21_save_matrix(matrix_t *A, const char *path);
+int s21_load_matrix(const char *path, matrix_t *result);
+int s21_map_matrix(const char *path, matrix_t *result);
+void s21_unmap_matrix(matrix_t *A);
+int s21_mult_matrix_file(const char *a_path, const char *b_path,
+                         const char *result_path, size_t memory_limit);
+
+int s21_create_matrix_f32(int rows, int columns, matrix_f32_t *result);
+void s21_remove_matrix_f32(matrix_f32_t *A);
+int s21_eq_matrix_f32(matrix_f32_t *A, matrix_f32_t *B);
+int s21_matrix_to_f32(matrix_t *A, matrix_f32_t *result);
+int s21_matrix_from_f32(matrix_f32_t *A, matrix_t *result);
+int s21_sum_matrix_f32(matrix_f32_t *A, matrix_f32_t *B,
+                       matrix_f32_t *result);
+int s21_sub_matrix_f32(matrix_f32_t *A, matrix_f32_t *B,
+                       matrix_f32_t *result);
+int s21_mult_number_f32(matrix_f32_t *A, float number, matrix_f32_t *result);
+int s21_mult_matrix_f32(matrix_f32_t *A, matrix_f32_t *B,
+                        matrix_f32_t *result);
+int s21_mult_matrix_f32_mixed(matrix_f32_t *A, matrix_f32_t *B,
+                              matrix_f32_t *result);
+int s21_transpose_f32(matrix_f32_t *A, matrix_f32_t *result);
+int s21_determinant_f32(matrix_f32_t *A, double *result);
+int s21_calc_complements_f32(matrix_f32_t *A, matrix_f32_t *result);
+int s21_inverse_matrix_f32(matrix_f32_t *A, matrix_f32_t *result);
+int s21_solve_mixed(matrix_t *A, matrix_t *B, matrix_t *X);
+
+int s21_stats_snapshot(s21_stats_t *result);
+void s21_stats_reset(void);
+size_t s21_stats_json(char *buffer, size_t size);
+const char *s21_probe_name(s21_probe probe);
+void s21_set_trace_hook(s21_trace_hook hook, void *user);
+
+int s21_view_matrix(matrix_t *A, s21_view_t *result);
+int s21_view_block(const s21_view_t *V, int row, int column, int rows,
+                   int columns, s21_view_t *result);
+int s21_view_row(const s21_view_t *V, int row, s21_view_t *result);
+int s21_view_column(const s21_view_t *V, int column, s21_view_t *result);
+int s21_view_transpose(const s21_view_t *V, s21_view_t *result);
+int s21_view_as_matrix(const s21_view_t *V, arena_t *arena,
+                       matrix_t *result);
+int s21_view_copy(s21_view_t *A, s21_view_t *R);
+int s21_view_sum(s21_view_t *A, s21_view_t *B, s21_view_t *R);
+int s21_view_sub(s21_view_t *A, s21_view_t *B, s21_view_t *R);
+int s21_view_scale(s21_view_t *A, double number, s21_view_t *R);
+int s21_view_mult(s21_view_t *A, s21_view_t *B, s21_view_t *R);
+int s21_view_determinant(s21_view_t *A, double *result);
+
+int s21_create_vector(int size, vector_t *result);
+void s21_remove_vector(vector_t *x);
+int s21_matrix_as_vector(matrix_t *A, vector_t *result);
+int s21_dot(vector_t *x, vector_t *y, double *result);
+int s21_axpy(double a, vector_t *x, vector_t *y);
+int s21_norm1(vector_t *x, double *result);
+int s21_norm2(vector_t *x, double *result);
+int s21_norm_inf(vector_t *x, double *result);
+int s21_gemv(matrix_t *A, vector_t *x, vector_t *y);
+int s21_gemv_t(matrix_t *A, vector_t *x, vector_t *y);
+
+int s21_create_structured(int size, structure_kind kind, int lower, int upper,
+                          s21_structured_t *result);
+void s21_remove_structured(s21_structured_t *S);
+int s21_structured_from_dense(matrix_t *A, structure_kind kind, int lower,
+                              int upper, s21_structured_t *result);
+int s21_structured_to_dense(s21_structured_t *S, matrix_t *result);
+int s21_structured_mult_vector(s21_structured_t *S, vector_t *x,
+                               vector_t *y);
+int s21_structured_mult_dense(s21_structured_t *S, matrix_t *B,
+                              matrix_t *result);
+int s21_structured_solve(s21_structured_t *S, matrix_t *B, matrix_t *X);
+int s21_structured_determinant(s21_structured_t *S, double *result);
+
 #endif  // SRC_S21_MATRIX_H_
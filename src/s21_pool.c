@@ -0,0 +1,180 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+
+#include "s21_internal.h"
+
+typedef struct thread_pool {
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  pthread_cond_t done;
+  pthread_t workers[POOL_MAX_THREADS];
+  int workers_count;
+  int threads;
+  double threshold;
+  unsigned long generation;
+  unsigned long spawn_generation;
+  void (*task)(void *arg, int index);
+  void *arg;
+  int count;
+  int next;
+  int pending;
+  int stop;
+} thread_pool;
+
+static thread_pool pool = {.lock = PTHREAD_MUTEX_INITIALIZER,
+                           .wake = PTHREAD_COND_INITIALIZER,
+                           .done = PTHREAD_COND_INITIALIZER,
+                           .threads = 1,
+                           .threshold = POOL_DEFAULT_THRESHOLD};
+static pthread_mutex_t run_lock = PTHREAD_MUTEX_INITIALIZER;
+static _Thread_local int inside_pool = 0;
+
+/**
+ * Функция run_tasks забирает из текущего задания ещё не выполненные индексы и
+ * выполняет их. Вызывается с захваченным pool.lock, на время выполнения
+ * задачи мьютекс отпускается.
+ */
+static void run_tasks(void) {
+  while (pool.next < pool.count) {
+    int index = pool.next++;
+    pthread_mutex_unlock(&pool.lock);
+    pool.task(pool.arg, index);
+    pthread_mutex_lock(&pool.lock);
+  }
+}
+
+static void *worker_main(void *unused) {
+  (void)unused;
+  inside_pool = 1;
+  pthread_mutex_lock(&pool.lock);
+  unsigned long seen = pool.spawn_generation;
+  while (1) {
+    while (!pool.stop && pool.generation == seen) {
+      pthread_cond_wait(&pool.wake, &pool.lock);
+    }
+    if (pool.stop) break;
+    seen = pool.generation;
+    run_tasks();
+    if (--pool.pending == 0) pthread_cond_signal(&pool.done);
+  }
+  pthread_mutex_unlock(&pool.lock);
+  return NULL;
+}
+
+/**
+ * Функция resize_workers останавливает текущих рабочих и запускает
+ * threads - 1 новых (вызывающий поток участвует в работе сам). Вызывается
+ * только под run_lock.
+ */
+static void resize_workers(int threads) {
+  pthread_mutex_lock(&pool.lock);
+  pool.stop = 1;
+  pthread_cond_broadcast(&pool.wake);
+  pthread_mutex_unlock(&pool.lock);
+  for (int i = 0; i < pool.workers_count; i++) {
+    pthread_join(pool.workers[i], NULL);
+  }
+
+  pthread_mutex_lock(&pool.lock);
+  pool.stop = 0;
+  pool.workers_count = 0;
+  pool.spawn_generation = pool.generation;
+  for (int i = 0; i < threads - 1; i++) {
+    if (pthread_create(&pool.workers[i], NULL, worker_main, NULL) == 0) {
+      pool.workers_count++;
+    }
+  }
+  pthread_mutex_unlock(&pool.lock);
+}
+
+/**
+ * Функция s21_set_num_threads задаёт количество потоков, используемых
+ * параллельными операциями библиотеки. По умолчанию используется один поток,
+ * то есть параллельный режим выключен. Рабочие потоки создаются один раз при
+ * первой параллельной операции и переиспользуются между вызовами.
+ *
+ * @param threads Количество потоков, включая вызывающий. Значения меньше 1
+ * считаются равными 1, больше POOL_MAX_THREADS — равными POOL_MAX_THREADS.
+ */
+void s21_set_num_threads(int threads) {
+  if (threads < 1) threads = 1;
+  if (threads > POOL_MAX_THREADS) threads = POOL_MAX_THREADS;
+  pthread_mutex_lock(&pool.lock);
+  pool.threads = threads;
+  pthread_mutex_unlock(&pool.lock);
+}
+
+/**
+ * Функция s21_get_num_threads возвращает количество потоков, заданное
+ * s21_set_num_threads.
+ */
+int s21_get_num_threads(void) {
+  pthread_mutex_lock(&pool.lock);
+  int threads = pool.threads;
+  pthread_mutex_unlock(&pool.lock);
+  return threads;
+}
+
+/**
+ * Функция s21_set_parallel_threshold задаёт минимальный объём работы
+ * (количество умножений со сложением), начиная с которого операция
+ * распределяется между потоками. Более мелкие операции всегда выполняются в
+ * вызывающем потоке.
+ *
+ * @param flops Порог в операциях; по умолчанию POOL_DEFAULT_THRESHOLD.
+ */
+void s21_set_parallel_threshold(double flops) {
+  pthread_mutex_lock(&pool.lock);
+  pool.threshold = flops < 0 ? 0 : flops;
+  pthread_mutex_unlock(&pool.lock);
+}
+
+/**
+ * Функция pool_threads сообщает, сколько потоков стоит использовать для
+ * операции заданного объёма: 1, если параллельный режим выключен, объём ниже
+ * порога или вызов происходит изнутри задачи пула.
+ */
+int pool_threads(double flops) {
+  if (inside_pool) return 1;
+  pthread_mutex_lock(&pool.lock);
+  int threads = flops < pool.threshold ? 1 : pool.threads;
+  pthread_mutex_unlock(&pool.lock);
+  return threads;
+}
+
+/**
+ * Функция pool_run выполняет task(arg, index) для всех index от 0 до
+ * count - 1 на постоянном пуле потоков и возвращает управление после
+ * завершения всех задач. Если пул уже занят другим вызовом или вызов сделан из
+ * задачи пула, задачи выполняются последовательно в вызывающем потоке.
+ *
+ * @param task Функция задачи.
+ * @param arg Общий аргумент задач.
+ * @param count Количество задач.
+ */
+void pool_run(void (*task)(void *arg, int index), void *arg, int count) {
+  int threads = s21_get_num_threads();
+  if (count <= 1 || threads <= 1 || inside_pool ||
+      pthread_mutex_trylock(&run_lock) != 0) {
+    for (int i = 0; i < count; i++) task(arg, i);
+    return;
+  }
+
+  if (pool.workers_count != threads - 1) resize_workers(threads);
+
+  inside_pool = 1;
+  pthread_mutex_lock(&pool.lock);
+  pool.task = task;
+  pool.arg = arg;
+  pool.count = count;
+  pool.next = 0;
+  pool.pending = pool.workers_count;
+  pool.generation++;
+  pthread_cond_broadcast(&pool.wake);
+  run_tasks();
+  while (pool.pending > 0) pthread_cond_wait(&pool.done, &pool.lock);
+  pthread_mutex_unlock(&pool.lock);
+  inside_pool = 0;
+
+  pthread_mutex_unlock(&run_lock);
+}
@@ -0,0 +1,184 @@
+#include <float.h>
+#include <string.h>
+
+#include "s21_internal.h"
+
+/*
+ * QR-разложение с выбором ведущего столбца: A * P = Q * R. Q хранится как
+ * произведение отражений Хаусхолдера H_k = I - tau_k * v_k * v_k^T, где v_k
+ * лежит под диагональю столбца k (первый элемент v_k равен 1 и не хранится),
+ * R — на диагонали и выше. Ведущим выбирается столбец с наибольшей нормой
+ * остатка, поэтому модули диагональных элементов R не возрастают и по ним
+ * определяется ранг.
+ */
+
+static void swap_columns(double *a, int m, int n, int j, int p) {
+  for (int i = 0; i < m; i++) {
+    double tmp = a[i * n + j];
+    a[i * n + j] = a[i * n + p];
+    a[i * n + p] = tmp;
+  }
+}
+
+static double column_norm2(const double *a, int m, int n, int k, int j) {
+  double sum = 0;
+  for (int i = k; i < m; i++) sum += a[i * n + j] * a[i * n + j];
+  return sum;
+}
+
+/**
+ * Функция householder строит отражение для столбца k, обнуляющее элементы
+ * под диагональю: записывает beta на диагональ, v_k — под неё и возвращает
+ * tau_k (0, если столбец уже нулевой).
+ */
+static double householder(double *a, int m, int n, int k) {
+  double alpha = a[k * n + k];
+  double sigma = column_norm2(a, m, n, k + 1, k);
+  double norm = sqrt(alpha * alpha + sigma);
+  double tau = 0;
+  if (norm != 0) {
+    double beta = alpha > 0 ? -norm : norm;
+    double scale = 1 / (alpha - beta);
+    for (int i = k + 1; i < m; i++) a[i * n + k] *= scale;
+    tau = (beta - alpha) / beta;
+    a[k * n + k] = beta;
+  }
+  return tau;
+}
+
+/**
+ * Функция qr_decompose выполняет QR-разложение матрицы m x n (m >= n) с
+ * выбором ведущего столбца на месте. Отражения применяются к остатку по
+ * строкам: сначала w = v^T * A, затем A -= tau * v * w, так что оба прохода
+ * читают непрерывные строки. Нормы столбцов остатка пересчитываются
+ * вычитанием и вычисляются заново, когда вычитание теряет точность.
+ *
+ * @param a Непрерывный буфер m * n, хранящий матрицу построчно.
+ * @param tau Массив из n коэффициентов отражений.
+ * @param perm Массив из n элементов: perm[j] — исходный номер j-го столбца.
+ * @param sign Указатель, по которому записывается det(Q) * det(P): ±1.
+ *
+ * @return `OK` или `CALC_ERROR`, если не удалось выделить временный буфер.
+ */
+int qr_decompose(double *a, int m, int n, double *tau, int *perm, int *sign) {
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  double *norms = arena_alloc(arena, sizeof(double) * 3 * n);
+  if (norms == NULL) return CALC_ERROR;
+
+  double *exact = norms + n, *w = norms + 2 * n;
+  for (int j = 0; j < n; j++) {
+    perm[j] = j;
+    norms[j] = exact[j] = column_norm2(a, m, n, 0, j);
+  }
+
+  *sign = 1;
+  for (int k = 0; k < n; k++) {
+    int p = k;
+    for (int j = k + 1; j < n; j++) {
+      if (norms[j] > norms[p]) p = j;
+    }
+    if (p != k) {
+      swap_columns(a, m, n, k, p);
+      double tmp = norms[k];
+      norms[k] = norms[p];
+      norms[p] = tmp;
+      tmp = exact[k];
+      exact[k] = exact[p];
+      exact[p] = tmp;
+      int index = perm[k];
+      perm[k] = perm[p];
+      perm[p] = index;
+      *sign = -*sign;
+    }
+
+    tau[k] = householder(a, m, n, k);
+    if (tau[k] != 0) *sign = -*sign;
+    if (tau[k] != 0 && k + 1 < n) {
+      int width = n - k - 1;
+      memcpy(w, a + k * n + k + 1, sizeof(double) * width);
+      for (int i = k + 1; i < m; i++) {
+        double v = a[i * n + k];
+        const double *row = a + i * n + k + 1;
+        for (int j = 0; j < width; j++) w[j] += v * row[j];
+      }
+      for (int j = 0; j < width; j++) w[j] *= tau[k];
+      double *row = a + k * n + k + 1;
+      for (int j = 0; j < width; j++) row[j] -= w[j];
+      for (int i = k + 1; i < m; i++) {
+        double v = a[i * n + k];
+        row = a + i * n + k + 1;
+        for (int j = 0; j < width; j++) row[j] -= v * w[j];
+      }
+    }
+
+    for (int j = k + 1; j < n; j++) {
+      double r = a[k * n + j];
+      norms[j] -= r * r;
+      if (norms[j] <= exact[j] * sqrt(DBL_EPSILON)) {
+        norms[j] = exact[j] = column_norm2(a, m, n, k + 1, j);
+      }
+    }
+  }
+
+  s21_arena_release(arena, mark);
+  return OK;
+}
+
+/**
+ * Функция qr_rank возвращает численный ранг по диагонали R: количество
+ * элементов, модуль которых больше max(m, n) * DBL_EPSILON * |R[0][0]|.
+ */
+int qr_rank(const double *r, int m, int n) {
+  double limit = (m > n ? m : n) * DBL_EPSILON * fabs(r[0]);
+  int rank = 0;
+  while (rank < n && fabs(r[rank * n + rank]) > limit) rank++;
+  return rank;
+}
+
+/**
+ * Функция qr_solve находит решение X (n строк) системы A * X = B методом
+ * наименьших квадратов по разложению из qr_decompose: B заменяется на
+ * Q^T * B, из первых n строк обратной подстановкой по R находится P^T * X,
+ * после чего строки переставляются обратно. Матрица должна иметь полный
+ * ранг по столбцам.
+ *
+ * @param b Массив из m указателей на строки правой части длиной nrhs; строки
+ * портятся.
+ * @param w Временный буфер из nrhs элементов.
+ * @param x Массив из n указателей на строки решения, не пересекающихся с b.
+ */
+void qr_solve(const double *qr, const double *tau, const int *perm, int m,
+              int n, double **b, int nrhs, double *w, double **x) {
+  for (int k = 0; k < n; k++) {
+    if (tau[k] == 0) continue;
+    memcpy(w, b[k], sizeof(double) * nrhs);
+    for (int i = k + 1; i < m; i++) {
+      double v = qr[i * n + k];
+      for (int j = 0; j < nrhs; j++) w[j] += v * b[i][j];
+    }
+    for (int j = 0; j < nrhs; j++) {
+      w[j] *= tau[k];
+      b[k][j] -= w[j];
+    }
+    for (int i = k + 1; i < m; i++) {
+      double v = qr[i * n + k];
+      for (int j = 0; j < nrhs; j++) b[i][j] -= v * w[j];
+    }
+  }
+
+  for (int i = n - 1; i >= 0; i--) {
+    for (int k = i + 1; k < n; k++) {
+      double r = qr[i * n + k];
+      if (r != 0) {
+        for (int j = 0; j < nrhs; j++) b[i][j] -= r * b[k][j];
+      }
+    }
+    double d = 1 / qr[i * n + i];
+    for (int j = 0; j < nrhs; j++) b[i][j] *= d;
+  }
+  for (int i = 0; i < n; i++) {
+    memcpy(x[perm[i]], b[i], sizeof(double) * nrhs);
+  }
+}
@@ -0,0 +1,585 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+
+#include "s21_internal.h"
+
+typedef int (*binary_kernel)(const double *a, const double *b, double *r,
+                             size_t n);
+typedef int (*scale_kernel)(const double *a, double k, double *r, size_t n);
+typedef void (*transpose_kernel)(double *const *src, int i0, int j0, int rows,
+                                 int cols, double **dst);
+typedef double (*dot_kernel)(const double *x, const double *y, size_t n);
+typedef void (*axpy_kernel)(double a, const double *x, double *y, size_t n);
+typedef double (*reduce_kernel)(const double *x, size_t n);
+
+typedef struct simd_kernels {
+  binary_kernel add;
+  binary_kernel sub;
+  binary_kernel mul;
+  scale_kernel scale;
+  transpose_kernel transpose;
+  dot_kernel dot;
+  axpy_kernel axpy;
+  reduce_kernel asum;
+  reduce_kernel amax;
+  const char *name;
+} simd_kernels;
+
+static int scalar_add(const double *a, const double *b, double *r, size_t n) {
+  double bad = 0;
+  for (size_t i = 0; i < n; i++) {
+    r[i] = a[i] + b[i];
+    bad += r[i] - r[i];
+  }
+  return isnan(bad);
+}
+
+static int scalar_sub(const double *a, const double *b, double *r, size_t n) {
+  double bad = 0;
+  for (size_t i = 0; i < n; i++) {
+    r[i] = a[i] - b[i];
+    bad += r[i] - r[i];
+  }
+  return isnan(bad);
+}
+
+static int scalar_mul(const double *a, const double *b, double *r, size_t n) {
+  double bad = 0;
+  for (size_t i = 0; i < n; i++) {
+    r[i] = a[i] * b[i];
+    bad += r[i] - r[i];
+  }
+  return isnan(bad);
+}
+
+static int scalar_scale(const double *a, double k, double *r, size_t n) {
+  double bad = 0;
+  for (size_t i = 0; i < n; i++) {
+    r[i] = a[i] * k;
+    bad += r[i] - r[i];
+  }
+  return isnan(bad);
+}
+
+static void scalar_transpose(double *const *src, int i0, int j0, int rows,
+                             int cols, double **dst) {
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) dst[j0 + j][i0 + i] = src[i0 + i][j0 + j];
+  }
+}
+
+static double scalar_dot(const double *x, const double *y, size_t n) {
+  double sum = 0;
+  for (size_t i = 0; i < n; i++) sum += x[i] * y[i];
+  return sum;
+}
+
+static void scalar_axpy(double a, const double *x, double *y, size_t n) {
+  for (size_t i = 0; i < n; i++) y[i] += a * x[i];
+}
+
+static double scalar_asum(const double *x, size_t n) {
+  double sum = 0;
+  for (size_t i = 0; i < n; i++) sum += fabs(x[i]);
+  return sum;
+}
+
+static double scalar_amax(const double *x, size_t n) {
+  double max = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (isnan(x[i])) return NAN;
+    if (fabs(x[i]) > max) max = fabs(x[i]);
+  }
+  return max;
+}
+
+typedef struct simd_f32_kernels {
+  int (*add)(const float *a, const float *b, float *r, size_t n);
+  int (*sub)(const float *a, const float *b, float *r, size_t n);
+  int (*scale)(const float *a, float k, float *r, size_t n);
+  void (*axpy)(float a, const float *x, float *y, size_t n);
+  void (*axpy_mixed)(double a, const float *x, double *y, size_t n);
+} simd_f32_kernels;
+
+static int scalar_f32_add(const float *a, const float *b, float *r,
+                          size_t n) {
+  int bad = 0;
+  for (size_t i = 0; i < n; i++) {
+    r[i] = a[i] + b[i];
+    bad |= !isfinite(r[i]);
+  }
+  return bad;
+}
+
+static int scalar_f32_sub(const float *a, const float *b, float *r,
+                          size_t n) {
+  int bad = 0;
+  for (size_t i = 0; i < n; i++) {
+    r[i] = a[i] - b[i];
+    bad |= !isfinite(r[i]);
+  }
+  return bad;
+}
+
+static int scalar_f32_scale(const float *a, float k, float *r, size_t n) {
+  int bad = 0;
+  for (size_t i = 0; i < n; i++) {
+    r[i] = a[i] * k;
+    bad |= !isfinite(r[i]);
+  }
+  return bad;
+}
+
+static void scalar_f32_axpy(float a, const float *x, float *y, size_t n) {
+  for (size_t i = 0; i < n; i++) y[i] += a * x[i];
+}
+
+static void scalar_f32_axpy_mixed(double a, const float *x, double *y,
+                                  size_t n) {
+  for (size_t i = 0; i < n; i++) y[i] += a * x[i];
+}
+
+static simd_kernels kernels = {
+    scalar_add,  scalar_sub,  scalar_mul,  scalar_scale, scalar_transpose,
+    scalar_dot, scalar_axpy, scalar_asum, scalar_amax,  "scalar"};
+static simd_f32_kernels kernels_f32 = {scalar_f32_add, scalar_f32_sub,
+                                       scalar_f32_scale, scalar_f32_axpy,
+                                       scalar_f32_axpy_mixed};
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+/*
+ * Переполнение и NaN ищутся без ветвлений: для конечного v разность v - v
+ * равна нулю, для бесконечности и NaN — NaN. Эти разности накапливаются в
+ * векторе bad, который проверяется один раз в конце прохода.
+ */
+#define SIMD_BINARY(isa, name, attr, vec, type, width, loadu, storeu, op,   \
+                    add, sub, zero, any_nan, scalar_op)                       \
+  attr static int isa##_##name(const type *a, const type *b, type *r,        \
+                               size_t n) {                                    \
+    vec bad = zero();                                                         \
+    size_t i = 0;                                                             \
+    for (; i + width <= n; i += width) {                                      \
+      vec v = op(loadu(a + i), loadu(b + i));                                 \
+      storeu(r + i, v);                                                       \
+      bad = add(bad, sub(v, v));                                              \
+    }                                                                         \
+    int res = any_nan(bad);                                                   \
+    for (; i < n; i++) {                                                      \
+      r[i] = a[i] scalar_op b[i];                                             \
+      res |= !isfinite(r[i]);                                                 \
+    }                                                                         \
+    return res;                                                               \
+  }
+
+#define SIMD_SCALE(isa, attr, vec, type, width, loadu, storeu, mul, add, sub, \
+                   zero, set1, any_nan)                                       \
+  attr static int isa##_scale(const type *a, type k, type *r, size_t n) {    \
+    vec bad = zero();                                                         \
+    vec factor = set1(k);                                                     \
+    size_t i = 0;                                                             \
+    for (; i + width <= n; i += width) {                                      \
+      vec v = mul(loadu(a + i), factor);                                      \
+      storeu(r + i, v);                                                       \
+      bad = add(bad, sub(v, v));                                              \
+    }                                                                         \
+    int res = any_nan(bad);                                                   \
+    for (; i < n; i++) {                                                      \
+      r[i] = a[i] * k;                                                        \
+      res |= !isfinite(r[i]);                                                 \
+    }                                                                         \
+    return res;                                                               \
+  }
+
+#define SIMD_KERNELS(isa, attr, vec, width, loadu, storeu, vadd, vsub, vmul, \
+                     zero, set1, any_nan)                                     \
+  SIMD_BINARY(isa, add, attr, vec, double, width, loadu, storeu, vadd, vadd, \
+              vsub, zero, any_nan, +)                                         \
+  SIMD_BINARY(isa, sub, attr, vec, double, width, loadu, storeu, vsub, vadd, \
+              vsub, zero, any_nan, -)                                         \
+  SIMD_BINARY(isa, mul, attr, vec, double, width, loadu, storeu, vmul, vadd, \
+              vsub, zero, any_nan, *)                                         \
+  SIMD_SCALE(isa, attr, vec, double, width, loadu, storeu, vmul, vadd, vsub, \
+             zero, set1, any_nan)
+
+/*
+ * Векторные ядра BLAS первого уровня. Скалярное произведение и сумма модулей
+ * копят четыре независимые суммы, чтобы не ждать задержки сложения, поэтому
+ * порядок суммирования (и последние биты результата) зависит от набора
+ * инструкций. Максимум модулей при бесконечности или NaN во входе
+ * пересчитывается скалярно, потому что max_pd теряет NaN.
+ */
+#define SIMD_VECTOR_KERNELS(isa, attr, vec, width, loadu, storeu, vadd, vsub, \
+                            vmul, vmax, vabs, zero, set1, any_nan)            \
+  attr static double isa##_dot(const double *x, const double *y, size_t n) { \
+    vec acc[4] = {zero(), zero(), zero(), zero()};                            \
+    size_t i = 0;                                                             \
+    for (; i + 4 * width <= n; i += 4 * width) {                              \
+      for (int u = 0; u < 4; u++) {                                           \
+        vec v = vmul(loadu(x + i + u * width), loadu(y + i + u * width));     \
+        acc[u] = vadd(acc[u], v);                                             \
+      }                                                                       \
+    }                                                                         \
+    double lanes[width], sum = 0;                                             \
+    storeu(lanes, vadd(vadd(acc[0], acc[1]), vadd(acc[2], acc[3])));          \
+    for (int l = 0; l < width; l++) sum += lanes[l];                          \
+    for (; i < n; i++) sum += x[i] * y[i];                                    \
+    return sum;                                                               \
+  }                                                                           \
+  attr static void isa##_axpy(double a, const double *x, double *y,          \
+                              size_t n) {                                     \
+    vec factor = set1(a);                                                     \
+    size_t i = 0;                                                             \
+    for (; i + width <= n; i += width) {                                      \
+      storeu(y + i, vadd(loadu(y + i), vmul(factor, loadu(x + i))));          \
+    }                                                                         \
+    for (; i < n; i++) y[i] += a * x[i];                                      \
+  }                                                                           \
+  attr static double isa##_asum(const double *x, size_t n) {                 \
+    vec acc[4] = {zero(), zero(), zero(), zero()};                            \
+    size_t i = 0;                                                             \
+    for (; i + 4 * width <= n; i += 4 * width) {                              \
+      for (int u = 0; u < 4; u++) {                                           \
+        acc[u] = vadd(acc[u], vabs(loadu(x + i + u * width)));                \
+      }                                                                       \
+    }                                                                         \
+    double lanes[width], sum = 0;                                             \
+    storeu(lanes, vadd(vadd(acc[0], acc[1]), vadd(acc[2], acc[3])));          \
+    for (int l = 0; l < width; l++) sum += lanes[l];                          \
+    for (; i < n; i++) sum += fabs(x[i]);                                     \
+    return sum;                                                               \
+  }                                                                           \
+  attr static double isa##_amax(const double *x, size_t n) {                 \
+    vec max = zero(), bad = zero();                                           \
+    size_t i = 0;                                                             \
+    for (; i + width <= n; i += width) {                                      \
+      vec v = loadu(x + i);                                                   \
+      max = vmax(max, vabs(v));                                               \
+      bad = vadd(bad, vsub(v, v));                                            \
+    }                                                                         \
+    if (any_nan(bad)) return scalar_amax(x, n);                               \
+    double lanes[width], result = scalar_amax(x + i, n - i);                  \
+    storeu(lanes, max);                                                       \
+    for (int l = 0; l < width; l++) result = fmax(result, lanes[l]);          \
+    return result;                                                            \
+  }
+
+/*
+ * Ядра для float: поэлементные операции с той же проверкой результата и
+ * axpy (y += a * x). Вариант axpy_mixed читает x во float, а умножает и
+ * накапливает в double, преобразуя элементы x прямо в регистрах.
+ */
+#define SIMD_KERNELS_F32(isa, attr, vec, vec_pd, width, loadu, storeu, vadd,  \
+                         vsub, vmul, zero, set1, any_nan, vec_width, cvt_pd, \
+                         loadu_pd, storeu_pd, vadd_pd, vmul_pd, set1_pd)     \
+  SIMD_BINARY(isa##_f32, add, attr, vec, float, width, loadu, storeu, vadd,  \
+              vadd, vsub, zero, any_nan, +)                                   \
+  SIMD_BINARY(isa##_f32, sub, attr, vec, float, width, loadu, storeu, vsub,  \
+              vadd, vsub, zero, any_nan, -)                                   \
+  SIMD_SCALE(isa##_f32, attr, vec, float, width, loadu, storeu, vmul, vadd,  \
+             vsub, zero, set1, any_nan)                                       \
+  attr static void isa##_f32_axpy(float a, const float *x, float *y,         \
+                                  size_t n) {                                 \
+    vec factor = set1(a);                                                     \
+    size_t i = 0;                                                             \
+    for (; i + width <= n; i += width) {                                      \
+      storeu(y + i, vadd(loadu(y + i), vmul(factor, loadu(x + i))));          \
+    }                                                                         \
+    for (; i < n; i++) y[i] += a * x[i];                                      \
+  }                                                                           \
+  attr static void isa##_f32_axpy_mixed(double a, const float *x, double *y, \
+                                        size_t n) {                           \
+    vec_pd factor = set1_pd(a);                                               \
+    size_t i = 0;                                                             \
+    for (; i + vec_width <= n; i += vec_width) {                              \
+      vec_pd v = vmul_pd(factor, cvt_pd(x + i));                              \
+      storeu_pd(y + i, vadd_pd(loadu_pd(y + i), v));                          \
+    }                                                                         \
+    for (; i < n; i++) y[i] += a * x[i];                                      \
+  }
+
+#define SSE2_ANY_NAN(v) (_mm_movemask_pd(_mm_cmpunord_pd(v, v)) != 0)
+#define AVX2_ANY_NAN(v) \
+  (_mm256_movemask_pd(_mm256_cmp_pd(v, v, _CMP_UNORD_Q)) != 0)
+#define AVX512_ANY_NAN(v) (_mm512_cmp_pd_mask(v, v, _CMP_UNORD_Q) != 0)
+
+SIMD_KERNELS(sse2, __attribute__((target("sse2"))), __m128d, 2, _mm_loadu_pd,
+             _mm_storeu_pd, _mm_add_pd, _mm_sub_pd, _mm_mul_pd, _mm_setzero_pd,
+             _mm_set1_pd, SSE2_ANY_NAN)
+SIMD_KERNELS(avx2, __attribute__((target("avx2"))), __m256d, 4,
+             _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, _mm256_sub_pd,
+             _mm256_mul_pd, _mm256_setzero_pd, _mm256_set1_pd, AVX2_ANY_NAN)
+SIMD_KERNELS(avx512, __attribute__((target("avx512f"))), __m512d, 8,
+             _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, _mm512_sub_pd,
+             _mm512_mul_pd, _mm512_setzero_pd, _mm512_set1_pd, AVX512_ANY_NAN)
+
+#define SSE2_ABS(v) _mm_andnot_pd(_mm_set1_pd(-0.0), v)
+#define AVX2_ABS(v) _mm256_andnot_pd(_mm256_set1_pd(-0.0), v)
+
+SIMD_VECTOR_KERNELS(sse2, __attribute__((target("sse2"))), __m128d, 2,
+                    _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd, _mm_sub_pd,
+                    _mm_mul_pd, _mm_max_pd, SSE2_ABS, _mm_setzero_pd,
+                    _mm_set1_pd, SSE2_ANY_NAN)
+SIMD_VECTOR_KERNELS(avx2, __attribute__((target("avx2"))), __m256d, 4,
+                    _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd,
+                    _mm256_sub_pd, _mm256_mul_pd, _mm256_max_pd, AVX2_ABS,
+                    _mm256_setzero_pd, _mm256_set1_pd, AVX2_ANY_NAN)
+SIMD_VECTOR_KERNELS(avx512, __attribute__((target("avx512f"))), __m512d, 8,
+                    _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd,
+                    _mm512_sub_pd, _mm512_mul_pd, _mm512_max_pd,
+                    _mm512_abs_pd, _mm512_setzero_pd, _mm512_set1_pd,
+                    AVX512_ANY_NAN)
+
+#define SSE2_ANY_NAN_PS(v) (_mm_movemask_ps(_mm_cmpunord_ps(v, v)) != 0)
+#define AVX2_ANY_NAN_PS(v) \
+  (_mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)) != 0)
+#define AVX512_ANY_NAN_PS(v) (_mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q) != 0)
+#define SSE2_CVT_PD(p) \
+  _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i *)(p))))
+#define AVX2_CVT_PD(p) _mm256_cvtps_pd(_mm_loadu_ps(p))
+#define AVX512_CVT_PD(p) _mm512_cvtps_pd(_mm256_loadu_ps(p))
+
+SIMD_KERNELS_F32(sse2, __attribute__((target("sse2"))), __m128, __m128d, 4,
+                 _mm_loadu_ps, _mm_storeu_ps, _mm_add_ps, _mm_sub_ps,
+                 _mm_mul_ps, _mm_setzero_ps, _mm_set1_ps, SSE2_ANY_NAN_PS, 2,
+                 SSE2_CVT_PD, _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd,
+                 _mm_mul_pd, _mm_set1_pd)
+SIMD_KERNELS_F32(avx2, __attribute__((target("avx2"))), __m256, __m256d, 8,
+                 _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps,
+                 _mm256_sub_ps, _mm256_mul_ps, _mm256_setzero_ps,
+                 _mm256_set1_ps, AVX2_ANY_NAN_PS, 4, AVX2_CVT_PD,
+                 _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd,
+                 _mm256_mul_pd, _mm256_set1_pd)
+SIMD_KERNELS_F32(avx512, __attribute__((target("avx512f"))), __m512, __m512d,
+                 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_add_ps,
+                 _mm512_sub_ps, _mm512_mul_ps, _mm512_setzero_ps,
+                 _mm512_set1_ps, AVX512_ANY_NAN_PS, 8, AVX512_CVT_PD,
+                 _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd,
+                 _mm512_mul_pd, _mm512_set1_pd)
+
+/*
+ * Ядра транспонирования переставляют в регистрах блоки 2x2 (SSE2) и 4x4 (AVX)
+ * и записывают их строками результата; остаток блока обрабатывается скалярно.
+ */
+__attribute__((target("sse2"))) static void sse2_transpose(
+    double *const *src, int i0, int j0, int rows, int cols, double **dst) {
+  int i = 0;
+  for (; i + 2 <= rows; i += 2) {
+    const double *s0 = src[i0 + i] + j0;
+    const double *s1 = src[i0 + i + 1] + j0;
+    int j = 0;
+    for (; j + 2 <= cols; j += 2) {
+      __m128d r0 = _mm_loadu_pd(s0 + j);
+      __m128d r1 = _mm_loadu_pd(s1 + j);
+      _mm_storeu_pd(dst[j0 + j] + i0 + i, _mm_unpacklo_pd(r0, r1));
+      _mm_storeu_pd(dst[j0 + j + 1] + i0 + i, _mm_unpackhi_pd(r0, r1));
+    }
+    for (; j < cols; j++) {
+      dst[j0 + j][i0 + i] = s0[j];
+      dst[j0 + j][i0 + i + 1] = s1[j];
+    }
+  }
+  if (i < rows) scalar_transpose(src, i0 + i, j0, rows - i, cols, dst);
+}
+
+__attribute__((target("avx"))) static void avx_transpose(
+    double *const *src, int i0, int j0, int rows, int cols, double **dst) {
+  int i = 0;
+  for (; i + 4 <= rows; i += 4) {
+    const double *s0 = src[i0 + i] + j0;
+    const double *s1 = src[i0 + i + 1] + j0;
+    const double *s2 = src[i0 + i + 2] + j0;
+    const double *s3 = src[i0 + i + 3] + j0;
+    int j = 0;
+    for (; j + 4 <= cols; j += 4) {
+      __m256d t0 = _mm256_unpacklo_pd(_mm256_loadu_pd(s0 + j),
+                                      _mm256_loadu_pd(s1 + j));
+      __m256d t1 = _mm256_unpackhi_pd(_mm256_loadu_pd(s0 + j),
+                                      _mm256_loadu_pd(s1 + j));
+      __m256d t2 = _mm256_unpacklo_pd(_mm256_loadu_pd(s2 + j),
+                                      _mm256_loadu_pd(s3 + j));
+      __m256d t3 = _mm256_unpackhi_pd(_mm256_loadu_pd(s2 + j),
+                                      _mm256_loadu_pd(s3 + j));
+      double *d = dst[j0 + j] + i0 + i;
+      _mm256_storeu_pd(d, _mm256_permute2f128_pd(t0, t2, 0x20));
+      d = dst[j0 + j + 1] + i0 + i;
+      _mm256_storeu_pd(d, _mm256_permute2f128_pd(t1, t3, 0x20));
+      d = dst[j0 + j + 2] + i0 + i;
+      _mm256_storeu_pd(d, _mm256_permute2f128_pd(t0, t2, 0x31));
+      d = dst[j0 + j + 3] + i0 + i;
+      _mm256_storeu_pd(d, _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+    if (j < cols) scalar_transpose(src, i0 + i, j0 + j, 4, cols - j, dst);
+  }
+  if (i < rows) scalar_transpose(src, i0 + i, j0, rows - i, cols, dst);
+}
+
+static void select_kernels(void) {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    kernels = (simd_kernels){
+        avx512_add, avx512_sub,  avx512_mul,  avx512_scale, avx_transpose,
+        avx512_dot, avx512_axpy, avx512_asum, avx512_amax,  "avx512"};
+    kernels_f32 = (simd_f32_kernels){avx512_f32_add, avx512_f32_sub,
+                                     avx512_f32_scale, avx512_f32_axpy,
+                                     avx512_f32_axpy_mixed};
+  } else if (__builtin_cpu_supports("avx2")) {
+    kernels = (simd_kernels){avx2_add,   avx2_sub,      avx2_mul,
+                             avx2_scale, avx_transpose, avx2_dot,
+                             avx2_axpy,  avx2_asum,     avx2_amax,
+                             "avx2"};
+    kernels_f32 = (simd_f32_kernels){avx2_f32_add, avx2_f32_sub,
+                                     avx2_f32_scale, avx2_f32_axpy,
+                                     avx2_f32_axpy_mixed};
+  } else if (__builtin_cpu_supports("sse2")) {
+    kernels = (simd_kernels){sse2_add,   sse2_sub,       sse2_mul,
+                             sse2_scale, sse2_transpose, sse2_dot,
+                             sse2_axpy,  sse2_asum,      sse2_amax,
+                             "sse2"};
+    kernels_f32 = (simd_f32_kernels){sse2_f32_add, sse2_f32_sub,
+                                     sse2_f32_scale, sse2_f32_axpy,
+                                     sse2_f32_axpy_mixed};
+  }
+}
+#else
+static void select_kernels(void) {}
+#endif
+
+/**
+ * Функция simd_add записывает в r поэлементную сумму массивов a и b длины n.
+ * Реализация (SSE2, AVX2 или AVX-512) выбирается один раз при первом вызове
+ * по возможностям процессора.
+ *
+ * @return 1, если в результате есть бесконечность или NaN, иначе 0.
+ */
+int simd_add(const double *a, const double *b, double *r, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels.add(a, b, r, n);
+}
+
+/**
+ * Функция simd_sub записывает в r поэлементную разность массивов a и b длины
+ * n. Реализация выбирается так же, как в simd_add.
+ *
+ * @return 1, если в результате есть бесконечность или NaN, иначе 0.
+ */
+int simd_sub(const double *a, const double *b, double *r, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels.sub(a, b, r, n);
+}
+
+/**
+ * Функция simd_mul записывает в r поэлементное произведение массивов a и b
+ * длины n. Реализация выбирается так же, как в simd_add.
+ *
+ * @return 1, если в результате есть бесконечность или NaN, иначе 0.
+ */
+int simd_mul(const double *a, const double *b, double *r, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels.mul(a, b, r, n);
+}
+
+/**
+ * Функция simd_scale записывает в r элементы массива a длины n, умноженные на
+ * число k. Реализация выбирается так же, как в simd_add.
+ *
+ * @return 1, если в результате есть бесконечность или NaN, иначе 0.
+ */
+int simd_scale(const double *a, double k, double *r, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels.scale(a, k, r, n);
+}
+
+/**
+ * Функция simd_transpose записывает в dst транспонированный блок src размером
+ * rows x cols с левым верхним углом (i0, j0): dst[j0 + j][i0 + i] =
+ * src[i0 + i][j0 + j]. Блоки 4x4 (AVX) или 2x2 (SSE2) переставляются в
+ * регистрах. Блок src не должен перекрываться с записываемой частью dst.
+ */
+void simd_transpose(double *const *src, int i0, int j0, int rows, int cols,
+                    double **dst) {
+  pthread_once(&kernels_once, select_kernels);
+  kernels.transpose(src, i0, j0, rows, cols, dst);
+}
+
+/**
+ * Функция simd_dot возвращает скалярное произведение массивов x и y длины n.
+ * Реализация выбирается так же, как в simd_add.
+ */
+double simd_dot(const double *x, const double *y, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels.dot(x, y, n);
+}
+
+/**
+ * Функция simd_axpy прибавляет к массиву y длины n массив x, умноженный на a:
+ * y[i] += a * x[i].
+ */
+void simd_axpy(double a, const double *x, double *y, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  kernels.axpy(a, x, y, n);
+}
+
+/**
+ * Функции simd_asum и simd_amax возвращают сумму и максимум модулей элементов
+ * массива x длины n. simd_amax возвращает NaN, если он есть в x.
+ */
+double simd_asum(const double *x, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels.asum(x, n);
+}
+
+double simd_amax(const double *x, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels.amax(x, n);
+}
+
+/**
+ * Функция simd_name возвращает название набора инструкций, выбранного для
+ * поэлементных операций: "avx512", "avx2", "sse2" или "scalar".
+ */
+const char *simd_name(void) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels.name;
+}
+
+/**
+ * Функции simd_add_f32, simd_sub_f32 и simd_scale_f32 — варианты simd_add,
+ * simd_sub и simd_scale для массивов float; реализация выбирается так же.
+ *
+ * @return 1, если в результате есть бесконечность или NaN, иначе 0.
+ */
+int simd_add_f32(const float *a, const float *b, float *r, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels_f32.add(a, b, r, n);
+}
+
+int simd_sub_f32(const float *a, const float *b, float *r, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels_f32.sub(a, b, r, n);
+}
+
+int simd_scale_f32(const float *a, float k, float *r, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  return kernels_f32.scale(a, k, r, n);
+}
+
+/**
+ * Функция simd_axpy_f32 прибавляет к массиву y длины n массив x, умноженный
+ * на a: y[i] += a * x[i]. Результат не зависит от набора инструкций.
+ */
+void simd_axpy_f32(float a, const float *x, float *y, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  kernels_f32.axpy(a, x, y, n);
+}
+
+/**
+ * Функция simd_axpy_mixed — вариант simd_axpy_f32 с накоплением в double:
+ * элементы x преобразуются в double, и y[i] += a * x[i] считается в double.
+ */
+void simd_axpy_mixed(double a, const float *x, double *y, size_t n) {
+  pthread_once(&kernels_once, select_kernels);
+  kernels_f32.axpy_mixed(a, x, y, n);
+}
@@ -0,0 +1,174 @@
+#include "s21_internal.h"
+
+/*
+ * Развёрнутые ядра для матриц порядка 2..SMALL_MAX_ORDER. Они работают прямо
+ * с указателями на строки, не выделяют память и не содержат циклов с
+ * переменными границами. Определители 2x2 и 3x3 и 4x4 раскладываются по
+ * первой строке (формула Лапласа) в фиксированном порядке операций.
+ */
+
+#define DET2(a00, a01, a10, a11) ((a00) * (a11) - (a01) * (a10))
+
+#define DET3(a, r0, r1, r2, c0, c1, c2)                             \
+  ((a)[r0][c0] * DET2((a)[r1][c1], (a)[r1][c2], (a)[r2][c1],        \
+                      (a)[r2][c2]) -                                \
+   (a)[r0][c1] * DET2((a)[r1][c0], (a)[r1][c2], (a)[r2][c0],        \
+                      (a)[r2][c2]) +                                \
+   (a)[r0][c2] * DET2((a)[r1][c0], (a)[r1][c1], (a)[r2][c0],        \
+                      (a)[r2][c1]))
+
+/**
+ * Функция small_determinant вычисляет определитель матрицы порядка n
+ * (от 2 до SMALL_MAX_ORDER) по явным формулам.
+ *
+ * @param a Указатели на строки матрицы.
+ * @param n Порядок матрицы.
+ */
+double small_determinant(double *const *a, int n) {
+  double det = 0;
+  if (n == 2) {
+    det = DET2(a[0][0], a[0][1], a[1][0], a[1][1]);
+  } else if (n == 3) {
+    det = DET3(a, 0, 1, 2, 0, 1, 2);
+  } else {
+    det = a[0][0] * DET3(a, 1, 2, 3, 1, 2, 3) -
+          a[0][1] * DET3(a, 1, 2, 3, 0, 2, 3) +
+          a[0][2] * DET3(a, 1, 2, 3, 0, 1, 3) -
+          a[0][3] * DET3(a, 1, 2, 3, 0, 1, 2);
+  }
+  return det;
+}
+
+/*
+ * Матрица алгебраических дополнений 4x4 через шесть миноров 2x2 из первых
+ * двух строк (s) и шесть из последних двух (c): каждое дополнение — сумма
+ * трёх произведений вместо определителя 3x3.
+ */
+static void complements4(double *const *a, double **r) {
+  double s0 = DET2(a[0][0], a[0][1], a[1][0], a[1][1]);
+  double s1 = DET2(a[0][0], a[0][2], a[1][0], a[1][2]);
+  double s2 = DET2(a[0][0], a[0][3], a[1][0], a[1][3]);
+  double s3 = DET2(a[0][1], a[0][2], a[1][1], a[1][2]);
+  double s4 = DET2(a[0][1], a[0][3], a[1][1], a[1][3]);
+  double s5 = DET2(a[0][2], a[0][3], a[1][2], a[1][3]);
+  double c0 = DET2(a[2][0], a[2][1], a[3][0], a[3][1]);
+  double c1 = DET2(a[2][0], a[2][2], a[3][0], a[3][2]);
+  double c2 = DET2(a[2][0], a[2][3], a[3][0], a[3][3]);
+  double c3 = DET2(a[2][1], a[2][2], a[3][1], a[3][2]);
+  double c4 = DET2(a[2][1], a[2][3], a[3][1], a[3][3]);
+  double c5 = DET2(a[2][2], a[2][3], a[3][2], a[3][3]);
+
+  r[0][0] = a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3;
+  r[0][1] = -a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1;
+  r[0][2] = a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0;
+  r[0][3] = -a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0;
+  r[1][0] = -a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3;
+  r[1][1] = a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1;
+  r[1][2] = -a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0;
+  r[1][3] = a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0;
+  r[2][0] = a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3;
+  r[2][1] = -a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1;
+  r[2][2] = a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0;
+  r[2][3] = -a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0;
+  r[3][0] = -a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3;
+  r[3][1] = a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1;
+  r[3][2] = -a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0;
+  r[3][3] = a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0;
+}
+
+/**
+ * Функция small_complements записывает в r матрицу алгебраических дополнений
+ * матрицы a порядка n (от 2 до SMALL_MAX_ORDER). r не может совпадать с a.
+ */
+void small_complements(double *const *a, int n, double **r) {
+  if (n == 2) {
+    r[0][0] = a[1][1];
+    r[0][1] = -a[1][0];
+    r[1][0] = -a[0][1];
+    r[1][1] = a[0][0];
+  } else if (n == 3) {
+    r[0][0] = DET2(a[1][1], a[1][2], a[2][1], a[2][2]);
+    r[0][1] = -DET2(a[1][0], a[1][2], a[2][0], a[2][2]);
+    r[0][2] = DET2(a[1][0], a[1][1], a[2][0], a[2][1]);
+    r[1][0] = -DET2(a[0][1], a[0][2], a[2][1], a[2][2]);
+    r[1][1] = DET2(a[0][0], a[0][2], a[2][0], a[2][2]);
+    r[1][2] = -DET2(a[0][0], a[0][1], a[2][0], a[2][1]);
+    r[2][0] = DET2(a[0][1], a[0][2], a[1][1], a[1][2]);
+    r[2][1] = -DET2(a[0][0], a[0][2], a[1][0], a[1][2]);
+    r[2][2] = DET2(a[0][0], a[0][1], a[1][0], a[1][1]);
+  } else {
+    complements4(a, r);
+  }
+}
+
+/**
+ * Функция small_inverse записывает в r обратную матрицу для матрицы a
+ * порядка n (от 2 до SMALL_MAX_ORDER): транспонированные алгебраические
+ * дополнения, делённые на определитель, который раскладывается по первой
+ * строке из тех же дополнений. r не может совпадать с a.
+ *
+ * @return `OK` или `CALC_ERROR`, если определитель равен нулю или результат
+ * не конечен.
+ */
+int small_inverse(double *const *a, int n, double **r) {
+  double c[SMALL_MAX_ORDER][SMALL_MAX_ORDER];
+  double *rows[SMALL_MAX_ORDER] = {c[0], c[1], c[2], c[3]};
+  small_complements(a, n, rows);
+
+  double det = 0;
+  for (int j = 0; j < n; j++) det += a[0][j] * c[0][j];
+  double scale = 1 / det;
+  if (det == 0 || !isfinite(scale)) return CALC_ERROR;
+
+  int bad = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      r[i][j] = c[j][i] * scale;
+      bad |= !isfinite(r[i][j]);
+    }
+  }
+  return bad ? CALC_ERROR : OK;
+}
+
+/*
+ * SMALL_MULT(N) определяет ядро C += A * B для матриц N x N с полностью
+ * развёрнутыми циклами. Суммирование идёт в том же порядке, что и в
+ * построчном цикле gemm_kernel, поэтому результат не меняется.
+ */
+#define SMALL_MULT(N)                                                   \
+  static int mult##N(double *const *a, double *const *b, double **c) { \
+    int bad = 0;                                                        \
+    _Pragma("GCC unroll 4") for (int i = 0; i < N; i++) {               \
+      _Pragma("GCC unroll 4") for (int j = 0; j < N; j++) {             \
+        double sum = c[i][j];                                           \
+        _Pragma("GCC unroll 4") for (int p = 0; p < N; p++) {           \
+          sum += a[i][p] * b[p][j];                                     \
+        }                                                               \
+        c[i][j] = sum;                                                  \
+        bad |= !isfinite(sum);                                          \
+      }                                                                 \
+    }                                                                   \
+    return bad;                                                         \
+  }
+
+SMALL_MULT(2)
+SMALL_MULT(3)
+SMALL_MULT(4)
+
+/**
+ * Функция small_mult прибавляет к C произведение квадратных матриц A и B
+ * порядка n (от 2 до SMALL_MAX_ORDER).
+ *
+ * @return `OK` или `CALC_ERROR`, если в результате есть бесконечность или NaN.
+ */
+int small_mult(int n, double *const *a, double *const *b, double **c) {
+  int bad = 0;
+  if (n == 2) {
+    bad = mult2(a, b, c);
+  } else if (n == 3) {
+    bad = mult3(a, b, c);
+  } else {
+    bad = mult4(a, b, c);
+  }
+  return bad ? CALC_ERROR : OK;
+}
@@ -0,0 +1,349 @@
+#include <string.h>
+
+#include "s21_internal.h"
+
+/*
+ * Разложения матриц, которые строятся один раз и затем используются для
+ * решения систем, обращения и запросов определителя и ранга без повторных
+ * вычислений. Решение по готовому разложению стоит O(n^2) на столбец правой
+ * части вместо O(n^3) на обращение и лишнего умножения. Определитель и ранг
+ * вычисляются при построении и хранятся в s21_factor_t.
+ */
+
+static int is_correct_factor(const s21_factor_t *factor) {
+  return factor == NULL || factor->data == NULL || factor->pivots == NULL ||
+                 factor->rows < 1 || factor->columns < 1
+             ? INCORRECT_MATRIX
+             : OK;
+}
+
+/**
+ * Функция factor_decompose раскладывает буфер factor->data нужным способом и
+ * запоминает определитель и ранг.
+ *
+ * @return `OK` или `CALC_ERROR`, если LU-разложение встретило вырожденную
+ * матрицу, матрица не положительно определена для разложения Холецкого или не
+ * удалось выделить временный буфер.
+ */
+static int factor_decompose(s21_factor_t *factor) {
+  int m = factor->rows, n = factor->columns;
+  double *a = factor->data;
+  int res = OK;
+  factor->sign = 1;
+  factor->rank = n;
+  if (factor->kind == FACTOR_LU) {
+    res = lu_decompose(a, n, factor->pivots, &factor->sign);
+  } else if (factor->kind == FACTOR_CHOLESKY) {
+    res = cholesky_decompose(a, n);
+  } else {
+    res = qr_decompose(a, m, n, factor->tau, factor->pivots, &factor->sign);
+    if (res == OK) factor->rank = qr_rank(a, m, n);
+  }
+
+  double det = factor->sign;
+  for (int i = 0; i < n; i++) {
+    det *= a[i * n + i];
+    if (factor->kind == FACTOR_CHOLESKY) det *= a[i * n + i];
+  }
+  factor->determinant = det;
+  return res;
+}
+
+/**
+ * Функция factor_create копирует матрицу A в новый буфер разложения и
+ * раскладывает её. Если разложение не удалось, память освобождается и factor
+ * не изменяется.
+ *
+ * LU-разложения вырожденной матрицы не существует, поэтому, если
+ * lu_decompose остановился на ведущем элементе ниже порога (sign равен 0),
+ * A раскладывается заново по QR в том же буфере: так разложение сообщает
+ * численный ранг, определитель равен нулю, а решения и обращение по нему
+ * возвращают `CALC_ERROR`.
+ */
+static int factor_create(matrix_t *A, factor_kind kind,
+                         s21_factor_t *factor) {
+  if (is_correct_matrix(A) != OK || factor == NULL) return INCORRECT_MATRIX;
+  int m = A->rows, n = A->columns;
+  if (kind == FACTOR_QR ? m < n : m != n) return CALC_ERROR;
+
+  size_t size = sizeof(double) * ((size_t)m * n + n) + sizeof(int) * n;
+  double *data = malloc(size);
+  if (data == NULL) return CALC_ERROR;
+
+  s21_factor_t created = {kind, data, data + m * n, (int *)(data + m * n + n),
+                          m, n, 1, n, 0};
+  copy_to_buffer(A, data);
+  int res = factor_decompose(&created);
+  if (res != OK && kind == FACTOR_LU && created.sign == 0) {
+    created.kind = FACTOR_QR;
+    copy_to_buffer(A, data);
+    res = factor_decompose(&created);
+    if (created.rank < n) created.determinant = 0;
+  }
+  if (res == OK) {
+    *factor = created;
+  } else {
+    free(data);
+  }
+  return res;
+}
+
+/**
+ * Функция factor_apply решает систему A * X = B по готовому разложению. Для
+ * LU и Холецкого B копируется в X (если это разные матрицы) и решается на
+ * месте; для QR правая часть копируется во временный буфер, так как X короче
+ * B, когда строк в A больше, чем столбцов.
+ *
+ * @return `OK` или `CALC_ERROR`, если матрица QR-разложения неполного ранга,
+ * не удалось выделить буфер или в решении есть бесконечность или NaN.
+ */
+static int factor_apply(const s21_factor_t *factor, matrix_t *B,
+                        matrix_t *X) {
+  int m = factor->rows, n = factor->columns, nrhs = B->columns;
+  if (factor->rank < n) return CALC_ERROR;
+
+  if (factor->kind == FACTOR_QR) {
+    arena_t *arena = scratch_arena();
+    if (arena == NULL) return CALC_ERROR;
+    arena_mark_t mark = s21_arena_mark(arena);
+    double *work = arena_alloc(arena, sizeof(double) * ((size_t)m + 1) * nrhs +
+                                          sizeof(double *) * m);
+    if (work == NULL) return CALC_ERROR;
+    double **rows = (double **)(work + ((size_t)m + 1) * nrhs);
+    for (int i = 0; i < m; i++) {
+      rows[i] = work + (size_t)i * nrhs;
+      memcpy(rows[i], B->matrix[i], sizeof(double) * nrhs);
+    }
+    qr_solve(factor->data, factor->tau, factor->pivots, m, n, rows, nrhs,
+             work + (size_t)m * nrhs, X->matrix);
+    s21_arena_release(arena, mark);
+  } else {
+    if (X != B) {
+      for (int i = 0; i < n; i++) {
+        memcpy(X->matrix[i], B->matrix[i], sizeof(double) * nrhs);
+      }
+    }
+    if (factor->kind == FACTOR_LU) {
+      lu_solve(factor->data, n, factor->pivots, X->matrix, nrhs);
+    } else {
+      cholesky_solve(factor->data, n, X->matrix, nrhs);
+    }
+  }
+
+  int bad = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < nrhs; j++) bad |= !isfinite(X->matrix[i][j]);
+  }
+  return bad ? CALC_ERROR : OK;
+}
+
+/**
+ * Функция s21_factor_lu выполняет LU-разложение квадратной матрицы A с
+ * частичным выбором ведущего элемента и сохраняет его в factor. Матрица A не
+ * изменяется. Разложение освобождается функцией s21_factor_remove.
+ *
+ * @param A Указатель на квадратную матрицу.
+ * @param factor Указатель на структуру создаваемого разложения.
+ *
+ * Для вырожденной A разложение тоже создаётся, но хранит QR-разложение:
+ * s21_factor_rank возвращает ранг меньше порядка, определитель равен нулю, а
+ * s21_factor_solve и s21_factor_inverse возвращают `CALC_ERROR`.
+ *
+ * @return Функция s21_factor_lu возвращает:
+ * - `OK`, если разложение создано
+ * - `INCORRECT_MATRIX`, если A неверна или factor равен NULL
+ * - `CALC_ERROR`, если A не квадратная, не удалось выделить память или
+ * разложение получило бесконечность или NaN; в этом случае factor не
+ * создаётся
+ */
+int s21_factor_lu(matrix_t *A, s21_factor_t *factor) {
+  return factor_create(A, FACTOR_LU, factor);
+}
+
+/**
+ * Функция s21_factor_cholesky выполняет разложение Холецкого A = L * L^T
+ * симметричной положительно определённой матрицы. Используется только нижний
+ * треугольник A. Разложение вдвое дешевле LU и не требует перестановок.
+ *
+ * @return Коды ошибок такие же, как у s21_factor_lu; `CALC_ERROR` также
+ * возвращается, если A не положительно определена. В отличие от
+ * s21_factor_lu, для вырожденной A разложение не создаётся.
+ */
+int s21_factor_cholesky(matrix_t *A, s21_factor_t *factor) {
+  return factor_create(A, FACTOR_CHOLESKY, factor);
+}
+
+/**
+ * Функция s21_factor_qr выполняет QR-разложение с выбором ведущего столбца
+ * матрицы A размером m x n, где m >= n. Разложение строится и для вырожденных
+ * матриц: по нему определяется численный ранг, а при полном ранге по столбцам
+ * s21_factor_solve находит решение методом наименьших квадратов.
+ *
+ * @return Коды ошибок такие же, как у s21_factor_lu; `CALC_ERROR`
+ * возвращается, если у A строк меньше, чем столбцов.
+ */
+int s21_factor_qr(matrix_t *A, s21_factor_t *factor) {
+  return factor_create(A, FACTOR_QR, factor);
+}
+
+/**
+ * Функция s21_factor_determinant возвращает определитель, вычисленный при
+ * построении разложения.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если разложение неверно или result равен
+ * NULL, или `CALC_ERROR`, если матрица не квадратная.
+ */
+int s21_factor_determinant(s21_factor_t *factor, double *result) {
+  if (is_correct_factor(factor) != OK || result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  if (factor->rows != factor->columns) return CALC_ERROR;
+  *result = factor->determinant;
+  return OK;
+}
+
+/**
+ * Функция s21_factor_rank возвращает ранг матрицы. Разложение Холецкого
+ * существует только для невырожденных матриц, поэтому его ранг равен
+ * порядку; для QR и для вырожденной матрицы, переданной в s21_factor_lu, ранг
+ * определяется по диагонали R.
+ *
+ * @return `OK` или `INCORRECT_MATRIX`, если разложение неверно или result
+ * равен NULL.
+ */
+int s21_factor_rank(s21_factor_t *factor, int *result) {
+  if (is_correct_factor(factor) != OK || result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  *result = factor->rank;
+  return OK;
+}
+
+/**
+ * Функция s21_factor_inverse создаёт обратную матрицу по готовому
+ * разложению: единичная матрица записывается прямо в result и решается
+ * система A * X = E.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если разложение неверно или result равен
+ * NULL, или `CALC_ERROR`, если матрица не квадратная, вырождена или в
+ * результате есть бесконечность или NaN; тогда result не создаётся.
+ */
+int s21_factor_inverse(s21_factor_t *factor, matrix_t *result) {
+  if (is_correct_factor(factor) != OK || result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  int n = factor->columns;
+  if (factor->rows != n || factor->rank < n) return CALC_ERROR;
+
+  int res = s21_create_matrix(n, n, result);
+  if (res == OK) {
+    for (int i = 0; i < n; i++) result->matrix[i][i] = 1;
+    res = factor_apply(factor, result, result);
+    if (res != OK) s21_remove_matrix(result);
+  }
+  return res;
+}
+
+/**
+ * Функция s21_factor_solve_into решает систему A * X = B по разложению
+ * factor и записывает решение в уже созданную матрицу X. Столбцы B — правые
+ * части. Для квадратной A матрица X может совпадать с B, тогда решение
+ * получается на месте.
+ *
+ * @param factor Разложение, созданное s21_factor_lu, s21_factor_cholesky или
+ * s21_factor_qr.
+ * @param B Правые части: матрица из factor->rows строк.
+ * @param X Матрица для решения из factor->columns строк и стольких же
+ * столбцов, сколько у B.
+ *
+ * @return Функция s21_factor_solve_into возвращает:
+ * - `OK`, если система решена
+ * - `INCORRECT_MATRIX`, если разложение, B или X неверны
+ * - `CALC_ERROR`, если размеры не совпадают, матрица QR-разложения неполного
+ * ранга или в решении появилась бесконечность или NaN
+ */
+int s21_factor_solve_into(s21_factor_t *factor, matrix_t *B, matrix_t *X) {
+  if (is_correct_factor(factor) != OK || is_correct_matrix(B) != OK) {
+    return INCORRECT_MATRIX;
+  }
+  if (B->rows != factor->rows) return CALC_ERROR;
+  int res = check_output(X, factor->columns, B->columns);
+  if (res == OK) res = factor_apply(factor, B, X);
+  return res;
+}
+
+/**
+ * Функция s21_factor_solve решает систему A * X = B так же, как
+ * s21_factor_solve_into, создавая для решения новую матрицу X.
+ *
+ * @return Коды ошибок такие же, как у s21_factor_solve_into. Если размеры
+ * неверны или матрица неполного ранга, X не создаётся.
+ */
+int s21_factor_solve(s21_factor_t *factor, matrix_t *B, matrix_t *X) {
+  if (is_correct_factor(factor) != OK || is_correct_matrix(B) != OK ||
+      X == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  if (B->rows != factor->rows || factor->rank < factor->columns) {
+    return CALC_ERROR;
+  }
+
+  int res = s21_create_matrix(factor->columns, B->columns, X);
+  if (res == OK) res = factor_apply(factor, B, X);
+  return res;
+}
+
+/**
+ * Функция s21_factor_remove освобождает память разложения.
+ */
+void s21_factor_remove(s21_factor_t *factor) {
+  if (factor != NULL) {
+    free(factor->data);
+    memset(factor, 0, sizeof(*factor));
+  }
+}
+
+/**
+ * Функция s21_solve решает систему A * X = B с квадратной матрицей A и
+ * несколькими правыми частями (столбцами B). LU-разложение A строится во
+ * временном буфере арены потока и сразу применяется, поэтому кроме X память
+ * не выделяется. Для многократного решения с одной A выгоднее один раз
+ * вызвать s21_factor_lu.
+ *
+ * @param A Квадратная матрица системы.
+ * @param B Правые части: матрица из A->rows строк.
+ * @param X Указатель на структуру, в которой создаётся решение.
+ *
+ * @return Функция s21_solve возвращает:
+ * - `OK`, если система решена
+ * - `INCORRECT_MATRIX`, если A, B или X неверны
+ * - `CALC_ERROR`, если A не квадратная, размеры не совпадают, A вырождена
+ * (ведущий элемент LU не больше n * DBL_EPSILON * max|A|; тогда X не
+ * создаётся) или в решении появилась бесконечность или NaN
+ */
+int s21_solve(matrix_t *A, matrix_t *B, matrix_t *X) {
+  PROBE(PROBE_SOLVE);
+  if (is_correct_matrix(A) != OK || is_correct_matrix(B) != OK || X == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  if (A->rows != A->columns || B->rows != A->rows) return CALC_ERROR;
+  PROBE_FLOPS(2.0 / 3 * A->rows * A->rows * A->rows +
+              2.0 * A->rows * A->rows * B->columns);
+
+  int n = A->rows;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  double *data = arena_alloc(arena, sizeof(double) * n * n + sizeof(int) * n);
+  if (data == NULL) return CALC_ERROR;
+
+  s21_factor_t factor = {FACTOR_LU, data, NULL, (int *)(data + n * n),
+                         n, n, 1, n, 0};
+  copy_to_buffer(A, data);
+  int res = lu_decompose(data, n, factor.pivots, &factor.sign);
+  if (res == OK) res = s21_create_matrix(B->rows, B->columns, X);
+  if (res == OK) res = factor_apply(&factor, B, X);
+
+  s21_arena_release(arena, mark);
+  return res;
+}
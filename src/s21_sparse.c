@@ -0,0 +1,514 @@
+#include <string.h>
+
+#include "s21_internal.h"
+
+/*
+ * Разреженная матрица хранит только ненулевые элементы, сгруппированные по
+ * строкам (CSR) или по столбцам (CSC). Группы идут по порядку: элементы
+ * группы g занимают позиции offsets[g]..offsets[g + 1] - 1 массивов values и
+ * indices, где indices — номера столбцов (CSR) или строк (CSC), упорядоченные
+ * по возрастанию внутри группы. Память и время умножения пропорциональны
+ * количеству ненулевых элементов, а не rows * columns.
+ */
+
+#define SPARSE_TASKS_PER_THREAD 4
+
+static int major_size(const s21_sparse_t *A) {
+  return A->format == SPARSE_CSR ? A->rows : A->columns;
+}
+
+static int minor_size(const s21_sparse_t *A) {
+  return A->format == SPARSE_CSR ? A->columns : A->rows;
+}
+
+static int is_correct_sparse(const s21_sparse_t *A) {
+  return A == NULL || A->offsets == NULL || A->rows < 1 || A->columns < 1 ||
+                 (A->format != SPARSE_CSR && A->format != SPARSE_CSC)
+             ? INCORRECT_MATRIX
+             : OK;
+}
+
+/**
+ * Функция s21_create_sparse создаёт разреженную матрицу rows x columns с
+ * местом под nonzeros элементов. Все смещения групп обнуляются; при
+ * заполнении массивов вручную offsets[g + 1] должен указывать на конец
+ * группы g, а поле nonzeros — совпадать с последним смещением.
+ *
+ * @param format SPARSE_CSR (группы — строки) или SPARSE_CSC (столбцы).
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если параметры неверны, или `CALC_ERROR`,
+ * если не удалось выделить память.
+ */
+int s21_create_sparse(int rows, int columns, size_t nonzeros,
+                      sparse_format format, s21_sparse_t *result) {
+  if (result == NULL || rows < 1 || columns < 1 ||
+      (format != SPARSE_CSR && format != SPARSE_CSC)) {
+    return INCORRECT_MATRIX;
+  }
+
+  int major = format == SPARSE_CSR ? rows : columns;
+  size_t size = sizeof(double) * nonzeros + sizeof(size_t) * (major + 1) +
+                sizeof(int) * nonzeros;
+  double *block = malloc(size);
+  if (block == NULL) return CALC_ERROR;
+
+  result->format = format;
+  result->rows = rows;
+  result->columns = columns;
+  result->nonzeros = nonzeros;
+  result->values = block;
+  result->offsets = (size_t *)(block + nonzeros);
+  result->indices = (int *)(result->offsets + major + 1);
+  memset(result->offsets, 0, sizeof(size_t) * (major + 1));
+  return OK;
+}
+
+/**
+ * Функция s21_remove_sparse освобождает память разреженной матрицы.
+ */
+void s21_remove_sparse(s21_sparse_t *A) {
+  if (A != NULL) {
+    free(A->values);
+    memset(A, 0, sizeof(*A));
+  }
+}
+
+/**
+ * Функция regroup записывает в result те же элементы, сгруппированные по
+ * другому измерению: группы result — это номера indices матрицы A, а индексы
+ * внутри групп — номера групп A. Группы A просматриваются по порядку,
+ * поэтому индексы внутри новых групп получаются упорядоченными. Так
+ * выполняются и смена формата (CSR <-> CSC), и транспонирование.
+ *
+ * @return `OK` или `CALC_ERROR`, если не удалось выделить память.
+ */
+static int regroup(const s21_sparse_t *A, sparse_format format, int rows,
+                   int columns, s21_sparse_t *result) {
+  int res = s21_create_sparse(rows, columns, A->nonzeros, format, result);
+  if (res != OK) return res;
+
+  int major = major_size(A), minor = minor_size(A);
+  size_t *cursor = result->offsets;
+  for (size_t e = 0; e < A->nonzeros; e++) cursor[A->indices[e] + 1]++;
+  for (int g = 0; g < minor; g++) cursor[g + 1] += cursor[g];
+
+  for (int g = 0; g < major; g++) {
+    for (size_t e = A->offsets[g]; e < A->offsets[g + 1]; e++) {
+      size_t position = cursor[A->indices[e]]++;
+      result->indices[position] = g;
+      result->values[position] = A->values[e];
+    }
+  }
+  for (int g = minor; g > 0; g--) cursor[g] = cursor[g - 1];
+  cursor[0] = 0;
+  return OK;
+}
+
+/**
+ * Функция s21_sparse_from_dense создаёт разреженную матрицу из ненулевых
+ * элементов плотной матрицы A.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A или параметры неверны, или
+ * `CALC_ERROR`, если не удалось выделить память.
+ */
+int s21_sparse_from_dense(matrix_t *A, sparse_format format,
+                          s21_sparse_t *result) {
+  if (is_correct_matrix(A) != OK) return INCORRECT_MATRIX;
+
+  size_t nonzeros = 0;
+  for (int i = 0; i < A->rows; i++) {
+    for (int j = 0; j < A->columns; j++) nonzeros += A->matrix[i][j] != 0;
+  }
+  int res = s21_create_sparse(A->rows, A->columns, nonzeros, format, result);
+  if (res != OK) return res;
+
+  int csr = format == SPARSE_CSR;
+  size_t *cursor = result->offsets;
+  for (int i = 0; i < A->rows; i++) {
+    for (int j = 0; j < A->columns; j++) {
+      if (A->matrix[i][j] != 0) cursor[(csr ? i : j) + 1]++;
+    }
+  }
+  int major = major_size(result);
+  for (int g = 0; g < major; g++) cursor[g + 1] += cursor[g];
+  for (int i = 0; i < A->rows; i++) {
+    for (int j = 0; j < A->columns; j++) {
+      if (A->matrix[i][j] != 0) {
+        size_t position = cursor[csr ? i : j]++;
+        result->indices[position] = csr ? j : i;
+        result->values[position] = A->matrix[i][j];
+      }
+    }
+  }
+  for (int g = major; g > 0; g--) cursor[g] = cursor[g - 1];
+  cursor[0] = 0;
+  return OK;
+}
+
+/**
+ * Функция s21_sparse_to_dense создаёт плотную матрицу с элементами
+ * разреженной матрицы A.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A неверна или result равен NULL, или
+ * `CALC_ERROR`, если не удалось выделить память.
+ */
+int s21_sparse_to_dense(s21_sparse_t *A, matrix_t *result) {
+  if (is_correct_sparse(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  int res = s21_create_matrix(A->rows, A->columns, result);
+  int csr = A->format == SPARSE_CSR;
+  for (int g = 0; g < major_size(A) && res == OK; g++) {
+    for (size_t e = A->offsets[g]; e < A->offsets[g + 1]; e++) {
+      int i = csr ? g : A->indices[e];
+      int j = csr ? A->indices[e] : g;
+      result->matrix[i][j] = A->values[e];
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция s21_sparse_from_triplets создаёт разреженную матрицу из count
+ * троек (row[t], column[t], value[t]) в произвольном порядке. Значения с
+ * одинаковыми координатами складываются. Тройки сначала раскладываются по
+ * второстепенному измерению, затем устойчиво по основному, поэтому индексы
+ * внутри групп упорядочены без сортировки сравнением.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если параметры неверны или координата
+ * выходит за пределы матрицы, или `CALC_ERROR`, если не удалось выделить
+ * память.
+ */
+int s21_sparse_from_triplets(int rows, int columns, size_t count,
+                             const int *row, const int *column,
+                             const double *value, sparse_format format,
+                             s21_sparse_t *result) {
+  if (count > 0 && (row == NULL || column == NULL || value == NULL)) {
+    return INCORRECT_MATRIX;
+  }
+  for (size_t t = 0; t < count; t++) {
+    if (row[t] < 0 || row[t] >= rows || column[t] < 0 ||
+        column[t] >= columns) {
+      return INCORRECT_MATRIX;
+    }
+  }
+
+  s21_sparse_t by_minor = {0};
+  sparse_format other = format == SPARSE_CSR ? SPARSE_CSC : SPARSE_CSR;
+  int res = s21_create_sparse(rows, columns, count, other, &by_minor);
+  if (res != OK) return res;
+
+  const int *major = format == SPARSE_CSR ? row : column;
+  const int *minor = format == SPARSE_CSR ? column : row;
+  size_t *cursor = by_minor.offsets;
+  int groups = major_size(&by_minor);
+  for (size_t t = 0; t < count; t++) cursor[minor[t] + 1]++;
+  for (int g = 0; g < groups; g++) cursor[g + 1] += cursor[g];
+  for (size_t t = 0; t < count; t++) {
+    size_t position = cursor[minor[t]]++;
+    by_minor.indices[position] = major[t];
+    by_minor.values[position] = value[t];
+  }
+  for (int g = groups; g > 0; g--) cursor[g] = cursor[g - 1];
+  cursor[0] = 0;
+
+  res = regroup(&by_minor, format, rows, columns, result);
+  s21_remove_sparse(&by_minor);
+  if (res != OK) return res;
+
+  size_t out = 0;
+  for (int g = 0; g < major_size(result); g++) {
+    size_t begin = result->offsets[g], end = result->offsets[g + 1];
+    result->offsets[g] = out;
+    for (size_t e = begin; e < end; e++) {
+      if (e > begin && result->indices[e] == result->indices[out - 1]) {
+        result->values[out - 1] += result->values[e];
+      } else {
+        result->indices[out] = result->indices[e];
+        result->values[out++] = result->values[e];
+      }
+    }
+  }
+  result->offsets[major_size(result)] = out;
+  result->nonzeros = out;
+  return OK;
+}
+
+/**
+ * Функция s21_sparse_convert создаёт копию разреженной матрицы A в формате
+ * format.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A или формат неверны, или
+ * `CALC_ERROR`, если не удалось выделить память.
+ */
+int s21_sparse_convert(s21_sparse_t *A, sparse_format format,
+                       s21_sparse_t *result) {
+  if (is_correct_sparse(A) != OK) return INCORRECT_MATRIX;
+  if (format != A->format) {
+    return regroup(A, format, A->rows, A->columns, result);
+  }
+
+  int res = s21_create_sparse(A->rows, A->columns, A->nonzeros, format,
+                              result);
+  if (res == OK) {
+    memcpy(result->values, A->values, sizeof(double) * A->nonzeros);
+    memcpy(result->indices, A->indices, sizeof(int) * A->nonzeros);
+    memcpy(result->offsets, A->offsets,
+           sizeof(size_t) * (major_size(A) + 1));
+  }
+  return res;
+}
+
+/**
+ * Функция s21_sparse_transpose создаёт транспонированную матрицу в том же
+ * формате, что и A.
+ *
+ * @return Коды ошибок такие же, как у s21_sparse_convert.
+ */
+int s21_sparse_transpose(s21_sparse_t *A, s21_sparse_t *result) {
+  if (is_correct_sparse(A) != OK) return INCORRECT_MATRIX;
+  return regroup(A, A->format, A->columns, A->rows, result);
+}
+
+/**
+ * Функция merge_groups сливает группу g матриц A и B (одного формата).
+ * Если out равен NULL, только считает количество элементов суммы.
+ */
+static size_t merge_groups(const s21_sparse_t *A, const s21_sparse_t *B,
+                           int g, s21_sparse_t *out, size_t position) {
+  size_t a = A->offsets[g], a_end = A->offsets[g + 1];
+  size_t b = B->offsets[g], b_end = B->offsets[g + 1];
+  size_t start = position;
+  while (a < a_end || b < b_end) {
+    int take_a = b == b_end || (a < a_end && A->indices[a] <= B->indices[b]);
+    int take_b = a == a_end || (b < b_end && B->indices[b] <= A->indices[a]);
+    if (out != NULL) {
+      out->indices[position] = take_a ? A->indices[a] : B->indices[b];
+      out->values[position] =
+          (take_a ? A->values[a] : 0) + (take_b ? B->values[b] : 0);
+    }
+    a += take_a;
+    b += take_b;
+    position++;
+  }
+  return position - start;
+}
+
+/**
+ * Функция s21_sparse_add создаёт сумму разреженных матриц одного размера в
+ * формате A. Если форматы различаются, B предварительно преобразуется.
+ * Группы сливаются за один проход по упорядоченным индексам.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если матрицы неверны, или `CALC_ERROR`,
+ * если размеры не совпадают, не удалось выделить память или в результате
+ * есть бесконечность или NaN.
+ */
+int s21_sparse_add(s21_sparse_t *A, s21_sparse_t *B, s21_sparse_t *result) {
+  if (is_correct_sparse(A) != OK || is_correct_sparse(B) != OK) {
+    return INCORRECT_MATRIX;
+  }
+  if (A->rows != B->rows || A->columns != B->columns) return CALC_ERROR;
+
+  s21_sparse_t converted = {0};
+  int res = OK;
+  if (B->format != A->format) {
+    res = regroup(B, A->format, B->rows, B->columns, &converted);
+    B = &converted;
+  }
+
+  int major = major_size(A);
+  size_t nonzeros = 0;
+  for (int g = 0; g < major && res == OK; g++) {
+    nonzeros += merge_groups(A, B, g, NULL, 0);
+  }
+  if (res == OK) {
+    res = s21_create_sparse(A->rows, A->columns, nonzeros, A->format, result);
+  }
+  for (int g = 0; g < major && res == OK; g++) {
+    result->offsets[g + 1] =
+        result->offsets[g] + merge_groups(A, B, g, result, result->offsets[g]);
+  }
+  s21_remove_sparse(&converted);
+
+  int bad = 0;
+  for (size_t e = 0; e < nonzeros && res == OK; e++) {
+    bad |= !isfinite(result->values[e]);
+  }
+  return bad ? CALC_ERROR : res;
+}
+
+typedef struct sparse_task {
+  const s21_sparse_t *a;
+  double *const *b;
+  double **c;
+  const double *x;
+  double *y;
+  int k;
+  int *bounds;
+  int *status;
+} sparse_task;
+
+/**
+ * Функция sparse_task_run считает часть произведения. Для CSR задача
+ * отвечает за строки bounds[index]..bounds[index + 1] - 1 результата и
+ * вычисляет каждую строку целиком; для CSC — за тот же диапазон столбцов
+ * плотного множителя и результата и разбрасывает вклады столбцов A.
+ */
+static void sparse_task_run(void *arg, int index) {
+  sparse_task *t = arg;
+  const s21_sparse_t *a = t->a;
+  int first = t->bounds[index], last = t->bounds[index + 1];
+  int bad = 0;
+
+  if (a->format == SPARSE_CSR && t->x != NULL) {
+    for (int i = first; i < last; i++) {
+      double sum = 0;
+      for (size_t e = a->offsets[i]; e < a->offsets[i + 1]; e++) {
+        sum += a->values[e] * t->x[a->indices[e]];
+      }
+      t->y[i] = sum;
+      bad |= !isfinite(sum);
+    }
+  } else if (a->format == SPARSE_CSR) {
+    int width = t->k;
+    for (int i = first; i < last; i++) {
+      double *row = t->c[i];
+      memset(row, 0, sizeof(double) * width);
+      for (size_t e = a->offsets[i]; e < a->offsets[i + 1]; e++) {
+        double value = a->values[e];
+        const double *b_row = t->b[a->indices[e]];
+        for (int j = 0; j < width; j++) row[j] += value * b_row[j];
+      }
+      for (int j = 0; j < width; j++) bad |= !isfinite(row[j]);
+    }
+  } else if (t->x != NULL) {
+    memset(t->y, 0, sizeof(double) * a->rows);
+    for (int j = 0; j < a->columns; j++) {
+      double x_j = t->x[j];
+      for (size_t e = a->offsets[j]; e < a->offsets[j + 1]; e++) {
+        t->y[a->indices[e]] += a->values[e] * x_j;
+      }
+    }
+    for (int i = 0; i < a->rows; i++) bad |= !isfinite(t->y[i]);
+  } else {
+    int width = last - first;
+    for (int i = 0; i < a->rows; i++) {
+      memset(t->c[i] + first, 0, sizeof(double) * width);
+    }
+    for (int p = 0; p < a->columns; p++) {
+      const double *b_row = t->b[p] + first;
+      for (size_t e = a->offsets[p]; e < a->offsets[p + 1]; e++) {
+        double value = a->values[e];
+        double *row = t->c[a->indices[e]] + first;
+        for (int j = 0; j < width; j++) row[j] += value * b_row[j];
+      }
+    }
+    for (int i = 0; i < a->rows; i++) {
+      for (int j = 0; j < width; j++) bad |= !isfinite(t->c[i][first + j]);
+    }
+  }
+  t->status[index] = bad ? CALC_ERROR : OK;
+}
+
+/**
+ * Функция sparse_multiply делит произведение на задачи и выполняет их на пуле
+ * потоков, если объём работы (2 * nonzeros * k операций) не меньше порога
+ * s21_set_parallel_threshold. Строки CSR делятся так, чтобы в задачах было
+ * примерно поровну ненулевых элементов; у CSC делятся столбцы плотного
+ * множителя, а произведение на вектор выполняется одной задачей.
+ */
+static int sparse_multiply(sparse_task *t) {
+  const s21_sparse_t *a = t->a;
+  int csr = a->format == SPARSE_CSR;
+  int span = csr ? a->rows : t->k;
+  int threads = pool_threads(2.0 * a->nonzeros * t->k);
+  int tasks = threads > 1 ? threads * SPARSE_TASKS_PER_THREAD : 1;
+  if (tasks > span) tasks = span;
+
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  t->bounds = arena_alloc(arena, sizeof(int) * (2 * tasks + 1));
+  if (t->bounds == NULL) return CALC_ERROR;
+  t->status = t->bounds + tasks + 1;
+
+  t->bounds[0] = 0;
+  for (int task = 1; task < tasks; task++) {
+    int bound = t->bounds[task - 1];
+    if (csr) {
+      size_t target = a->nonzeros / tasks * task;
+      while (bound < a->rows && a->offsets[bound] < target) bound++;
+    } else {
+      bound = (int)((long long)span * task / tasks);
+    }
+    t->bounds[task] = bound;
+  }
+  t->bounds[tasks] = span;
+
+  pool_run(sparse_task_run, t, tasks);
+  int res = OK;
+  for (int task = 0; task < tasks; task++) {
+    if (t->status[task] != OK) res = CALC_ERROR;
+  }
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+/**
+ * Функция s21_sparse_mult_vector вычисляет y = A * x.
+ *
+ * @param x Массив из A->columns элементов.
+ * @param y Массив из A->rows элементов для результата; не должен пересекаться
+ * с x.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A неверна или указатели равны NULL,
+ * или `CALC_ERROR`, если в результате есть бесконечность или NaN.
+ */
+int s21_sparse_mult_vector(s21_sparse_t *A, const double *x, double *y) {
+  if (is_correct_sparse(A) != OK || x == NULL || y == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  sparse_task t = {A, NULL, NULL, x, y, 1, NULL, NULL};
+  return sparse_multiply(&t);
+}
+
+/**
+ * Функция s21_sparse_mult_dense_into вычисляет произведение разреженной
+ * матрицы A на плотную матрицу B и записывает его в уже созданную матрицу
+ * result размером A->rows x B->columns, которая не должна совпадать с B.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одна из матриц неверна, или
+ * `CALC_ERROR`, если размеры не совпадают или в результате есть бесконечность
+ * или NaN.
+ */
+int s21_sparse_mult_dense_into(s21_sparse_t *A, matrix_t *B,
+                               matrix_t *result) {
+  if (is_correct_sparse(A) != OK || is_correct_matrix(B) != OK) {
+    return INCORRECT_MATRIX;
+  }
+  if (A->columns != B->rows) return CALC_ERROR;
+  int res = check_output(result, A->rows, B->columns);
+  if (res == OK) {
+    sparse_task t = {A,    B->matrix, result->matrix, NULL,
+                     NULL, B->columns, NULL,          NULL};
+    res = sparse_multiply(&t);
+  }
+  return res;
+}
+
+/**
+ * Функция s21_sparse_mult_dense вычисляет произведение разреженной матрицы A
+ * на плотную матрицу B так же, как s21_sparse_mult_dense_into, создавая для
+ * результата новую матрицу result.
+ *
+ * @return Коды ошибок такие же, как у s21_sparse_mult_dense_into. Если
+ * размеры не совпадают, result не создаётся.
+ */
+int s21_sparse_mult_dense(s21_sparse_t *A, matrix_t *B, matrix_t *result) {
+  if (is_correct_sparse(A) != OK || is_correct_matrix(B) != OK ||
+      result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  if (A->columns != B->rows) return CALC_ERROR;
+  int res = s21_create_matrix(A->rows, B->columns, result);
+  if (res == OK) res = s21_sparse_mult_dense_into(A, B, result);
+  return res;
+}
@@ -0,0 +1,221 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "s21_internal.h"
+
+/*
+ * Счётчики вызовов собираются, только если библиотека собрана с
+ * -DS21_INSTRUMENT: тогда макрос PROBE в начале функции заводит локальную
+ * переменную, а при любом выходе из функции cleanup-обработчик probe_finish
+ * записывает время, байты и количество операций. Без флага макросы пусты, а
+ * функции этого файла возвращают нули, так что код пользователя собирается
+ * одинаково в обоих режимах.
+ *
+ * Каждый поток пишет только в свой блок счётчиков: атомарные чтение и запись
+ * с memory_order_relaxed компилируются в обычные mov, без блокировок и
+ * lock-префиксов. Блок регистрируется в общем списке при первом вызове
+ * в потоке (единственное место с мьютексом) и живёт до конца программы,
+ * поэтому s21_stats_snapshot суммирует и счётчики завершившихся потоков.
+ */
+
+#define STATS_FIELDS (5 + STATS_BUCKETS)
+
+static const char *const probe_names[PROBE_COUNT] = {
+    "s21_create_matrix", "s21_sum_matrix",      "s21_sub_matrix",
+    "s21_mult_number",   "s21_mult_matrix",     "s21_transpose",
+    "s21_determinant",   "s21_calc_complements", "s21_inverse_matrix",
+    "s21_solve"};
+
+static _Atomic(s21_trace_hook) trace_hook;
+static _Atomic(void *) trace_user;
+
+/**
+ * Функция s21_probe_name возвращает имя функции, которой соответствует
+ * счётчик probe, или NULL для неизвестного номера.
+ */
+const char *s21_probe_name(s21_probe probe) {
+  return probe >= 0 && probe < PROBE_COUNT ? probe_names[probe] : NULL;
+}
+
+/**
+ * Функция s21_set_trace_hook регистрирует функцию hook, которая вызывается с
+ * аргументом user в начале (TRACE_BEGIN) и в конце (TRACE_END) каждой
+ * отслеживаемой функции в том потоке, который её выполняет. NULL отключает
+ * вызовы. Время самого hook в задержку функции не входит. Менять hook, пока
+ * другие потоки вызывают библиотеку, не следует: они могут получить новую
+ * функцию со старым user. Без S21_INSTRUMENT hook не вызывается.
+ */
+void s21_set_trace_hook(s21_trace_hook hook, void *user) {
+  atomic_store(&trace_user, user);
+  atomic_store(&trace_hook, hook);
+}
+
+#ifdef S21_INSTRUMENT
+typedef struct thread_stats {
+  struct thread_stats *next;
+  _Atomic unsigned long long values[PROBE_COUNT][STATS_FIELDS];
+} thread_stats;
+
+static thread_stats *all_stats;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static _Thread_local thread_stats *local_stats;
+
+static unsigned long long now_ns(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (unsigned long long)time.tv_sec * 1000000000ull + time.tv_nsec;
+}
+
+static thread_stats *thread_block(void) {
+  if (local_stats == NULL) {
+    local_stats = calloc(1, sizeof(thread_stats));
+    if (local_stats != NULL) {
+      pthread_mutex_lock(&stats_lock);
+      local_stats->next = all_stats;
+      all_stats = local_stats;
+      pthread_mutex_unlock(&stats_lock);
+    }
+  }
+  return local_stats;
+}
+
+static void add(_Atomic unsigned long long *counter, unsigned long long value) {
+  atomic_store_explicit(
+      counter, atomic_load_explicit(counter, memory_order_relaxed) + value,
+      memory_order_relaxed);
+}
+
+probe_t probe_begin(s21_probe id) {
+  s21_trace_hook hook = atomic_load_explicit(&trace_hook, memory_order_acquire);
+  if (hook != NULL) hook(id, TRACE_BEGIN, atomic_load(&trace_user));
+  return (probe_t){id, now_ns(), 0, 0};
+}
+
+/**
+ * Функция probe_finish записывает результаты вызова в счётчики потока:
+ * количество вызовов, суммарную и максимальную задержку, байты, операции и
+ * гистограмму задержек. Корзина b гистограммы считает вызовы длительностью
+ * от 2^(b - 1) до 2^b наносекунд, последняя — все более долгие.
+ */
+void probe_finish(probe_t *probe) {
+  unsigned long long elapsed = now_ns() - probe->start;
+  thread_stats *stats = thread_block();
+  if (stats != NULL) {
+    _Atomic unsigned long long *values = stats->values[probe->id];
+    add(&values[0], 1);
+    add(&values[1], elapsed);
+    if (elapsed > atomic_load_explicit(&values[2], memory_order_relaxed)) {
+      atomic_store_explicit(&values[2], elapsed, memory_order_relaxed);
+    }
+    add(&values[3], probe->bytes);
+    add(&values[4], (unsigned long long)probe->flops);
+    int bucket = elapsed ? 64 - __builtin_clzll(elapsed) : 0;
+    add(&values[5 + (bucket < STATS_BUCKETS ? bucket : STATS_BUCKETS - 1)],
+        1);
+  }
+  s21_trace_hook hook = atomic_load_explicit(&trace_hook, memory_order_acquire);
+  if (hook != NULL) hook(probe->id, TRACE_END, atomic_load(&trace_user));
+}
+#endif
+
+/**
+ * Функция s21_stats_snapshot суммирует счётчики всех потоков в массив result
+ * из PROBE_COUNT элементов (в порядке s21_probe). Вызовы, идущие во время
+ * снимка, могут попасть в него частично. Без S21_INSTRUMENT все счётчики
+ * равны нулю.
+ *
+ * @return `OK` или `INCORRECT_MATRIX`, если result равен NULL.
+ */
+int s21_stats_snapshot(s21_stats_t *result) {
+  if (result == NULL) return INCORRECT_MATRIX;
+  memset(result, 0, sizeof(s21_stats_t) * PROBE_COUNT);
+#ifdef S21_INSTRUMENT
+  pthread_mutex_lock(&stats_lock);
+  for (thread_stats *stats = all_stats; stats != NULL; stats = stats->next) {
+    for (int p = 0; p < PROBE_COUNT; p++) {
+      unsigned long long values[STATS_FIELDS];
+      for (int f = 0; f < STATS_FIELDS; f++) {
+        values[f] =
+            atomic_load_explicit(&stats->values[p][f], memory_order_relaxed);
+      }
+      result[p].calls += values[0];
+      result[p].total_ns += values[1];
+      if (values[2] > result[p].max_ns) result[p].max_ns = values[2];
+      result[p].bytes += values[3];
+      result[p].flops += values[4];
+      for (int b = 0; b < STATS_BUCKETS; b++) {
+        result[p].histogram[b] += values[5 + b];
+      }
+    }
+  }
+  pthread_mutex_unlock(&stats_lock);
+#endif
+  return OK;
+}
+
+/**
+ * Функция s21_stats_reset обнуляет счётчики всех потоков. Вызовы, идущие во
+ * время сброса, могут остаться в счётчиках частично.
+ */
+void s21_stats_reset(void) {
+#ifdef S21_INSTRUMENT
+  pthread_mutex_lock(&stats_lock);
+  for (thread_stats *stats = all_stats; stats != NULL; stats = stats->next) {
+    for (int p = 0; p < PROBE_COUNT; p++) {
+      for (int f = 0; f < STATS_FIELDS; f++) {
+        atomic_store_explicit(&stats->values[p][f], 0, memory_order_relaxed);
+      }
+    }
+  }
+  pthread_mutex_unlock(&stats_lock);
+#endif
+}
+
+static void append(char *buffer, size_t size, size_t *length,
+                   const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int written = vsnprintf(*length < size ? buffer + *length : NULL,
+                          *length < size ? size - *length : 0, format, args);
+  va_end(args);
+  if (written > 0) *length += written;
+}
+
+/**
+ * Функция s21_stats_json записывает снимок счётчиков (s21_stats_snapshot) в
+ * buffer в виде JSON: {"enabled": ..., "functions": {"s21_...": {"calls",
+ * "total_ns", "max_ns", "bytes", "flops", "histogram_ns"}}}. Как и snprintf,
+ * записывает не больше size байт, включая завершающий ноль, и возвращает
+ * полную длину текста, так что размер буфера можно узнать вызовом с
+ * size = 0.
+ */
+size_t s21_stats_json(char *buffer, size_t size) {
+  s21_stats_t stats[PROBE_COUNT];
+  s21_stats_snapshot(stats);
+  int enabled = 0;
+#ifdef S21_INSTRUMENT
+  enabled = 1;
+#endif
+  size_t length = 0;
+  append(buffer, size, &length, "{\"enabled\": %s, \"functions\": {",
+         enabled ? "true" : "false");
+  for (int p = 0; p < PROBE_COUNT; p++) {
+    append(buffer, size, &length,
+           "%s\"%s\": {\"calls\": %llu, \"total_ns\": %llu, \"max_ns\": %llu, "
+           "\"bytes\": %llu, \"flops\": %llu, \"histogram_ns\": [",
+           p ? ", " : "", probe_names[p], stats[p].calls, stats[p].total_ns,
+           stats[p].max_ns, stats[p].bytes, stats[p].flops);
+    for (int b = 0; b < STATS_BUCKETS; b++) {
+      append(buffer, size, &length, "%s%llu", b ? ", " : "",
+             stats[p].histogram[b]);
+    }
+    append(buffer, size, &length, "]}");
+  }
+  append(buffer, size, &length, "}}\n");
+  return length;
+}
@@ -0,0 +1,196 @@
+#include <stdatomic.h>
+#include <string.h>
+
+#include "s21_internal.h"
+
+#define STRASSEN_MIN_ORDER 16
+
+static _Atomic int crossover = STRASSEN_DEFAULT_CROSSOVER;
+
+/**
+ * Функция s21_set_strassen_crossover задаёт порядок, начиная с которого
+ * квадратные произведения в s21_mult_matrix и s21_mult_matrix_into считаются
+ * алгоритмом Штрассена-Винограда. Рекурсия делит матрицу пополам, пока порядок
+ * не меньше order, так что базовые произведения имеют порядок от order / 2 до
+ * order. Значения меньше STRASSEN_MIN_ORDER увеличиваются до него.
+ *
+ * Порог по умолчанию выбран замером: при n = 1024 один уровень рекурсии
+ * медленнее обычного умножения (0.385 с против 0.345 с), при n = 2048 —
+ * быстрее (2.15 с против 2.53 с).
+ *
+ * @param order Порог; 0 выключает алгоритм, по умолчанию
+ * STRASSEN_DEFAULT_CROSSOVER.
+ */
+void s21_set_strassen_crossover(int order) {
+  if (order > 0 && order < STRASSEN_MIN_ORDER) order = STRASSEN_MIN_ORDER;
+  atomic_store(&crossover, order < 0 ? 0 : order);
+}
+
+/**
+ * Функция s21_get_strassen_crossover возвращает порог, заданный
+ * s21_set_strassen_crossover.
+ */
+int s21_get_strassen_crossover(void) { return atomic_load(&crossover); }
+
+/**
+ * Функция use_strassen сообщает, стоит ли считать произведение m x k на
+ * k x n через strassen_kernel.
+ */
+int use_strassen(int m, int n, int k) {
+  int order = atomic_load_explicit(&crossover, memory_order_relaxed);
+  return order > 0 && m == n && n == k && n >= order;
+}
+
+/**
+ * Функция shifted возвращает из арены массив count указателей rows[i] + column,
+ * то есть строки подматрицы, начинающейся со столбца column.
+ */
+static double **shifted(arena_t *arena, double *const *rows, int count,
+                        int column) {
+  double **result = arena_alloc(arena, sizeof(double *) * count);
+  if (result != NULL) {
+    for (int i = 0; i < count; i++) result[i] = rows[i] + column;
+  }
+  return result;
+}
+
+static double **temporary(arena_t *arena, int order) {
+  double *data = arena_alloc(arena, sizeof(double) * order * order);
+  double **rows = arena_alloc(arena, sizeof(double *) * order);
+  if (data == NULL || rows == NULL) return NULL;
+  for (int i = 0; i < order; i++) rows[i] = data + (size_t)i * order;
+  return rows;
+}
+
+/**
+ * Функция combine записывает в r поэлементную сумму или разность (op равна
+ * simd_add или simd_sub) квадратных блоков x и y порядка order.
+ *
+ * @return 1, если в результате есть бесконечность или NaN, иначе 0.
+ */
+static int combine(int (*op)(const double *, const double *, double *, size_t),
+                   double *const *x, double *const *y, double **r,
+                   int order) {
+  int bad = 0;
+  for (int i = 0; i < order; i++) bad |= op(x[i], y[i], r[i], order);
+  return bad;
+}
+
+static int winograd(int n, double *const *a, double *const *b, double **c);
+
+/**
+ * Функция product записывает в c произведение a * b квадратных матриц порядка
+ * n: рекурсией Винограда, если n не меньше порога, иначе блочным gemm_kernel.
+ */
+static int product(int n, double *const *a, double *const *b, double **c) {
+  int order = atomic_load_explicit(&crossover, memory_order_relaxed);
+  if (order > 0 && n >= order) return winograd(n, a, b, c);
+  for (int i = 0; i < n; i++) memset(c[i], 0, sizeof(double) * n);
+  return gemm_kernel(n, n, n, a, b, c);
+}
+
+/**
+ * Функция peel досчитывает произведение нечётного порядка n = 2h + 1, когда
+ * блок C[0:2h, 0:2h] уже равен A[0:2h, 0:2h] * B[0:2h, 0:2h]: прибавляет к
+ * нему внешнее произведение последнего столбца A и последней строки B и
+ * считает последний столбец и последнюю строку C обычным умножением.
+ */
+static int peel(arena_t *arena, int n, double *const *a, double *const *b,
+                double **c) {
+  int even = n - 1;
+  double **a_last = shifted(arena, a, even, even);
+  double **b_last = shifted(arena, b, n, even);
+  double **c_last = shifted(arena, c, n, even);
+  if (a_last == NULL || b_last == NULL || c_last == NULL) return CALC_ERROR;
+
+  int bad = gemm_kernel(even, even, 1, a_last, b + even, c) != OK;
+  for (int i = 0; i < n; i++) c_last[i][0] = 0;
+  memset(c[even], 0, sizeof(double) * even);
+  bad |= gemm_kernel(n, 1, n, a, b_last, c_last) != OK;
+  bad |= gemm_kernel(1, even, n, a + even, b, c + even) != OK;
+  return bad ? CALC_ERROR : OK;
+}
+
+/**
+ * Функция winograd выполняет один шаг алгоритма Штрассена-Винограда: семь
+ * произведений блоков порядка h = n / 2 и пятнадцать сложений. Порядок
+ * вычислений взят из расписания Дугласа и др. (DGEFMM): кроме квадрантов C
+ * нужны только два временных блока X и Y размером h x h. Нечётный порядок
+ * обрабатывается отсечением последних строки и столбца (peel).
+ *
+ * Обозначения: S1 = A21 + A22, S2 = S1 - A11, S3 = A11 - A21, S4 = A12 - S2,
+ * T1 = B12 - B11, T2 = B22 - T1, T3 = B22 - B12, T4 = T2 - B21,
+ * P1 = A11 B11, P2 = A12 B21, P3 = S4 B22, P4 = A22 T4, P5 = S1 T1,
+ * P6 = S2 T2, P7 = S3 T3. Тогда C11 = P1 + P2, C12 = U2 + P5 + P3,
+ * C21 = U3 - P4, C22 = U3 + P5, где U2 = P1 + P6, U3 = U2 + P7.
+ */
+static int winograd(int n, double *const *a, double *const *b, double **c) {
+  int h = n / 2;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  double **quadrants[12] = {NULL};
+  double *const *matrices[3] = {a, b, c};
+  for (int q = 0; q < 12; q++) {
+    double *const *rows = matrices[q / 4] + (q % 4 >= 2 ? h : 0);
+    quadrants[q] = shifted(arena, rows, h, q % 2 ? h : 0);
+  }
+  double **x = temporary(arena, h), **y = temporary(arena, h);
+  int bad = (x == NULL || y == NULL);
+  for (int q = 0; q < 12; q++) bad |= quadrants[q] == NULL;
+  if (bad) {
+    s21_arena_release(arena, mark);
+    return CALC_ERROR;
+  }
+
+  double **a11 = quadrants[0], **a12 = quadrants[1], **a21 = quadrants[2],
+         **a22 = quadrants[3], **b11 = quadrants[4], **b12 = quadrants[5],
+         **b21 = quadrants[6], **b22 = quadrants[7], **c11 = quadrants[8],
+         **c12 = quadrants[9], **c21 = quadrants[10], **c22 = quadrants[11];
+  bad |= combine(simd_sub, a11, a21, x, h);
+  bad |= combine(simd_sub, b22, b12, y, h);
+  bad |= product(h, x, y, c21) != OK;
+  bad |= combine(simd_add, a21, a22, x, h);
+  bad |= combine(simd_sub, b12, b11, y, h);
+  bad |= product(h, x, y, c22) != OK;
+  bad |= combine(simd_sub, x, a11, x, h);
+  bad |= combine(simd_sub, b22, y, y, h);
+  bad |= product(h, x, y, c12) != OK;
+  bad |= combine(simd_sub, a12, x, x, h);
+  bad |= product(h, x, b22, c11) != OK;
+  bad |= product(h, a11, b11, x) != OK;
+  bad |= combine(simd_add, x, c12, c12, h);
+  bad |= combine(simd_add, c12, c21, c21, h);
+  bad |= combine(simd_add, c12, c22, c12, h);
+  bad |= combine(simd_add, c21, c22, c22, h);
+  bad |= combine(simd_add, c12, c11, c12, h);
+  bad |= combine(simd_sub, y, b21, y, h);
+  bad |= product(h, a22, y, c11) != OK;
+  bad |= combine(simd_sub, c21, c11, c21, h);
+  bad |= product(h, a12, b21, c11) != OK;
+  bad |= combine(simd_add, x, c11, c11, h);
+
+  if (n % 2) bad |= peel(arena, n, a, b, c) != OK;
+  s21_arena_release(arena, mark);
+  return bad ? CALC_ERROR : OK;
+}
+
+/**
+ * Функция strassen_kernel записывает в C произведение квадратных матриц A и B
+ * порядка n алгоритмом Штрассена-Винограда: 7 умножений блоков вместо 8 на
+ * каждом уровне рекурсии, так что при n = 4096 и пороге 2048 (два уровня)
+ * умножений почти на четверть меньше. Базовые блоки умножает gemm_kernel (с
+ * пулом потоков, если он включён). Временные блоки берутся из арены потока,
+ * всего около 2 * n * n / 3 элементов.
+ *
+ * Погрешность выше, чем у обычного умножения: оценка нормы ошибки растёт
+ * примерно в 18 раз на каждый уровень рекурсии (Higham, 2002, гл. 23), а
+ * промежуточные суммы могут переполниться там, где обычное произведение
+ * конечно.
+ *
+ * @return `OK` или `CALC_ERROR`, если не удалось выделить временные блоки или
+ * в результате либо промежуточных суммах появилась бесконечность или NaN.
+ */
+int strassen_kernel(int n, double *const *a, double *const *b, double **c) {
+  return product(n, a, b, c);
+}
@@ -0,0 +1,540 @@
+#include <string.h>
+
+#include "s21_internal.h"
+
+/*
+ * Структурированные матрицы хранят только элементы, которые могут быть
+ * ненулевыми, построчно:
+ * - STRUCTURE_SYMMETRIC и STRUCTURE_LOWER — нижний треугольник, строка i
+ *   занимает i + 1 элементов с позиции i * (i + 1) / 2;
+ * - STRUCTURE_UPPER — верхний треугольник, строка i занимает size - i
+ *   элементов начиная с диагонали;
+ * - STRUCTURE_BANDED — по lower + upper + 1 элементов на строку, элемент
+ *   (i, j) лежит в data[i * (lower + upper + 1) + j - i + lower]; ячейки за
+ *   пределами матрицы в первых и последних строках остаются нулями.
+ * Поэтому ненулевая часть каждой строки — непрерывный отрезок (row_segment),
+ * и ядра работают с ним векторными simd_dot и simd_axpy, не трогая нули.
+ */
+
+#define BAND_AT(w, width, kl, i, j) \
+  (w)[(size_t)(i) * (width) + (j) - (i) + (kl)]
+
+static int is_correct_structured(const s21_structured_t *S) {
+  return S == NULL || S->data == NULL || S->size < 1 || S->lower < 0 ||
+                 S->upper < 0 || S->kind < STRUCTURE_SYMMETRIC ||
+                 S->kind > STRUCTURE_BANDED
+             ? INCORRECT_MATRIX
+             : OK;
+}
+
+static size_t structured_elements(const s21_structured_t *S) {
+  size_t n = S->size;
+  return S->kind == STRUCTURE_BANDED ? n * (S->lower + S->upper + 1)
+                                     : n * (n + 1) / 2;
+}
+
+/**
+ * Функция row_segment возвращает указатель на хранимую часть строки i и
+ * записывает в first номер её первого столбца, а в count — длину. Для
+ * симметричной матрицы это часть строки до диагонали включительно.
+ */
+static double *row_segment(const s21_structured_t *S, int i, int *first,
+                           int *count) {
+  size_t n = S->size;
+  double *row = NULL;
+  if (S->kind == STRUCTURE_UPPER) {
+    *first = i;
+    *count = S->size - i;
+    row = S->data + i * n - (size_t)i * (i - 1) / 2;
+  } else if (S->kind == STRUCTURE_BANDED) {
+    *first = i - S->lower > 0 ? i - S->lower : 0;
+    int last = i + S->upper < S->size ? i + S->upper : S->size - 1;
+    *count = last - *first + 1;
+    row = &BAND_AT(S->data, S->lower + S->upper + 1, S->lower, i, *first);
+  } else {
+    *first = 0;
+    *count = i + 1;
+    row = S->data + (size_t)i * (i + 1) / 2;
+  }
+  return row;
+}
+
+/**
+ * Функция element_at возвращает адрес хранимого элемента (i, j) или NULL,
+ * если элемент вне структуры и равен нулю. Для симметричной матрицы элемент
+ * над диагональю берётся из симметричной позиции.
+ */
+static double *element_at(const s21_structured_t *S, int i, int j) {
+  if (S->kind == STRUCTURE_SYMMETRIC && j > i) {
+    int swap = i;
+    i = j;
+    j = swap;
+  }
+  int first = 0, count = 0;
+  double *row = row_segment(S, i, &first, &count);
+  return j >= first && j < first + count ? row + j - first : NULL;
+}
+
+/**
+ * Функция s21_create_structured создаёт нулевую структурированную матрицу
+ * порядка size. Ширины ленты lower (поддиагонали) и upper (наддиагонали)
+ * учитываются только для STRUCTURE_BANDED и ограничиваются size - 1; для
+ * остальных видов они заполняются по виду матрицы.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если параметры неверны, или
+ * `CALC_ERROR`, если не удалось выделить память.
+ */
+int s21_create_structured(int size, structure_kind kind, int lower, int upper,
+                          s21_structured_t *result) {
+  if (result == NULL || size < 1 || kind < STRUCTURE_SYMMETRIC ||
+      kind > STRUCTURE_BANDED ||
+      (kind == STRUCTURE_BANDED && (lower < 0 || upper < 0))) {
+    return INCORRECT_MATRIX;
+  }
+  if (kind != STRUCTURE_BANDED) {
+    lower = kind == STRUCTURE_UPPER ? 0 : size - 1;
+    upper = kind == STRUCTURE_LOWER ? 0 : size - 1;
+  }
+  s21_structured_t S = {kind, NULL, size, lower < size ? lower : size - 1,
+                        upper < size ? upper : size - 1};
+  S.data = calloc(structured_elements(&S), sizeof(double));
+  if (S.data == NULL) return CALC_ERROR;
+  *result = S;
+  return OK;
+}
+
+/**
+ * Функция s21_remove_structured освобождает структурированную матрицу.
+ */
+void s21_remove_structured(s21_structured_t *S) {
+  if (S != NULL && S->data != NULL) {
+    free(S->data);
+    S->data = NULL;
+  }
+}
+
+/**
+ * Функция s21_structured_from_dense создаёт структурированную матрицу вида
+ * kind из квадратной матрицы A. Берутся только элементы, входящие в
+ * структуру (для симметричной — нижний треугольник), остальные
+ * предполагаются нулевыми или симметричными и не проверяются.
+ *
+ * @return Коды s21_create_structured; `CALC_ERROR` также возвращается, если
+ * A не квадратная.
+ */
+int s21_structured_from_dense(matrix_t *A, structure_kind kind, int lower,
+                              int upper, s21_structured_t *result) {
+  if (is_correct_matrix(A) != OK) return INCORRECT_MATRIX;
+  if (A->rows != A->columns) return CALC_ERROR;
+  int res = s21_create_structured(A->rows, kind, lower, upper, result);
+  for (int i = 0; i < A->rows && res == OK; i++) {
+    int first = 0, count = 0;
+    double *row = row_segment(result, i, &first, &count);
+    memcpy(row, A->matrix[i] + first, sizeof(double) * count);
+  }
+  return res;
+}
+
+/**
+ * Функция s21_structured_to_dense создаёт плотную матрицу, равную S.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если S неверна или result равен NULL, или
+ * `CALC_ERROR`, если не удалось выделить память.
+ */
+int s21_structured_to_dense(s21_structured_t *S, matrix_t *result) {
+  if (is_correct_structured(S) != OK || result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  int res = s21_create_matrix(S->size, S->size, result);
+  for (int i = 0; i < S->size && res == OK; i++) {
+    int first = 0, count = 0;
+    const double *row = row_segment(S, i, &first, &count);
+    memcpy(result->matrix[i] + first, row, sizeof(double) * count);
+    if (S->kind == STRUCTURE_SYMMETRIC) {
+      for (int j = 0; j < i; j++) result->matrix[j][i] = row[j];
+    }
+  }
+  return res;
+}
+
+static int check_rows(double *const *rows, int count, int length) {
+  int bad = 0;
+  for (int i = 0; i < count; i++) bad |= !isfinite(simd_amax(rows[i], length));
+  return bad ? CALC_ERROR : OK;
+}
+
+/**
+ * Функция s21_structured_mult_vector записывает в y произведение S * x.
+ * Читается только хранимая часть S: каждая строка — одно скалярное
+ * произведение её отрезка на x, а для симметричной матрицы тот же отрезок
+ * сразу прибавляется к y как столбец (y[0..i) += x[i] * S[i][0..i)).
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если S или вектор неверны, или
+ * `CALC_ERROR`, если длины не совпадают, x и y перекрываются или в результате
+ * есть бесконечность или NaN.
+ */
+int s21_structured_mult_vector(s21_structured_t *S, vector_t *x,
+                               vector_t *y) {
+  if (is_correct_structured(S) != OK || x == NULL || x->data == NULL ||
+      y == NULL || y->data == NULL) {
+    return INCORRECT_MATRIX;
+  } else if (x->size != S->size || y->size != S->size ||
+             (x->data < y->data + y->size && y->data < x->data + x->size)) {
+    return CALC_ERROR;
+  }
+  for (int i = 0; i < S->size; i++) {
+    int first = 0, count = 0;
+    const double *row = row_segment(S, i, &first, &count);
+    y->data[i] = simd_dot(row, x->data + first, count);
+    if (S->kind == STRUCTURE_SYMMETRIC) {
+      simd_axpy(x->data[i], row, y->data, i);
+    }
+  }
+  return check_rows(&y->data, 1, y->size);
+}
+
+/**
+ * Функция s21_structured_mult_dense создаёт матрицу result = S * B, где B
+ * имеет S->size строк. Каждый хранимый элемент S[i][j] прибавляет строку
+ * B[j], умноженную на него, к строке result[i] (для симметричной матрицы
+ * элемент под диагональью ещё и B[i] к result[j]), так что работа
+ * пропорциональна числу хранимых элементов.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если S или B неверны либо result равен
+ * NULL, или `CALC_ERROR`, если размеры не подходят или в результате есть
+ * бесконечность или NaN.
+ */
+int s21_structured_mult_dense(s21_structured_t *S, matrix_t *B,
+                              matrix_t *result) {
+  if (is_correct_structured(S) != OK || is_correct_matrix(B) != OK ||
+      result == NULL) {
+    return INCORRECT_MATRIX;
+  } else if (B->rows != S->size) {
+    return CALC_ERROR;
+  }
+  int res = s21_create_matrix(S->size, B->columns, result);
+  int m = B->columns;
+  for (int i = 0; i < S->size && res == OK; i++) {
+    int first = 0, count = 0;
+    const double *row = row_segment(S, i, &first, &count);
+    for (int j = 0; j < count; j++) {
+      simd_axpy(row[j], B->matrix[first + j], result->matrix[i], m);
+      if (S->kind == STRUCTURE_SYMMETRIC && j < i) {
+        simd_axpy(row[j], B->matrix[i], result->matrix[j], m);
+      }
+    }
+  }
+  if (res == OK) res = check_rows(result->matrix, S->size, m);
+  return res;
+}
+
+/**
+ * Функция packed_cholesky выполняет на месте разложение Холецкого
+ * S = L * L^T симметричной матрицы в упакованном нижнем треугольнике l
+ * порядка n. Строки L и S хранятся одинаково, поэтому каждый элемент — одно
+ * скалярное произведение уже готовых отрезков строк.
+ *
+ * @return `OK` или `CALC_ERROR`, если матрица не положительно определена.
+ */
+static int packed_cholesky(double *l, int n) {
+  for (int i = 0; i < n; i++) {
+    double *row_i = l + (size_t)i * (i + 1) / 2;
+    for (int j = 0; j < i; j++) {
+      const double *row_j = l + (size_t)j * (j + 1) / 2;
+      row_i[j] = (row_i[j] - simd_dot(row_i, row_j, j)) / row_j[j];
+    }
+    double rest = row_i[i] - simd_dot(row_i, row_i, i);
+    if (!(rest > 0) || !isfinite(rest)) return CALC_ERROR;
+    row_i[i] = sqrt(rest);
+  }
+  return OK;
+}
+
+/**
+ * Функция triangular_solve решает на месте L * X = X (lower не равен нулю)
+ * или U * X = X для упакованного треугольного множителя порядка n, хранящегося
+ * как S. Если transposed не равен нулю, решается L^T * X = X по строкам L.
+ *
+ * @return `OK` или `CALC_ERROR`, если на диагонали есть ноль.
+ */
+static int triangular_solve(const s21_structured_t *S, int transposed,
+                            double **x, int m) {
+  int n = S->size, lower = S->kind != STRUCTURE_UPPER;
+  int forward = lower && !transposed;
+  for (int step = 0; step < n; step++) {
+    int i = forward ? step : n - 1 - step;
+    int first = 0, count = 0;
+    const double *row = row_segment(S, i, &first, &count);
+    double diagonal = row[i - first];
+    if (diagonal == 0) return CALC_ERROR;
+    if (transposed) {
+      simd_scale(x[i], 1 / diagonal, x[i], m);
+      for (int j = 0; j < i; j++) simd_axpy(-row[j], x[i], x[j], m);
+    } else {
+      for (int j = 0; j < count; j++) {
+        if (first + j != i) simd_axpy(-row[j], x[first + j], x[i], m);
+      }
+      simd_scale(x[i], 1 / diagonal, x[i], m);
+    }
+  }
+  return OK;
+}
+
+/**
+ * Функция band_lu строит в буфере w LU-разложение ленточной матрицы S с
+ * частичным выбором ведущего элемента (как LAPACK dgbtrf). Перестановки
+ * строк расширяют верхнюю ленту U до lower + upper, поэтому строка i буфера
+ * хранит столбцы от i - lower до i + lower + upper. Под диагональю
+ * записываются множители L, pivots[k] — строка, переставленная с k-й.
+ *
+ * @return `OK` или `CALC_ERROR`, если матрица вырождена.
+ */
+static int band_lu(const s21_structured_t *S, double *w, int *pivots,
+                   int *sign) {
+  int n = S->size, kl = S->lower, reach = S->lower + S->upper;
+  int width = 2 * kl + S->upper + 1;
+  memset(w, 0, sizeof(double) * n * width);
+  for (int i = 0; i < n; i++) {
+    int first = 0, count = 0;
+    const double *row = row_segment(S, i, &first, &count);
+    memcpy(&BAND_AT(w, width, kl, i, first), row, sizeof(double) * count);
+  }
+  *sign = 1;
+  for (int k = 0; k < n; k++) {
+    int last = k + kl < n ? k + kl : n - 1;
+    int end = k + reach < n ? k + reach : n - 1;
+    int p = k;
+    for (int i = k + 1; i <= last; i++) {
+      if (fabs(BAND_AT(w, width, kl, i, k)) >
+          fabs(BAND_AT(w, width, kl, p, k))) {
+        p = i;
+      }
+    }
+    pivots[k] = p;
+    if (BAND_AT(w, width, kl, p, k) == 0) return CALC_ERROR;
+    if (p != k) {
+      for (int j = k; j <= end; j++) {
+        double swap = BAND_AT(w, width, kl, k, j);
+        BAND_AT(w, width, kl, k, j) = BAND_AT(w, width, kl, p, j);
+        BAND_AT(w, width, kl, p, j) = swap;
+      }
+      *sign = -*sign;
+    }
+    const double *pivot_row = &BAND_AT(w, width, kl, k, k);
+    for (int i = k + 1; i <= last; i++) {
+      double *row = &BAND_AT(w, width, kl, i, k);
+      row[0] /= pivot_row[0];
+      simd_axpy(-row[0], pivot_row + 1, row + 1, end - k);
+    }
+  }
+  return OK;
+}
+
+static void band_lu_solve(const s21_structured_t *S, const double *w,
+                          const int *pivots, double **x, int m) {
+  int n = S->size, kl = S->lower, reach = S->lower + S->upper;
+  int width = 2 * kl + S->upper + 1;
+  for (int k = 0; k < n; k++) {
+    if (pivots[k] != k) {
+      for (int c = 0; c < m; c++) {
+        double swap = x[k][c];
+        x[k][c] = x[pivots[k]][c];
+        x[pivots[k]][c] = swap;
+      }
+    }
+    int last = k + kl < n ? k + kl : n - 1;
+    for (int i = k + 1; i <= last; i++) {
+      simd_axpy(-BAND_AT(w, width, kl, i, k), x[k], x[i], m);
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    int end = i + reach < n ? i + reach : n - 1;
+    for (int j = i + 1; j <= end; j++) {
+      simd_axpy(-BAND_AT(w, width, kl, i, j), x[j], x[i], m);
+    }
+    simd_scale(x[i], 1 / BAND_AT(w, width, kl, i, i), x[i], m);
+  }
+}
+
+static int diagonally_dominant(const s21_structured_t *S) {
+  int dominant = 1;
+  for (int i = 0; i < S->size && dominant; i++) {
+    const double *row = S->data + (size_t)i * 3;
+    dominant = fabs(row[1]) >= fabs(row[0]) + fabs(row[2]);
+  }
+  return dominant;
+}
+
+/**
+ * Функция thomas_solve решает на месте трёхдиагональную систему S * X = X
+ * методом прогонки (алгоритм Томаса) за O(n) без перестановок. Правых частей
+ * обычно мало, поэтому строки X обрабатываются простыми циклами без вызовов
+ * векторных ядер. Вызывается только для матриц с диагональным преобладанием,
+ * для которых прогонка устойчива.
+ *
+ * @param c Буфер из S->size элементов для прогоночных коэффициентов.
+ *
+ * @return `OK` или `CALC_ERROR`, если прогонка встретила нулевой знаменатель.
+ */
+static int thomas_solve(const s21_structured_t *S, double *c, double **x,
+                        int m) {
+  int n = S->size;
+  for (int i = 0; i < n; i++) {
+    const double *row = S->data + (size_t)i * 3;
+    double denominator = i > 0 ? row[1] - row[0] * c[i - 1] : row[1];
+    if (denominator == 0) return CALC_ERROR;
+    c[i] = row[2] / denominator;
+    for (int k = 0; k < m; k++) {
+      double previous = i > 0 ? x[i - 1][k] : 0;
+      x[i][k] = (x[i][k] - row[0] * previous) / denominator;
+    }
+  }
+  for (int i = n - 2; i >= 0; i--) {
+    for (int k = 0; k < m; k++) x[i][k] -= c[i] * x[i + 1][k];
+  }
+  return OK;
+}
+
+/**
+ * Функция structured_factor решает на месте S * X = X (если x не равен NULL)
+ * и/или записывает в determinant определитель S, используя структуру:
+ * треугольные матрицы — подстановкой, симметричные — упакованным разложением
+ * Холецкого, трёхдиагональные с диагональным преобладанием — прогонкой,
+ * остальные ленточные — ленточным LU. Прогонка выключается нулевым thomas.
+ * Вспомогательные буферы берутся из арены потока.
+ *
+ * @return `OK` (определитель вырожденной матрицы равен 0) или `CALC_ERROR`,
+ * если система вырождена или не удалось выделить память. Если симметричная
+ * матрица не положительно определена или прогонка встретила нулевой
+ * знаменатель, *fallback становится равным 1: X к этому моменту испорчена, и
+ * вызывающая функция переходит к другому алгоритму.
+ */
+static int structured_factor(const s21_structured_t *S, double **x, int m,
+                             double *determinant, int thomas, int *fallback) {
+  int n = S->size, res = OK;
+  *fallback = 0;
+  if (S->kind == STRUCTURE_LOWER || S->kind == STRUCTURE_UPPER) {
+    if (determinant != NULL) {
+      *determinant = 1;
+      for (int i = 0; i < n; i++) *determinant *= *element_at(S, i, i);
+    }
+    return x != NULL ? triangular_solve(S, 0, x, m) : OK;
+  }
+
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  if (S->kind == STRUCTURE_SYMMETRIC) {
+    size_t elements = structured_elements(S);
+    double *l = arena_alloc(arena, sizeof(double) * elements);
+    if (l != NULL) memcpy(l, S->data, sizeof(double) * elements);
+    res = l != NULL ? packed_cholesky(l, n) : CALC_ERROR;
+    s21_structured_t L = {STRUCTURE_LOWER, l, n, n - 1, 0};
+    if (res == OK && determinant != NULL) {
+      *determinant = 1;
+      for (int i = 0; i < n; i++) *determinant *= *element_at(&L, i, i);
+      *determinant *= *determinant;
+    }
+    if (res == OK && x != NULL) res = triangular_solve(&L, 0, x, m);
+    if (res == OK && x != NULL) res = triangular_solve(&L, 1, x, m);
+    *fallback = l != NULL && res != OK;
+  } else if (thomas && x != NULL && S->lower == 1 && S->upper == 1 &&
+             determinant == NULL && diagonally_dominant(S)) {
+    double *c = arena_alloc(arena, sizeof(double) * n);
+    res = c != NULL ? thomas_solve(S, c, x, m) : CALC_ERROR;
+    *fallback = c != NULL && res != OK;
+  } else {
+    int width = 2 * S->lower + S->upper + 1, sign = 1;
+    double *w = arena_alloc(arena, sizeof(double) * n * width);
+    int *pivots = arena_alloc(arena, sizeof(int) * n);
+    int allocated = w != NULL && pivots != NULL;
+    res = allocated ? band_lu(S, w, pivots, &sign) : CALC_ERROR;
+    if (allocated && determinant != NULL) {
+      *determinant = res == OK ? sign : 0;
+      for (int i = 0; i < n && res == OK; i++) {
+        *determinant *= BAND_AT(w, width, S->lower, i, i);
+      }
+      if (x == NULL) res = OK;
+    }
+    if (res == OK && x != NULL) band_lu_solve(S, w, pivots, x, m);
+  }
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+static void copy_rows(matrix_t *B, matrix_t *X) {
+  for (int i = 0; i < B->rows; i++) {
+    memcpy(X->matrix[i], B->matrix[i], sizeof(double) * B->columns);
+  }
+}
+
+/**
+ * Функция s21_structured_solve решает систему S * X = B и создаёт X.
+ * Треугольная система решается подстановкой за O(n^2) на правую часть,
+ * трёхдиагональная с диагональным преобладанием — прогонкой за O(n),
+ * ленточная — ленточным LU за O(n * lower * (lower + upper)), симметричная —
+ * упакованным разложением Холецкого. Симметричная матрица, не являющаяся
+ * положительно определённой, решается через s21_solve, а трёхдиагональная, на
+ * которой прогонка встретила нулевой знаменатель, — ленточным LU.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если S, B или X неверны, или
+ * `CALC_ERROR`, если размеры не подходят, S вырождена (тогда X не создаётся)
+ * или в решении есть бесконечность или NaN.
+ */
+int s21_structured_solve(s21_structured_t *S, matrix_t *B, matrix_t *X) {
+  if (is_correct_structured(S) != OK || is_correct_matrix(B) != OK ||
+      X == NULL) {
+    return INCORRECT_MATRIX;
+  } else if (B->rows != S->size) {
+    return CALC_ERROR;
+  }
+  int fallback = 0;
+  int res = s21_create_matrix(B->rows, B->columns, X);
+  if (res != OK) return res;
+  copy_rows(B, X);
+  res = structured_factor(S, X->matrix, B->columns, NULL, 1, &fallback);
+  if (fallback && S->kind == STRUCTURE_BANDED) {
+    copy_rows(B, X);
+    res = structured_factor(S, X->matrix, B->columns, NULL, 0, &fallback);
+  } else if (fallback) {
+    matrix_t dense = {0};
+    s21_remove_matrix(X);
+    res = s21_structured_to_dense(S, &dense);
+    if (res == OK) res = s21_solve(&dense, B, X);
+    s21_remove_matrix(&dense);
+    return res;
+  }
+  if (res == OK) {
+    res = check_rows(X->matrix, X->rows, X->columns);
+  } else {
+    s21_remove_matrix(X);
+  }
+  return res;
+}
+
+/**
+ * Функция s21_structured_determinant записывает в result определитель S:
+ * произведение диагонали для треугольных матриц, квадрат произведения
+ * диагонали множителя Холецкого для симметричных положительно определённых
+ * (остальные симметричные считаются через s21_determinant) и произведение
+ * диагонали ленточного LU для ленточных. Для вырожденной матрицы результат
+ * равен 0.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если S неверна или result равен NULL, или
+ * `CALC_ERROR`, если не удалось выделить память или определитель не конечен.
+ */
+int s21_structured_determinant(s21_structured_t *S, double *result) {
+  if (is_correct_structured(S) != OK || result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  int fallback = 0;
+  int res = structured_factor(S, NULL, 0, result, 0, &fallback);
+  if (fallback) {
+    matrix_t dense = {0};
+    res = s21_structured_to_dense(S, &dense);
+    if (res == OK) res = s21_determinant(&dense, result);
+    s21_remove_matrix(&dense);
+  }
+  if (res == OK && !isfinite(*result)) res = CALC_ERROR;
+  return res;
+}
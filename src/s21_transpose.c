@@ -0,0 +1,76 @@
+#include <string.h>
+
+#include "s21_internal.h"
+
+#define TRANSPOSE_TILE 32
+
+/**
+ * Функция transpose_blocked записывает в dst транспонированную матрицу src
+ * размером rows x cols. Матрица рекурсивно делится пополам по большей стороне,
+ * пока блок не станет не больше TRANSPOSE_TILE x TRANSPOSE_TILE; такие блоки
+ * (по 8 КБ на чтение и запись) помещаются в кэш первого уровня на любом
+ * уровне иерархии памяти, а внутри блока элементы переставляются в регистрах
+ * ядром simd_transpose. Границы деления кратны 8, чтобы векторные блоки не
+ * разрезались.
+ *
+ * @param src Указатели на строки исходной матрицы.
+ * @param i0 Первая строка обрабатываемого блока.
+ * @param j0 Первый столбец обрабатываемого блока.
+ * @param rows Количество строк блока.
+ * @param cols Количество столбцов блока.
+ * @param dst Указатели на строки результата; не должен пересекаться с src.
+ */
+void transpose_blocked(double *const *src, int i0, int j0, int rows, int cols,
+                       double **dst) {
+  if (rows <= TRANSPOSE_TILE && cols <= TRANSPOSE_TILE) {
+    simd_transpose(src, i0, j0, rows, cols, dst);
+  } else if (rows >= cols) {
+    int half = (rows / 2 + 7) & ~7;
+    transpose_blocked(src, i0, j0, half, cols, dst);
+    transpose_blocked(src, i0 + half, j0, rows - half, cols, dst);
+  } else {
+    int half = (cols / 2 + 7) & ~7;
+    transpose_blocked(src, i0, j0, rows, half, dst);
+    transpose_blocked(src, i0, j0 + half, rows, cols - half, dst);
+  }
+}
+
+static void swap_diagonal_tile(double **a, int i0, int size) {
+  for (int i = i0; i < i0 + size; i++) {
+    for (int j = i + 1; j < i0 + size; j++) {
+      double tmp = a[i][j];
+      a[i][j] = a[j][i];
+      a[j][i] = tmp;
+    }
+  }
+}
+
+/**
+ * Функция transpose_square транспонирует квадратную матрицу порядка n на
+ * месте. Блоки на диагонали переставляются внутри себя, а симметричные пары
+ * блоков (i, j) и (j, i) меняются местами через буфер на стеке размером в
+ * один блок: (i, j) копируется в буфер, (j, i) транспонируется на место
+ * (i, j), а буфер — на место (j, i).
+ */
+void transpose_square(double **a, int n) {
+  double tile[TRANSPOSE_TILE * TRANSPOSE_TILE];
+  double *tile_rows[TRANSPOSE_TILE];
+  double *shifted[TRANSPOSE_TILE];
+  for (int i = 0; i < TRANSPOSE_TILE; i++) {
+    tile_rows[i] = tile + i * TRANSPOSE_TILE;
+  }
+
+  for (int i0 = 0; i0 < n; i0 += TRANSPOSE_TILE) {
+    int h = n - i0 < TRANSPOSE_TILE ? n - i0 : TRANSPOSE_TILE;
+    swap_diagonal_tile(a, i0, h);
+    for (int j0 = i0 + TRANSPOSE_TILE; j0 < n; j0 += TRANSPOSE_TILE) {
+      int w = n - j0 < TRANSPOSE_TILE ? n - j0 : TRANSPOSE_TILE;
+      for (int i = 0; i < h; i++) {
+        memcpy(tile_rows[i], a[i0 + i] + j0, sizeof(double) * w);
+      }
+      simd_transpose(a, j0, i0, w, h, a);
+      for (int j = 0; j < w; j++) shifted[j] = a[j0 + j] + i0;
+      simd_transpose(tile_rows, 0, 0, h, w, shifted);
+    }
+  }
+}
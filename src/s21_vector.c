@@ -0,0 +1,368 @@
+#include <float.h>
+#include <string.h>
+
+#include "s21_internal.h"
+
+#define VECTOR_CHUNK 16384
+#define GEMV_T_BLOCK 2048
+#define GEMV_TASKS_PER_THREAD 4
+
+/*
+ * Векторы хранятся одним выровненным блоком. Операции BLAS первого уровня
+ * (dot, axpy, нормы) делят вектор на куски по VECTOR_CHUNK элементов и, если
+ * вектор достаточно длинный, раздают куски пулу потоков. Частичные суммы
+ * складываются по порядку кусков, так что результат не зависит от количества
+ * потоков.
+ */
+
+static int is_correct_vector(const vector_t *x) {
+  return x == NULL || x->data == NULL || x->size < 1 ? INCORRECT_MATRIX : OK;
+}
+
+/**
+ * Функция overlaps сообщает, пересекаются ли в памяти векторы x и y.
+ */
+static int overlaps(const vector_t *x, const vector_t *y) {
+  return x->data < y->data + y->size && y->data < x->data + x->size;
+}
+
+/**
+ * Функция s21_create_vector создаёт вектор из size нулей в блоке, выровненном
+ * на MATRIX_ALIGN байт.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если size меньше 1 или result равен NULL,
+ * или `CALC_ERROR`, если не удалось выделить память.
+ */
+int s21_create_vector(int size, vector_t *result) {
+  if (size < 1 || result == NULL) return INCORRECT_MATRIX;
+  size_t bytes = sizeof(double) * size;
+  bytes = (bytes + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN;
+  double *data = aligned_alloc(MATRIX_ALIGN, bytes);
+  if (data == NULL) return CALC_ERROR;
+  memset(data, 0, bytes);
+  result->data = data;
+  result->size = size;
+  return OK;
+}
+
+/**
+ * Функция s21_remove_vector освобождает вектор, созданный s21_create_vector.
+ */
+void s21_remove_vector(vector_t *x) {
+  if (x != NULL && x->data != NULL) {
+    free(x->data);
+    x->data = NULL;
+  }
+}
+
+/**
+ * Функция s21_matrix_as_vector описывает матрицу-столбец или матрицу-строку A
+ * как вектор без копирования: result ссылается на элементы A, поэтому его
+ * нельзя освобождать s21_remove_vector, и он действителен, пока существует A.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A неверна или result равен NULL, или
+ * `CALC_ERROR`, если A не столбец и не строка либо её строки лежат не подряд.
+ */
+int s21_matrix_as_vector(matrix_t *A, vector_t *result) {
+  if (is_correct_matrix(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  double *data = A->rows == 1 || A->columns == 1 ? matrix_data(A) : NULL;
+  if (data == NULL) return CALC_ERROR;
+  result->data = data;
+  result->size = A->rows * A->columns;
+  return OK;
+}
+
+typedef enum reduce_op { REDUCE_DOT, REDUCE_ASUM, REDUCE_AMAX } reduce_op;
+
+typedef struct reduce_task {
+  reduce_op op;
+  const double *x;
+  const double *y;
+  size_t n;
+  double *partial;
+} reduce_task;
+
+static double reduce_chunk(reduce_op op, const double *x, const double *y,
+                           size_t n) {
+  double result = 0;
+  if (op == REDUCE_DOT) {
+    result = simd_dot(x, y, n);
+  } else if (op == REDUCE_ASUM) {
+    result = simd_asum(x, n);
+  } else {
+    result = simd_amax(x, n);
+  }
+  return result;
+}
+
+static void reduce_task_run(void *arg, int index) {
+  reduce_task *t = arg;
+  size_t start = (size_t)index * VECTOR_CHUNK;
+  size_t count = t->n - start < VECTOR_CHUNK ? t->n - start : VECTOR_CHUNK;
+  t->partial[index] = reduce_chunk(t->op, t->x + start,
+                                   t->y != NULL ? t->y + start : NULL, count);
+}
+
+/**
+ * Функция reduce считает по кускам скалярное произведение x и y, сумму или
+ * максимум модулей x и объединяет частичные результаты по порядку кусков.
+ */
+static double reduce(reduce_op op, const double *x, const double *y,
+                     size_t n) {
+  int chunks = (int)((n + VECTOR_CHUNK - 1) / VECTOR_CHUNK);
+  if (chunks == 1) return reduce_chunk(op, x, y, n);
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return reduce_chunk(op, x, y, n);
+  arena_mark_t mark = s21_arena_mark(arena);
+  reduce_task t = {op, x, y, n, arena_alloc(arena, sizeof(double) * chunks)};
+  if (t.partial == NULL) return reduce_chunk(op, x, y, n);
+
+  if (pool_threads((double)n) > 1) {
+    pool_run(reduce_task_run, &t, chunks);
+  } else {
+    for (int c = 0; c < chunks; c++) reduce_task_run(&t, c);
+  }
+  double result = 0;
+  for (int c = 0; c < chunks; c++) {
+    if (op != REDUCE_AMAX) {
+      result += t.partial[c];
+    } else if (isnan(t.partial[c]) || t.partial[c] > result) {
+      result = t.partial[c];
+      if (isnan(result)) break;
+    }
+  }
+  s21_arena_release(arena, mark);
+  return result;
+}
+
+/**
+ * Функция s21_dot записывает в result скалярное произведение векторов x и y.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если вектор неверен или result равен NULL,
+ * или `CALC_ERROR`, если длины не совпадают или результат не конечен.
+ */
+int s21_dot(vector_t *x, vector_t *y, double *result) {
+  if (is_correct_vector(x) != OK || is_correct_vector(y) != OK ||
+      result == NULL) {
+    return INCORRECT_MATRIX;
+  } else if (x->size != y->size) {
+    return CALC_ERROR;
+  }
+  *result = reduce(REDUCE_DOT, x->data, y->data, x->size);
+  return isfinite(*result) ? OK : CALC_ERROR;
+}
+
+typedef struct axpy_task {
+  double a;
+  const double *x;
+  double *y;
+  size_t n;
+  int *bad;
+} axpy_task;
+
+static void axpy_task_run(void *arg, int index) {
+  axpy_task *t = arg;
+  size_t start = (size_t)index * VECTOR_CHUNK;
+  size_t count = t->n - start < VECTOR_CHUNK ? t->n - start : VECTOR_CHUNK;
+  simd_axpy(t->a, t->x + start, t->y + start, count);
+  t->bad[index] = !isfinite(simd_amax(t->y + start, count));
+}
+
+/**
+ * Функция s21_axpy прибавляет к вектору y вектор x, умноженный на число a:
+ * y += a * x. Векторы не должны перекрываться.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если вектор неверен, или `CALC_ERROR`,
+ * если длины не совпадают, векторы перекрываются или в y появилась
+ * бесконечность или NaN.
+ */
+int s21_axpy(double a, vector_t *x, vector_t *y) {
+  if (is_correct_vector(x) != OK || is_correct_vector(y) != OK) {
+    return INCORRECT_MATRIX;
+  } else if (x->size != y->size || overlaps(x, y)) {
+    return CALC_ERROR;
+  }
+  int chunks = (x->size + VECTOR_CHUNK - 1) / VECTOR_CHUNK;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  axpy_task t = {a, x->data, y->data, x->size,
+                 arena_alloc(arena, sizeof(int) * chunks)};
+  if (t.bad == NULL) return CALC_ERROR;
+
+  if (chunks > 1 && pool_threads(x->size) > 1) {
+    pool_run(axpy_task_run, &t, chunks);
+  } else {
+    for (int c = 0; c < chunks; c++) axpy_task_run(&t, c);
+  }
+  int bad = 0;
+  for (int c = 0; c < chunks; c++) bad |= t.bad[c];
+  s21_arena_release(arena, mark);
+  return bad ? CALC_ERROR : OK;
+}
+
+/**
+ * Функции s21_norm1, s21_norm2 и s21_norm_inf записывают в result сумму
+ * модулей, евклидову длину и максимум модулей элементов вектора x.
+ * s21_norm2 не переполняется раньше времени: если сумма квадратов вышла за
+ * пределы double, элементы перед возведением в квадрат делятся на
+ * максимальный модуль.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если вектор неверен или result равен NULL,
+ * или `CALC_ERROR`, если норма не конечна.
+ */
+int s21_norm1(vector_t *x, double *result) {
+  if (is_correct_vector(x) != OK || result == NULL) return INCORRECT_MATRIX;
+  *result = reduce(REDUCE_ASUM, x->data, NULL, x->size);
+  return isfinite(*result) ? OK : CALC_ERROR;
+}
+
+int s21_norm2(vector_t *x, double *result) {
+  if (is_correct_vector(x) != OK || result == NULL) return INCORRECT_MATRIX;
+  double sum = reduce(REDUCE_DOT, x->data, x->data, x->size);
+  *result = sqrt(sum);
+  if (isinf(sum) || sum < DBL_MIN) {
+    double scale = reduce(REDUCE_AMAX, x->data, NULL, x->size);
+    *result = scale;
+    if (scale > 0 && isfinite(scale)) {
+      sum = 0;
+      for (int i = 0; i < x->size; i++) {
+        double v = x->data[i] / scale;
+        sum += v * v;
+      }
+      *result = scale * sqrt(sum);
+    }
+  }
+  return isfinite(*result) ? OK : CALC_ERROR;
+}
+
+int s21_norm_inf(vector_t *x, double *result) {
+  if (is_correct_vector(x) != OK || result == NULL) return INCORRECT_MATRIX;
+  *result = reduce(REDUCE_AMAX, x->data, NULL, x->size);
+  return isfinite(*result) ? OK : CALC_ERROR;
+}
+
+typedef struct gemv_task {
+  int m, n;
+  double *const *a;
+  const double *x;
+  double *y;
+  int step;
+  int *bad;
+} gemv_task;
+
+static void gemv_task_run(void *arg, int index) {
+  gemv_task *t = arg;
+  int i0 = index * t->step;
+  int i1 = t->m - i0 < t->step ? t->m : i0 + t->step;
+  int bad = 0;
+  for (int i = i0; i < i1; i++) {
+    t->y[i] = simd_dot(t->a[i], t->x, t->n);
+    bad |= !isfinite(t->y[i]);
+  }
+  t->bad[index] = bad;
+}
+
+static void gemv_t_task_run(void *arg, int index) {
+  gemv_task *t = arg;
+  int j0 = index * t->step;
+  int count = t->n - j0 < t->step ? t->n - j0 : t->step;
+  double *y = t->y + j0;
+  memset(y, 0, sizeof(double) * count);
+  for (int i = 0; i < t->m; i++) simd_axpy(t->x[i], t->a[i] + j0, y, count);
+  t->bad[index] = !isfinite(simd_amax(y, count));
+}
+
+/**
+ * Функция gemv_run делит работу на count частей по step строк (для A * x)
+ * или столбцов (для A^T * x) и выполняет их на пуле потоков, если объём
+ * работы не меньше порога s21_set_parallel_threshold.
+ */
+static int gemv_run(void (*task)(void *, int), gemv_task *t, int length,
+                    int step) {
+  int threads = pool_threads((double)t->m * t->n);
+  if (threads > 1) {
+    int parallel = (length + threads * GEMV_TASKS_PER_THREAD - 1) /
+                   (threads * GEMV_TASKS_PER_THREAD);
+    if (parallel < step) step = parallel;
+  }
+  int count = (length + step - 1) / step;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  t->step = step;
+  t->bad = arena_alloc(arena, sizeof(int) * count);
+  if (t->bad == NULL) return CALC_ERROR;
+
+  if (threads > 1 && count > 1) {
+    pool_run(task, t, count);
+  } else {
+    for (int c = 0; c < count; c++) task(t, c);
+  }
+  int bad = 0;
+  for (int c = 0; c < count; c++) bad |= t->bad[c];
+  s21_arena_release(arena, mark);
+  return bad ? CALC_ERROR : OK;
+}
+
+/**
+ * Функция gemv_kernel записывает в непрерывный массив y длины m произведение
+ * матрицы A размером m x n на вектор x: каждый элемент y — скалярное
+ * произведение строки A на x. Строки распределяются по пулу потоков; каждый
+ * элемент считается одной задачей, поэтому результат не зависит от
+ * количества потоков.
+ *
+ * @return `OK` или `CALC_ERROR`, если в результате есть бесконечность или NaN.
+ */
+int gemv_kernel(int m, int n, double *const *a, const double *x, double *y) {
+  gemv_task t = {m, n, a, x, y, 0, NULL};
+  return gemv_run(gemv_task_run, &t, m, m);
+}
+
+/**
+ * Функция gemv_t_kernel записывает в непрерывный массив y длины n
+ * произведение транспонированной матрицы A размером m x n на вектор x длины
+ * m: y = сумма x[i] * A[i]. Столбцы делятся на блоки по GEMV_T_BLOCK, чтобы
+ * накапливаемая часть y оставалась в кэше, пока по ней проходят строки A.
+ *
+ * @return `OK` или `CALC_ERROR`, если в результате есть бесконечность или NaN.
+ */
+int gemv_t_kernel(int m, int n, double *const *a, const double *x,
+                  double *y) {
+  gemv_task t = {m, n, a, x, y, 0, NULL};
+  return gemv_run(gemv_t_task_run, &t, n, GEMV_T_BLOCK);
+}
+
+/**
+ * Функция s21_gemv записывает в вектор y длины A->rows произведение матрицы A
+ * на вектор x длины A->columns.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если матрица или вектор неверны, или
+ * `CALC_ERROR`, если размеры не подходят, y перекрывается с x или в
+ * результате есть бесконечность или NaN.
+ */
+int s21_gemv(matrix_t *A, vector_t *x, vector_t *y) {
+  if (is_correct_matrix(A) != OK || is_correct_vector(x) != OK ||
+      is_correct_vector(y) != OK) {
+    return INCORRECT_MATRIX;
+  } else if (x->size != A->columns || y->size != A->rows || overlaps(x, y)) {
+    return CALC_ERROR;
+  }
+  return gemv_kernel(A->rows, A->columns, A->matrix, x->data, y->data);
+}
+
+/**
+ * Функция s21_gemv_t записывает в вектор y длины A->columns произведение
+ * транспонированной матрицы A на вектор x длины A->rows, не транспонируя A.
+ *
+ * @return Те же коды, что и s21_gemv.
+ */
+int s21_gemv_t(matrix_t *A, vector_t *x, vector_t *y) {
+  if (is_correct_matrix(A) != OK || is_correct_vector(x) != OK ||
+      is_correct_vector(y) != OK) {
+    return INCORRECT_MATRIX;
+  } else if (x->size != A->rows || y->size != A->columns || overlaps(x, y)) {
+    return CALC_ERROR;
+  }
+  return gemv_t_kernel(A->rows, A->columns, A->matrix, x->data, y->data);
+}
@@ -0,0 +1,306 @@
+#include <string.h>
+
+#include "s21_internal.h"
+
+/*
+ * Представление (s21_view_t) описывает матрицу внутри чужой памяти без
+ * копирования: элемент (i, j) лежит по адресу
+ * base + offset + i * row_stride + j * column_stride. Подматрица, строка,
+ * столбец и транспонирование получаются пересчётом смещения и шагов.
+ *
+ * Представление с column_stride == 1 превращается в matrix_t с указателями
+ * на строки внутри исходной памяти (s21_view_as_matrix), поэтому к нему
+ * применимы все функции *_into и *_inplace, в том числе как к результату.
+ * Функции s21_view_* работают с любыми шагами: если у всех аргументов
+ * column_stride равен 1, они вызывают векторные ядра для каждой строки,
+ * иначе обходят элементы по шагам.
+ */
+
+#define VIEW_AT(v, i, j) \
+  ((v)->base[(v)->offset + (i) * (v)->row_stride + (j) * (v)->column_stride])
+
+static int is_correct_view(const s21_view_t *V) {
+  return V == NULL || V->base == NULL || V->rows < 1 || V->columns < 1
+             ? INCORRECT_MATRIX
+             : OK;
+}
+
+/**
+ * Функция s21_view_matrix создаёт представление всей матрицы A. Строки A
+ * должны лежать в памяти с одинаковым шагом (так устроены матрицы из
+ * s21_create_matrix и из s21_view_as_matrix).
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если A неверна или result равен NULL, или
+ * `CALC_ERROR`, если шаг между строками A непостоянен.
+ */
+int s21_view_matrix(matrix_t *A, s21_view_t *result) {
+  if (is_correct_matrix(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  ptrdiff_t stride = A->rows > 1 ? A->matrix[1] - A->matrix[0] : A->columns;
+  for (int i = 2; i < A->rows; i++) {
+    if (A->matrix[i] - A->matrix[i - 1] != stride) return CALC_ERROR;
+  }
+  *result = (s21_view_t){A->matrix[0], 0, A->rows, A->columns, stride, 1};
+  return OK;
+}
+
+/**
+ * Функция s21_view_block создаёт представление подматрицы V размером
+ * rows x columns с левым верхним углом (row, column).
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если V неверно или result равен NULL, или
+ * `CALC_ERROR`, если блок выходит за границы V или пуст.
+ */
+int s21_view_block(const s21_view_t *V, int row, int column, int rows,
+                   int columns, s21_view_t *result) {
+  if (is_correct_view(V) != OK || result == NULL) return INCORRECT_MATRIX;
+  if (row < 0 || column < 0 || rows < 1 || columns < 1 ||
+      rows > V->rows - row || columns > V->columns - column) {
+    return CALC_ERROR;
+  }
+  *result = *V;
+  result->offset += row * V->row_stride + column * V->column_stride;
+  result->rows = rows;
+  result->columns = columns;
+  return OK;
+}
+
+/**
+ * Функции s21_view_row и s21_view_column создают представления строки
+ * (1 x columns) и столбца (rows x 1) V.
+ *
+ * @return Коды ошибок такие же, как у s21_view_block.
+ */
+int s21_view_row(const s21_view_t *V, int row, s21_view_t *result) {
+  return s21_view_block(V, row, 0, 1, V != NULL ? V->columns : 1, result);
+}
+
+int s21_view_column(const s21_view_t *V, int column, s21_view_t *result) {
+  return s21_view_block(V, 0, column, V != NULL ? V->rows : 1, 1, result);
+}
+
+/**
+ * Функция s21_view_transpose создаёт транспонированное представление V:
+ * меняет местами размеры и шаги, не трогая элементы.
+ *
+ * @return `OK` или `INCORRECT_MATRIX`, если V неверно или result равен NULL.
+ */
+int s21_view_transpose(const s21_view_t *V, s21_view_t *result) {
+  if (is_correct_view(V) != OK || result == NULL) return INCORRECT_MATRIX;
+  *result = (s21_view_t){V->base,    V->offset,        V->columns,
+                         V->rows,    V->column_stride, V->row_stride};
+  return OK;
+}
+
+/**
+ * Функция s21_view_as_matrix заполняет result указателями на строки V, не
+ * копируя элементы: массив указателей выделяется из arena. Запись в result
+ * меняет элементы V. result нельзя передавать в s21_remove_matrix.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если аргументы неверны, или `CALC_ERROR`,
+ * если column_stride не равен 1 или не удалось выделить память.
+ */
+int s21_view_as_matrix(const s21_view_t *V, arena_t *arena,
+                       matrix_t *result) {
+  if (is_correct_view(V) != OK || arena == NULL || result == NULL) {
+    return INCORRECT_MATRIX;
+  }
+  if (V->column_stride != 1) return CALC_ERROR;
+  double **rows = arena_alloc(arena, sizeof(double *) * V->rows);
+  if (rows == NULL) return CALC_ERROR;
+  for (int i = 0; i < V->rows; i++) rows[i] = &VIEW_AT(V, i, 0);
+  *result = (matrix_t){rows, V->rows, V->columns};
+  return OK;
+}
+
+/**
+ * Функция view_rows возвращает указатели на строки V для ядер, работающих со
+ * строками. При column_stride == 1 это строки внутри V; иначе элементы
+ * упаковываются в непрерывный буфер арены (так же gemm упаковывает операнды
+ * перед умножением), а copied устанавливается в 1.
+ *
+ * @return Массив указателей или NULL, если не удалось выделить память.
+ */
+static double **view_rows(const s21_view_t *V, arena_t *arena, int *copied) {
+  double **rows = arena_alloc(arena, sizeof(double *) * V->rows);
+  *copied = V->column_stride != 1;
+  double *packed = rows != NULL && *copied
+                       ? arena_alloc(arena, sizeof(double) * V->rows *
+                                                V->columns)
+                       : NULL;
+  if (rows == NULL || (*copied && packed == NULL)) return NULL;
+  for (int i = 0; i < V->rows; i++) {
+    if (*copied) {
+      rows[i] = packed + (size_t)i * V->columns;
+      for (int j = 0; j < V->columns; j++) rows[i][j] = VIEW_AT(V, i, j);
+    } else {
+      rows[i] = &VIEW_AT(V, i, 0);
+    }
+  }
+  return rows;
+}
+
+/**
+ * Функция view_store переписывает упакованные строки rows обратно в V.
+ */
+static void view_store(double *const *rows, s21_view_t *V) {
+  for (int i = 0; i < V->rows; i++) {
+    for (int j = 0; j < V->columns; j++) VIEW_AT(V, i, j) = rows[i][j];
+  }
+}
+
+/**
+ * Функция view_apply записывает в R результат элементного ядра (simd_add или
+ * simd_sub) над A и B либо, если kernel равен NULL, A, умноженное на number.
+ * Строки с единичным шагом обрабатываются векторным ядром, остальные — по
+ * элементам.
+ */
+static int view_apply(int (*kernel)(const double *, const double *, double *,
+                                    size_t),
+                      const s21_view_t *A, const s21_view_t *B, double number,
+                      s21_view_t *R) {
+  int unit = A->column_stride == 1 && R->column_stride == 1 &&
+             (B == NULL || B->column_stride == 1);
+  int bad = 0;
+  for (int i = 0; i < R->rows; i++) {
+    const double *a = &VIEW_AT(A, i, 0);
+    const double *b = B != NULL ? &VIEW_AT(B, i, 0) : NULL;
+    double *r = &VIEW_AT(R, i, 0);
+    if (unit && kernel != NULL) {
+      bad |= kernel(a, b, r, R->columns);
+    } else if (unit) {
+      bad |= simd_scale(a, number, r, R->columns);
+    } else {
+      for (int j = 0; j < R->columns; j++) {
+        double x = a[j * A->column_stride];
+        double value = kernel == simd_add   ? x + b[j * B->column_stride]
+                       : kernel == simd_sub ? x - b[j * B->column_stride]
+                                            : x * number;
+        r[j * R->column_stride] = value;
+        bad |= !isfinite(value);
+      }
+    }
+  }
+  return bad ? CALC_ERROR : OK;
+}
+
+static int check_views(const s21_view_t *A, const s21_view_t *B,
+                       const s21_view_t *R) {
+  if (is_correct_view(A) != OK || is_correct_view(B) != OK ||
+      is_correct_view(R) != OK) {
+    return INCORRECT_MATRIX;
+  }
+  return A->rows == B->rows && A->columns == B->columns &&
+                 R->rows == A->rows && R->columns == A->columns
+             ? OK
+             : CALC_ERROR;
+}
+
+/**
+ * Функции s21_view_sum и s21_view_sub записывают в R поэлементную сумму и
+ * разность представлений A и B одного размера. R может совпадать с A или B,
+ * но не должно перекрываться с ними иначе.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одно из представлений неверно, или
+ * `CALC_ERROR`, если размеры не совпадают либо в результате появилась
+ * бесконечность или NaN.
+ */
+int s21_view_sum(s21_view_t *A, s21_view_t *B, s21_view_t *R) {
+  int res = check_views(A, B, R);
+  return res == OK ? view_apply(simd_add, A, B, 0, R) : res;
+}
+
+int s21_view_sub(s21_view_t *A, s21_view_t *B, s21_view_t *R) {
+  int res = check_views(A, B, R);
+  return res == OK ? view_apply(simd_sub, A, B, 0, R) : res;
+}
+
+/**
+ * Функция s21_view_scale записывает в R элементы A, умноженные на number.
+ *
+ * @return Коды ошибок такие же, как у s21_view_sum.
+ */
+int s21_view_scale(s21_view_t *A, double number, s21_view_t *R) {
+  int res = check_views(A, A, R);
+  return res == OK ? view_apply(NULL, A, NULL, number, R) : res;
+}
+
+/**
+ * Функция s21_view_copy копирует элементы A в R того же размера.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одно из представлений неверно, или
+ * `CALC_ERROR`, если размеры не совпадают.
+ */
+int s21_view_copy(s21_view_t *A, s21_view_t *R) {
+  int res = check_views(A, A, R);
+  for (int i = 0; i < R->rows && res == OK; i++) {
+    if (A->column_stride == 1 && R->column_stride == 1) {
+      memmove(&VIEW_AT(R, i, 0), &VIEW_AT(A, i, 0),
+              sizeof(double) * R->columns);
+    } else {
+      for (int j = 0; j < R->columns; j++) VIEW_AT(R, i, j) = VIEW_AT(A, i, j);
+    }
+  }
+  return res;
+}
+
+/**
+ * Функция s21_view_mult записывает в R произведение A * B через gemm_kernel.
+ * Операнды с единичным шагом по столбцам передаются ядру указателями на
+ * строки внутри исходной памяти, остальные упаковываются в арену потока;
+ * если у R шаг по столбцам не равен 1, результат собирается в арене и
+ * переписывается в R. R не должно перекрываться с A и B.
+ *
+ * @return `OK`, `INCORRECT_MATRIX`, если одно из представлений неверно, или
+ * `CALC_ERROR`, если размеры не подходят для умножения, не удалось выделить
+ * память либо в результате появилась бесконечность или NaN.
+ */
+int s21_view_mult(s21_view_t *A, s21_view_t *B, s21_view_t *R) {
+  if (is_correct_view(A) != OK || is_correct_view(B) != OK ||
+      is_correct_view(R) != OK) {
+    return INCORRECT_MATRIX;
+  }
+  if (A->columns != B->rows || R->rows != A->rows ||
+      R->columns != B->columns) {
+    return CALC_ERROR;
+  }
+
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  int copied_a, copied_b, copied_r;
+  double **a = view_rows(A, arena, &copied_a);
+  double **b = a != NULL ? view_rows(B, arena, &copied_b) : NULL;
+  double **r = b != NULL ? view_rows(R, arena, &copied_r) : NULL;
+  int res = r != NULL ? OK : CALC_ERROR;
+  if (res == OK) {
+    for (int i = 0; i < R->rows; i++) {
+      memset(r[i], 0, sizeof(double) * R->columns);
+    }
+    res = gemm_kernel(A->rows, B->columns, A->columns, a, b, r);
+    if (copied_r) view_store(r, R);
+  }
+  s21_arena_release(arena, mark);
+  return res;
+}
+
+/**
+ * Функция s21_view_determinant вычисляет определитель квадратного
+ * представления так же, как s21_determinant.
+ *
+ * @return Коды ошибок такие же, как у s21_determinant.
+ */
+int s21_view_determinant(s21_view_t *A, double *result) {
+  if (is_correct_view(A) != OK || result == NULL) return INCORRECT_MATRIX;
+  arena_t *arena = scratch_arena();
+  if (arena == NULL) return CALC_ERROR;
+  arena_mark_t mark = s21_arena_mark(arena);
+  int copied;
+  double **rows = view_rows(A, arena, &copied);
+  int res = CALC_ERROR;
+  if (rows != NULL) {
+    matrix_t matrix = {rows, A->rows, A->columns};
+    res = s21_determinant(&matrix, result);
+  }
+  s21_arena_release(arena, mark);
+  return res;
+}
@@ -1,6 +1,10 @@
 #include <check.h>
+#include <float.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 
-#include "../s21_matrix.h"
+#include "../s21_internal.h"
 
 void s21_init_matrix(double number, matrix_t *A) {
   for (int x = 0; x < A->rows; x += 1) {
@@ -9,6 +13,22 @@ void s21_init_matrix(double number, matrix_t *A) {
   }
 }
 
+/*
+ * Общий детерминированный генератор операндов: создаёт матрицу rows x columns
+ * и заполняет её значениями из [-0.5, 0.5], которые линейный конгруэнтный
+ * генератор выдаёт из начального значения seed. Тесты добавляют к такой
+ * матрице только нужную им структуру.
+ */
+void s21_random_matrix(int rows, int columns, unsigned seed, matrix_t *A) {
+  s21_create_matrix(rows, columns, A);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < columns; j++) {
+      seed = seed * 1103515245 + 12345;
+      A->matrix[i][j] = (double)(seed >> 16 & 0x7fff) / 0x7fff - 0.5;
+    }
+  }
+}
+
 START_TEST(s21_create_matrix_01) {
   int res = 0;
   matrix_t A = {0};
@@ -68,6 +88,32 @@ START_TEST(s21_create_matrix_06) {
 }
 END_TEST
 
+START_TEST(s21_create_matrix_07) {
+  matrix_t A = {0};
+
+  ck_assert_int_eq(s21_create_matrix(5, 3, &A), OK);
+  ck_assert_int_eq((size_t)A.matrix[0] % MATRIX_ALIGN, 0);
+  ck_assert_ptr_eq(matrix_data(&A), A.matrix[0]);
+  for (int i = 0; i < A.rows; i++) {
+    ck_assert_ptr_eq(A.matrix[i], A.matrix[0] + i * A.columns);
+    for (int j = 0; j < A.columns; j++) ck_assert_double_eq(A.matrix[i][j], 0);
+  }
+  s21_remove_matrix(&A);
+  ck_assert_ptr_null(A.matrix);
+}
+END_TEST
+
+START_TEST(s21_create_matrix_08) {
+  matrix_t A = {0};
+
+  ck_assert_int_eq(s21_create_matrix((1 << 30) + 23170, INT32_MAX - 46338, &A),
+                   CALC_ERROR);
+  ck_assert_ptr_null(A.matrix);
+  ck_assert_int_eq(s21_create_matrix(INT32_MAX, INT32_MAX, &A), CALC_ERROR);
+  ck_assert_ptr_null(A.matrix);
+}
+END_TEST
+
 START_TEST(s21_eq_matrix_01) {
   matrix_t A = {0};
   matrix_t B = {0};
@@ -192,6 +238,70 @@ START_TEST(s21_sum_matrix_02) {
 }
 END_TEST
 
+START_TEST(s21_sum_matrix_03) {
+  matrix_t a = {0};
+  matrix_t b = {0};
+  matrix_t c = {0};
+
+  s21_create_matrix(7, 5, &a);
+  s21_create_matrix(7, 5, &b);
+  s21_init_matrix(1.0, &a);
+  s21_init_matrix(-3.5, &b);
+
+  ck_assert_int_eq(s21_sum_matrix(&a, &b, &c), OK);
+  for (int i = 0; i < c.rows; i++) {
+    for (int j = 0; j < c.columns; j++) {
+      ck_assert_double_eq(c.matrix[i][j], a.matrix[i][j] + b.matrix[i][j]);
+    }
+  }
+  s21_remove_matrix(&c);
+
+  a.matrix[6][3] = DBL_MAX;
+  b.matrix[6][3] = DBL_MAX;
+  ck_assert_int_eq(s21_sum_matrix(&a, &b, &c), CALC_ERROR);
+  ck_assert_int_eq(s21_sum_matrix(&a, &b, NULL), INCORRECT_MATRIX);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&c);
+}
+END_TEST
+
+START_TEST(s21_sum_matrix_04) {
+  matrix_t a = {0};
+  matrix_t b = {0};
+  matrix_t c = {0};
+
+  s21_create_matrix(3, 4, &a);
+  s21_create_matrix(3, 4, &b);
+  s21_create_matrix(3, 4, &c);
+  s21_init_matrix(1.0, &a);
+  s21_init_matrix(2.0, &b);
+  double **storage = c.matrix;
+
+  ck_assert_int_eq(s21_sum_matrix_into(&a, &b, &c), OK);
+  ck_assert_ptr_eq(c.matrix, storage);
+  ck_assert_double_eq(c.matrix[2][3], 25.0);
+
+  ck_assert_int_eq(s21_sub_matrix_inplace(&c, &b), OK);
+  ck_assert_int_eq(s21_eq_matrix(&c, &a), SUCCESS);
+  ck_assert_int_eq(s21_sum_matrix_inplace(&a, &a), OK);
+  ck_assert_int_eq(s21_mult_number_inplace(&a, 0.5), OK);
+  ck_assert_int_eq(s21_eq_matrix(&c, &a), SUCCESS);
+  ck_assert_int_eq(s21_mult_number_into(&a, 3.0, &c), OK);
+  ck_assert_double_eq(c.matrix[0][1], 6.0);
+
+  s21_remove_matrix(&b);
+  s21_create_matrix(4, 3, &b);
+  ck_assert_int_eq(s21_sum_matrix_into(&a, &a, &b), CALC_ERROR);
+  ck_assert_int_eq(s21_sub_matrix_inplace(&a, &b), CALC_ERROR);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&c);
+}
+END_TEST
+
 START_TEST(s21_sub_matrix_01) {
   matrix_t A = {0};
   matrix_t B = {0};
@@ -419,6 +529,113 @@ START_TEST(s21_mult_matrix_06) {
 }
 END_TEST
 
+START_TEST(s21_mult_matrix_07) {
+  matrix_t a = {0};
+  matrix_t b = {0};
+  matrix_t c = {0};
+
+  s21_create_matrix(70, 45, &a);
+  s21_create_matrix(45, 33, &b);
+  s21_init_matrix(-100.0, &a);
+  s21_init_matrix(-700.0, &b);
+
+  ck_assert_int_eq(s21_mult_matrix(&a, &b, &c), OK);
+  ck_assert_int_eq(c.rows, 70);
+  ck_assert_int_eq(c.columns, 33);
+  for (int i = 0; i < c.rows; i++) {
+    for (int j = 0; j < c.columns; j++) {
+      double sum = 0;
+      for (int k = 0; k < a.columns; k++) {
+        sum += a.matrix[i][k] * b.matrix[k][j];
+      }
+      ck_assert_double_eq_tol(c.matrix[i][j], sum, 1e-7);
+    }
+  }
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&c);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_08) {
+  matrix_t a = {0};
+  matrix_t b = {0};
+  matrix_t c = {0};
+
+  s21_create_matrix(64, 64, &a);
+  s21_create_matrix(64, 64, &b);
+  s21_init_matrix(1.0, &a);
+  s21_init_matrix(1.0, &b);
+  a.matrix[40][10] = 1e300;
+  b.matrix[10][50] = 1e300;
+
+  ck_assert_int_eq(s21_mult_matrix(&a, &b, &c), CALC_ERROR);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&c);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_09) {
+  matrix_t a = {0};
+  matrix_t b = {0};
+  matrix_t single = {0};
+  matrix_t parallel = {0};
+
+  s21_create_matrix(150, 170, &a);
+  s21_create_matrix(170, 130, &b);
+  s21_init_matrix(0.001, &a);
+  s21_init_matrix(-0.37, &b);
+
+  ck_assert_int_eq(s21_mult_matrix(&a, &b, &single), OK);
+  s21_set_num_threads(4);
+  s21_set_parallel_threshold(0);
+  ck_assert_int_eq(s21_get_num_threads(), 4);
+  ck_assert_int_eq(s21_mult_matrix(&a, &b, &parallel), OK);
+  s21_set_num_threads(1);
+  s21_set_parallel_threshold(POOL_DEFAULT_THRESHOLD);
+
+  for (int i = 0; i < single.rows; i++) {
+    for (int j = 0; j < single.columns; j++) {
+      ck_assert_double_eq(single.matrix[i][j], parallel.matrix[i][j]);
+    }
+  }
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&single);
+  s21_remove_matrix(&parallel);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_10) {
+  matrix_t a = {0};
+  matrix_t b = {0};
+  matrix_t c = {0};
+  matrix_t check = {0};
+
+  s21_create_matrix(4, 4, &a);
+  s21_create_matrix(4, 4, &b);
+  s21_create_matrix(4, 4, &c);
+  s21_init_matrix(1.0, &a);
+  s21_init_matrix(1.0, &b);
+  s21_init_matrix(100.0, &c);
+
+  ck_assert_int_eq(s21_mult_matrix_into(&a, &b, &c), OK);
+  s21_mult_matrix(&a, &b, &check);
+  ck_assert_int_eq(s21_eq_matrix(&c, &check), SUCCESS);
+  ck_assert_int_eq(s21_mult_matrix_into(&a, &b, &a), CALC_ERROR);
+  ck_assert_int_eq(s21_mult_matrix_into(&a, &b, NULL), INCORRECT_MATRIX);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&c);
+  s21_remove_matrix(&check);
+}
+END_TEST
+
 START_TEST(s21_mult_number_01) {
   int res = 0;
   double number = 3.0;
@@ -495,6 +712,26 @@ START_TEST(s21_mult_number_04) {
 }
 END_TEST
 
+START_TEST(s21_mult_number_05) {
+  matrix_t a = {0};
+  matrix_t c = {0};
+
+  s21_create_matrix(9, 9, &a);
+  s21_init_matrix(1.0, &a);
+  a.matrix[4][4] = 1e300;
+
+  ck_assert_int_eq(s21_mult_number(&a, 1e10, &c), CALC_ERROR);
+  s21_remove_matrix(&c);
+
+  a.matrix[4][4] = 1.0;
+  ck_assert_int_eq(s21_mult_number(&a, -0.5, &c), OK);
+  ck_assert_double_eq(c.matrix[8][8], -40.5);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&c);
+}
+END_TEST
+
 START_TEST(s21_transpose_01) {
   int res = 0;
   matrix_t A = {0};
@@ -556,6 +793,61 @@ START_TEST(s21_transpose_03) {
 }
 END_TEST
 
+START_TEST(s21_transpose_04) {
+  matrix_t a = {0};
+  matrix_t t = {0};
+  matrix_t check = {0};
+
+  s21_create_matrix(5, 5, &a);
+  s21_init_matrix(1.0, &a);
+  s21_transpose(&a, &check);
+
+  ck_assert_int_eq(s21_transpose_inplace(&a), OK);
+  ck_assert_int_eq(s21_eq_matrix(&a, &check), SUCCESS);
+
+  s21_create_matrix(5, 5, &t);
+  ck_assert_int_eq(s21_transpose_into(&check, &t), OK);
+  ck_assert_double_eq(t.matrix[1][3], 9.0);
+  ck_assert_int_eq(s21_transpose_into(&t, &t), CALC_ERROR);
+  s21_remove_matrix(&t);
+
+  s21_create_matrix(2, 3, &t);
+  ck_assert_int_eq(s21_transpose_inplace(&t), CALC_ERROR);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&t);
+  s21_remove_matrix(&check);
+}
+END_TEST
+
+START_TEST(s21_transpose_05) {
+  matrix_t a = {0};
+  matrix_t t = {0};
+  int ok = 1;
+
+  s21_create_matrix(77, 45, &a);
+  s21_init_matrix(1.0, &a);
+  ck_assert_int_eq(s21_transpose(&a, &t), OK);
+  ck_assert_int_eq(t.rows, 45);
+  ck_assert_int_eq(t.columns, 77);
+  for (int i = 0; i < a.rows; i++) {
+    for (int j = 0; j < a.columns; j++) ok &= t.matrix[j][i] == a.matrix[i][j];
+  }
+  ck_assert_int_eq(ok, 1);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&t);
+
+  s21_create_matrix(70, 70, &a);
+  s21_init_matrix(1.0, &a);
+  ck_assert_int_eq(s21_transpose(&a, &t), OK);
+  ck_assert_int_eq(s21_transpose_inplace(&a), OK);
+  ck_assert_int_eq(s21_eq_matrix(&a, &t), SUCCESS);
+  ck_assert_double_eq(a.matrix[69][3], 3 * 70 + 69 + 1.0);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&t);
+}
+END_TEST
+
 START_TEST(s21_determinant_01) {
   double determ = 0.0;
   matrix_t A = {0};
@@ -586,6 +878,54 @@ START_TEST(s21_determinant_02) {
 }
 END_TEST
 
+START_TEST(s21_determinant_03) {
+  double determ = 0.0;
+  matrix_t A = {0};
+
+  s21_create_matrix(12, 12, &A);
+  for (int i = 0; i < A.rows; i++) {
+    A.matrix[i][i] = 2.0;
+    if (i > 0) A.matrix[i][i - 1] = -1.0;
+    if (i < A.rows - 1) A.matrix[i][i + 1] = -1.0;
+  }
+
+  ck_assert_int_eq(s21_determinant(&A, &determ), OK);
+  ck_assert_double_eq_tol(determ, 13.0, 1e-7);
+  s21_remove_matrix(&A);
+}
+END_TEST
+
+START_TEST(s21_determinant_04) {
+  double determ = 1.0;
+  matrix_t A = {0};
+
+  s21_create_matrix(6, 6, &A);
+  s21_init_matrix(1.0, &A);
+  for (int j = 0; j < A.columns; j++) A.matrix[3][j] = 0.0;
+
+  ck_assert_int_eq(s21_determinant(&A, &determ), OK);
+  ck_assert_double_eq_tol(determ, 0.0, 1e-7);
+  s21_remove_matrix(&A);
+}
+END_TEST
+
+START_TEST(s21_determinant_05) {
+  double determ = 1.0;
+  matrix_t A = {0};
+
+  s21_create_matrix(100, 100, &A);
+  for (int i = 0; i < A.rows; i++) A.matrix[i][i] = 1.0;
+  A.matrix[99][99] = INFINITY;
+  ck_assert_int_eq(s21_determinant(&A, &determ), CALC_ERROR);
+
+  A.matrix[99][99] = 1.0;
+  for (int j = 0; j < A.columns; j++) A.matrix[80][j] = 0.0;
+  ck_assert_int_eq(s21_determinant(&A, &determ), OK);
+  ck_assert_double_eq(determ, 0.0);
+  s21_remove_matrix(&A);
+}
+END_TEST
+
 START_TEST(s21_calc_complements_01) {
   int res = 0;
   matrix_t A = {0};
@@ -641,6 +981,50 @@ START_TEST(s21_calc_complements_01) {
 }
 END_TEST
 
+START_TEST(s21_calc_complements_02) {
+  const int n = 6;
+  matrix_t a = {0}, minor = {0}, fast = {0}, pooled = {0};
+  s21_create_matrix(n, n, &a);
+  s21_create_matrix(n - 1, n - 1, &minor);
+  unsigned seed = 5;
+  for (int i = 0; i < n * n; i++) {
+    seed = seed * 1103515245 + 12345;
+    a.matrix[i / n][i % n] = (double)(seed >> 16 & 0x7fff) / 0x7fff - 0.5;
+  }
+
+  for (int singular = 0; singular < 2; singular++) {
+    if (singular) {
+      for (int j = 0; j < n; j++) a.matrix[4][j] = a.matrix[0][j] * 0.5;
+    }
+    ck_assert_int_eq(s21_calc_complements(&a, &fast), OK);
+    s21_set_num_threads(4);
+    s21_set_parallel_threshold(0);
+    ck_assert_int_eq(s21_calc_complements(&a, &pooled), OK);
+    s21_set_num_threads(1);
+    s21_set_parallel_threshold(POOL_DEFAULT_THRESHOLD);
+
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        for (int k = 0; k < (n - 1) * (n - 1); k++) {
+          int row = k / (n - 1), column = k % (n - 1);
+          minor.matrix[row][column] =
+              a.matrix[row + (row >= i)][column + (column >= j)];
+        }
+        double expected = 0;
+        s21_determinant(&minor, &expected);
+        if ((i + j) % 2) expected = -expected;
+        ck_assert_double_eq_tol(fast.matrix[i][j], expected, 1e-12);
+        ck_assert_double_eq(pooled.matrix[i][j], fast.matrix[i][j]);
+      }
+    }
+    s21_remove_matrix(&fast);
+    s21_remove_matrix(&pooled);
+  }
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&minor);
+}
+END_TEST
+
 START_TEST(s21_inverse_matrix_01) {
   int res = 0;
   matrix_t A = {0};
@@ -758,6 +1142,2712 @@ START_TEST(s21_inverse_matrix_05) {
 }
 END_TEST
 
+START_TEST(s21_inverse_matrix_06) {
+  matrix_t A = {0};
+  matrix_t Z = {0};
+  matrix_t E = {0};
+  matrix_t X = {0};
+
+  s21_create_matrix(7, 7, &A);
+  s21_init_matrix(1.0, &A);
+  for (int i = 0; i < A.rows; i++) A.matrix[i][i] += 50.0;
+  A.matrix[0][0] = 0.0;
+
+  ck_assert_int_eq(s21_inverse_matrix(&A, &Z), OK);
+  s21_mult_matrix(&A, &Z, &E);
+
+  s21_create_matrix(7, 7, &X);
+  for (int i = 0; i < X.rows; i++) X.matrix[i][i] = 1.0;
+
+  int res = s21_eq_matrix(&X, &E);
+
+  s21_remove_matrix(&A);
+  s21_remove_matrix(&Z);
+  s21_remove_matrix(&E);
+  s21_remove_matrix(&X);
+
+  ck_assert_int_eq(res, SUCCESS);
+}
+END_TEST
+
+START_TEST(s21_inverse_matrix_07) {
+  double values[4][5] = {{4, 9, 3, 6, 8},
+                         {2, 1, 8, 5, 9},
+                         {4, 4, 8, 9, 9},
+                         {8, 7, 3, 4, 3}};
+  double determ = 1.0;
+  matrix_t A = {0};
+  matrix_t Z = {0};
+
+  s21_create_matrix(5, 5, &A);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 5; j++) A.matrix[i][j] = values[i][j];
+  }
+  for (int j = 0; j < 5; j++) {
+    A.matrix[4][j] = A.matrix[0][j] + A.matrix[1][j];
+  }
+
+  ck_assert_int_eq(s21_inverse_matrix(&A, &Z), CALC_ERROR);
+  ck_assert_int_eq(s21_determinant(&A, &determ), OK);
+  ck_assert_double_eq(determ, 0.0);
+  s21_remove_matrix(&A);
+}
+END_TEST
+
+START_TEST(s21_arena_create_01) {
+  arena_t arena = {0};
+  matrix_t a = {0};
+
+  ck_assert_int_eq(s21_arena_create(4096, &arena), OK);
+  ck_assert_int_eq(s21_arena_matrix(&arena, 100, 100, &a), OK);
+  ck_assert_double_eq(a.matrix[99][99], 0.0);
+  s21_arena_destroy(&arena);
+}
+END_TEST
+
+START_TEST(s21_arena_matrix_01) {
+  arena_t arena = {0};
+  matrix_t a = {0};
+
+  s21_arena_create(4096, &arena);
+  ck_assert_int_eq(s21_arena_matrix(&arena, 3, 3, &a), OK);
+  ck_assert_int_eq((size_t)a.matrix % MATRIX_ALIGN, 0);
+  ck_assert_ptr_eq(matrix_data(&a), a.matrix[0]);
+  s21_init_matrix(1.0, &a);
+  ck_assert_double_eq(a.matrix[2][2], 9.0);
+  s21_arena_destroy(&arena);
+}
+END_TEST
+
+START_TEST(s21_arena_matrix_02) {
+  arena_t arena = {0};
+  matrix_t a = {0};
+
+  s21_arena_create(4096, &arena);
+  ck_assert_int_eq(s21_arena_matrix(&arena, 0, 3, &a), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_arena_matrix(&arena, 3, -1, &a), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_arena_matrix(NULL, 3, 3, &a), INCORRECT_MATRIX);
+  ck_assert_ptr_null(a.matrix);
+  s21_arena_destroy(&arena);
+}
+END_TEST
+
+START_TEST(s21_arena_release_01) {
+  arena_t arena = {0};
+  matrix_t a = {0};
+  matrix_t b = {0};
+  matrix_t big = {0};
+
+  s21_arena_create(4096, &arena);
+  s21_arena_matrix(&arena, 3, 3, &a);
+  s21_init_matrix(1.0, &a);
+
+  arena_mark_t mark = s21_arena_mark(&arena);
+  ck_assert_int_eq(s21_arena_matrix(&arena, 2, 2, &b), OK);
+  double **first = b.matrix;
+  ck_assert_int_eq(s21_arena_matrix(&arena, 100, 100, &big), OK);
+  s21_arena_release(&arena, mark);
+
+  ck_assert_int_eq(s21_arena_matrix(&arena, 2, 2, &b), OK);
+  ck_assert_ptr_eq(b.matrix, first);
+  ck_assert_double_eq(a.matrix[2][2], 9.0);
+  s21_arena_destroy(&arena);
+}
+END_TEST
+
+START_TEST(s21_arena_reset_01) {
+  arena_t arena = {0};
+  matrix_t a = {0};
+  matrix_t b = {0};
+
+  s21_arena_create(4096, &arena);
+  s21_arena_matrix(&arena, 3, 3, &a);
+  s21_arena_matrix(&arena, 100, 100, &b);
+  s21_arena_reset(&arena);
+  ck_assert_int_eq(s21_arena_matrix(&arena, 3, 3, &b), OK);
+  ck_assert_ptr_eq(b.matrix, a.matrix);
+  s21_arena_destroy(&arena);
+}
+END_TEST
+
+START_TEST(s21_arena_destroy_01) {
+  arena_t arena = {0};
+  matrix_t a = {0};
+
+  s21_arena_create(4096, &arena);
+  s21_arena_matrix(&arena, 100, 100, &a);
+  s21_arena_destroy(&arena);
+  ck_assert_ptr_null(arena.first);
+  s21_arena_destroy(&arena);
+}
+END_TEST
+
+START_TEST(s21_expr_eval_01) {
+  matrix_t a = {0}, b = {0}, c = {0}, r = {0};
+  s21_create_matrix(37, 41, &a);
+  s21_create_matrix(37, 41, &b);
+  s21_create_matrix(37, 41, &c);
+  s21_init_matrix(1.0, &a);
+  s21_init_matrix(-3.0, &b);
+  s21_init_matrix(0.5, &c);
+
+  s21_expr_t e;
+  s21_expr_init(&e);
+  s21_expr_load(&e, &a);
+  s21_expr_scale(&e, 2.0);
+  s21_expr_load(&e, &b);
+  s21_expr_add(&e);
+  s21_expr_load(&e, &c);
+  s21_expr_load(&e, &a);
+  s21_expr_hadamard(&e);
+  ck_assert_int_eq(s21_expr_sub(&e), OK);
+  ck_assert_int_eq(s21_expr_eval(&e, &r), OK);
+  int ok = 1;
+  for (int i = 0; i < a.rows; i++) {
+    for (int j = 0; j < a.columns; j++) {
+      double x = a.matrix[i][j], y = b.matrix[i][j], z = c.matrix[i][j];
+      ok &= r.matrix[i][j] == 2 * x + y - z * x;
+    }
+  }
+  ck_assert_int_eq(ok, 1);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&c);
+  s21_remove_matrix(&r);
+}
+END_TEST
+
+START_TEST(s21_expr_eval_02) {
+  matrix_t a = {0}, r = {0};
+  s21_create_matrix(3, 3, &a);
+
+  s21_expr_t e;
+  s21_expr_init(&e);
+  s21_expr_load(&e, &a);
+  ck_assert_int_eq(s21_expr_add(&e), CALC_ERROR);
+  ck_assert_int_eq(s21_expr_eval(&e, &r), CALC_ERROR);
+  ck_assert_ptr_null(r.matrix);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_expr_eval_into_01) {
+  matrix_t a = {0}, b = {0}, r = {0};
+  s21_create_matrix(37, 41, &a);
+  s21_create_matrix(37, 41, &b);
+  s21_init_matrix(1.0, &a);
+  s21_init_matrix(-3.0, &b);
+
+  s21_expr_t e;
+  s21_expr_init(&e);
+  s21_expr_load(&e, &a);
+  s21_expr_load(&e, &b);
+  s21_expr_load(&e, &a);
+  s21_expr_hadamard(&e);
+  s21_expr_sub(&e);
+  ck_assert_int_eq(s21_expr_eval(&e, &r), OK);
+  ck_assert_int_eq(s21_expr_eval_into(&e, &a), OK);
+  ck_assert_int_eq(s21_eq_matrix(&a, &r), SUCCESS);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&r);
+}
+END_TEST
+
+START_TEST(s21_expr_eval_into_02) {
+  matrix_t a = {0}, b = {0};
+  s21_create_matrix(3, 3, &a);
+  s21_create_matrix(3, 3, &b);
+
+  s21_expr_t e;
+  s21_expr_init(&e);
+  s21_expr_load(&e, &a);
+  s21_expr_load(&e, &b);
+  ck_assert_int_eq(s21_expr_eval_into(&e, &a), CALC_ERROR);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_expr_eval_into_03) {
+  matrix_t a = {0}, b = {0};
+  s21_create_matrix(37, 41, &a);
+  s21_create_matrix(37, 41, &b);
+  a.matrix[3][4] = DBL_MAX;
+
+  s21_expr_t e;
+  s21_expr_init(&e);
+  s21_expr_load(&e, &a);
+  s21_expr_scale(&e, 4.0);
+  ck_assert_int_eq(s21_expr_eval_into(&e, &b), CALC_ERROR);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_expr_eval_into_04) {
+  matrix_t a = {0}, b = {0}, r = {0};
+  s21_create_matrix(4, 5, &a);
+  s21_create_matrix(4, 5, &b);
+  s21_create_matrix(4, 5, &r);
+
+  s21_expr_t e;
+  s21_expr_init(&e);
+  s21_expr_load(&e, &a);
+  s21_expr_load(&e, &b);
+  ck_assert_int_eq(s21_expr_add(&e), OK);
+  ck_assert_int_eq(s21_expr_eval_into(&e, &r), OK);
+
+  s21_remove_matrix(&b);
+  ck_assert_int_eq(s21_expr_eval_into(&e, &r), INCORRECT_MATRIX);
+  s21_remove_matrix(&r);
+  ck_assert_int_eq(s21_expr_eval(&e, &r), INCORRECT_MATRIX);
+  ck_assert_ptr_null(r.matrix);
+
+  s21_create_matrix(5, 4, &b);
+  ck_assert_int_eq(s21_expr_eval(&e, &r), CALC_ERROR);
+  ck_assert_ptr_null(r.matrix);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_expr_load_01) {
+  matrix_t a = {0}, r = {0};
+  s21_create_matrix(3, 3, &a);
+  s21_create_matrix(2, 2, &r);
+
+  s21_expr_t e;
+  s21_expr_init(&e);
+  s21_expr_load(&e, &a);
+  ck_assert_int_eq(s21_expr_load(&e, &r), CALC_ERROR);
+  ck_assert_int_eq(s21_expr_add(&e), CALC_ERROR);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&r);
+}
+END_TEST
+
+START_TEST(s21_expr_load_02) {
+  s21_expr_t e;
+  s21_expr_init(&e);
+  ck_assert_int_eq(s21_expr_load(&e, NULL), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_expr_scale(&e, 2.0), INCORRECT_MATRIX);
+}
+END_TEST
+
+/*
+ * Заполняет count матриц 3 x 3 подряд псевдослучайными значениями; матрица
+ * с номером 5 вырождена.
+ */
+static void batch_source(double *src, int count) {
+  unsigned seed = 7;
+  for (int i = 0; i < count * 9; i++) {
+    seed = seed * 1103515245 + 12345;
+    src[i] = (double)(seed >> 16 & 0x7fff) / 0x7fff - 0.5;
+  }
+  for (int i = 0; i < 9; i++) src[5 * 9 + i] = i % 3;
+}
+
+START_TEST(s21_create_batch_01) {
+  s21_batch_t a = {0};
+  ck_assert_int_eq(s21_create_batch(3, 2, 21, &a), OK);
+  ck_assert_int_eq(a.stride % BATCH_LANES, 0);
+  ck_assert_int_ge(a.stride, 21);
+  ck_assert_int_eq((size_t)a.data % MATRIX_ALIGN, 0);
+  ck_assert_double_eq(a.data[5 * a.stride + 20], 0.0);
+  s21_remove_batch(&a);
+  ck_assert_ptr_null(a.data);
+}
+END_TEST
+
+START_TEST(s21_create_batch_02) {
+  s21_batch_t a = {0};
+  ck_assert_int_eq(s21_create_batch(9, 9, 1, &a), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_create_batch(3, 3, 0, &a), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_create_batch(0, 3, 1, &a), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_create_batch(3, 3, 1, NULL), INCORRECT_MATRIX);
+  ck_assert_ptr_null(a.data);
+}
+END_TEST
+
+START_TEST(s21_batch_pack_01) {
+  double src[21 * 9], back[21 * 10];
+  batch_source(src, 21);
+  s21_batch_t a = {0};
+  s21_create_batch(3, 3, 21, &a);
+  ck_assert_int_eq(s21_batch_pack(src, 9, &a), OK);
+  ck_assert_double_eq(a.data[4 * a.stride + 7], src[7 * 9 + 4]);
+  ck_assert_int_eq(s21_batch_unpack(&a, back, 10), OK);
+  for (int b = 0; b < 21; b++) {
+    for (int e = 0; e < 9; e++) {
+      ck_assert_double_eq(back[b * 10 + e], src[b * 9 + e]);
+    }
+  }
+  ck_assert_int_eq(s21_batch_pack(src, 8, &a), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_batch_pack(NULL, 9, &a), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_batch_unpack(&a, back, 8), INCORRECT_MATRIX);
+  s21_remove_batch(&a);
+}
+END_TEST
+
+START_TEST(s21_batch_determinant_01) {
+  double src[21 * 9], det[21];
+  batch_source(src, 21);
+  s21_batch_t a = {0};
+  s21_create_batch(3, 3, 21, &a);
+  s21_batch_pack(src, 9, &a);
+  ck_assert_int_eq(s21_batch_determinant(&a, det), OK);
+  for (int b = 0; b < 21; b++) {
+    matrix_t m = {0};
+    double expected = 0;
+    s21_create_matrix(3, 3, &m);
+    memcpy(m.matrix[0], src + b * 9, sizeof(double) * 9);
+    s21_determinant(&m, &expected);
+    ck_assert_double_eq_tol(det[b], expected, 1e-12);
+    s21_remove_matrix(&m);
+  }
+  ck_assert_double_eq_tol(det[5], 0, 1e-12);
+  ck_assert_int_eq(s21_batch_determinant(&a, NULL), INCORRECT_MATRIX);
+  s21_remove_batch(&a);
+}
+END_TEST
+
+START_TEST(s21_batch_inverse_01) {
+  double src[21 * 9], out[21 * 9];
+  batch_source(src, 21);
+  s21_batch_t a = {0}, inv = {0}, prod = {0};
+  s21_create_batch(3, 3, 21, &a);
+  s21_batch_pack(src, 9, &a);
+  ck_assert_int_eq(s21_batch_inverse(&a, &inv), CALC_ERROR);
+  ck_assert_int_eq(s21_batch_mult(&a, &inv, &prod), OK);
+  s21_batch_unpack(&prod, out, 9);
+  for (int b = 0; b < 21; b++) {
+    for (int e = 0; e < 9; e++) {
+      if (b == 5) {
+        ck_assert(isnan(out[b * 9 + e]));
+      } else {
+        ck_assert_double_eq_tol(out[b * 9 + e], e % 4 == 0, 1e-9);
+      }
+    }
+  }
+  s21_remove_batch(&a);
+  s21_remove_batch(&inv);
+  s21_remove_batch(&prod);
+}
+END_TEST
+
+START_TEST(s21_batch_inverse_02) {
+  s21_batch_t a = {0}, inv = {0};
+  s21_create_batch(3, 2, 4, &a);
+  ck_assert_int_eq(s21_batch_inverse(&a, &inv), CALC_ERROR);
+  ck_assert_ptr_null(inv.data);
+  ck_assert_int_eq(s21_batch_inverse(&a, NULL), INCORRECT_MATRIX);
+  s21_remove_batch(&a);
+}
+END_TEST
+
+START_TEST(s21_batch_mult_01) {
+  double src[21 * 9], out[21 * 6];
+  batch_source(src, 21);
+  s21_batch_t a = {0}, b = {0}, prod = {0};
+  s21_create_batch(3, 3, 21, &a);
+  s21_create_batch(3, 2, 21, &b);
+  s21_batch_pack(src, 9, &a);
+  s21_batch_pack(src, 9, &b);
+  ck_assert_int_eq(s21_batch_mult(&a, &b, &prod), OK);
+  s21_batch_unpack(&prod, out, 6);
+  for (int k = 0; k < 21; k++) {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 2; j++) {
+        double sum = 0;
+        for (int p = 0; p < 3; p++) {
+          sum += src[k * 9 + i * 3 + p] * src[k * 9 + p * 2 + j];
+        }
+        ck_assert_double_eq_tol(out[k * 6 + i * 2 + j], sum, 1e-12);
+      }
+    }
+  }
+  s21_remove_batch(&a);
+  s21_remove_batch(&b);
+  s21_remove_batch(&prod);
+}
+END_TEST
+
+START_TEST(s21_batch_mult_02) {
+  s21_batch_t a = {0}, b = {0}, other = {0};
+  s21_create_batch(3, 3, 21, &a);
+  s21_create_batch(3, 3, 21, &b);
+  s21_create_batch(3, 3, 20, &other);
+  ck_assert_int_eq(s21_batch_mult(&a, &b, NULL), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_batch_mult_into(&a, &b, &a), CALC_ERROR);
+  ck_assert_int_eq(s21_batch_mult_into(&a, &b, &other), CALC_ERROR);
+  ck_assert_int_eq(s21_batch_mult(&a, &other, &b), CALC_ERROR);
+  s21_remove_batch(&a);
+  s21_remove_batch(&b);
+  s21_remove_batch(&other);
+}
+END_TEST
+
+START_TEST(s21_batch_transpose_01) {
+  double src[21 * 9], back[21 * 9];
+  batch_source(src, 21);
+  s21_batch_t a = {0}, t = {0}, tt = {0};
+  s21_create_batch(3, 3, 21, &a);
+  s21_create_batch(3, 3, 21, &tt);
+  s21_batch_pack(src, 9, &a);
+  ck_assert_int_eq(s21_batch_transpose(&a, &t), OK);
+  s21_batch_unpack(&t, back, 9);
+  for (int b = 0; b < 21; b++) {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        ck_assert_double_eq(back[b * 9 + j * 3 + i], src[b * 9 + i * 3 + j]);
+      }
+    }
+  }
+  ck_assert_int_eq(s21_batch_transpose_into(&t, &tt), OK);
+  ck_assert_double_eq(tt.data[1 * tt.stride + 4], src[4 * 9 + 1]);
+  s21_remove_batch(&a);
+  s21_remove_batch(&t);
+  s21_remove_batch(&tt);
+}
+END_TEST
+
+START_TEST(s21_batch_transpose_02) {
+  s21_batch_t a = {0}, t = {0};
+  s21_create_batch(3, 2, 5, &a);
+  s21_create_batch(3, 2, 5, &t);
+  ck_assert_int_eq(s21_batch_transpose_into(&a, &a), CALC_ERROR);
+  ck_assert_int_eq(s21_batch_transpose_into(&a, &t), CALC_ERROR);
+  ck_assert_int_eq(s21_batch_transpose(&a, NULL), INCORRECT_MATRIX);
+  s21_remove_batch(&a);
+  s21_remove_batch(&t);
+}
+END_TEST
+
+/*
+ * Создаёт матрицы a и b порядка n для проверок малых порядков: a — хорошо
+ * обусловленная псевдослучайная матрица, b — целочисленная.
+ */
+static void small_operands(int n, unsigned seed, matrix_t *a, matrix_t *b) {
+  s21_create_matrix(n, n, a);
+  s21_create_matrix(n, n, b);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      seed = seed * 1103515245 + 12345;
+      double value = (double)(seed >> 16 & 0x7fff) / 0x7fff - 0.5;
+      a->matrix[i][j] = value + (i == j);
+      b->matrix[i][j] = i * n - j;
+    }
+  }
+}
+
+START_TEST(s21_small_determinant_01) {
+  for (int n = 2; n <= 4; n++) {
+    matrix_t a = {0}, b = {0}, comp = {0};
+    small_operands(n, 11 + n, &a, &b);
+    double det = 0, expansion = 0;
+    ck_assert_int_eq(s21_determinant(&a, &det), OK);
+    s21_calc_complements(&a, &comp);
+    for (int j = 0; j < n; j++) expansion += a.matrix[0][j] * comp.matrix[0][j];
+    ck_assert_double_eq_tol(det, expansion, 1e-12);
+    s21_remove_matrix(&a);
+    s21_remove_matrix(&b);
+    s21_remove_matrix(&comp);
+  }
+}
+END_TEST
+
+START_TEST(s21_small_inverse_01) {
+  for (int n = 2; n <= 4; n++) {
+    matrix_t a = {0}, b = {0}, inv = {0};
+    small_operands(n, 11 + n, &a, &b);
+    ck_assert_int_eq(s21_inverse_matrix(&a, &inv), OK);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        double identity = 0;
+        for (int p = 0; p < n; p++) {
+          identity += a.matrix[i][p] * inv.matrix[p][j];
+        }
+        ck_assert_double_eq_tol(identity, i == j, 1e-12);
+      }
+    }
+    s21_remove_matrix(&a);
+    s21_remove_matrix(&b);
+    s21_remove_matrix(&inv);
+  }
+}
+END_TEST
+
+START_TEST(s21_small_inverse_02) {
+  matrix_t singular = {0}, result = {0};
+  s21_create_matrix(3, 3, &singular);
+  for (int i = 0; i < 9; i++) singular.matrix[i / 3][i % 3] = i % 3;
+  ck_assert_int_eq(s21_inverse_matrix(&singular, &result), CALC_ERROR);
+  ck_assert_ptr_null(result.matrix);
+  s21_remove_matrix(&singular);
+}
+END_TEST
+
+START_TEST(s21_small_complements_01) {
+  for (int n = 2; n <= 4; n++) {
+    matrix_t a = {0}, b = {0}, inv = {0}, comp = {0};
+    small_operands(n, 11 + n, &a, &b);
+    double det = 0;
+    s21_determinant(&a, &det);
+    s21_inverse_matrix(&a, &inv);
+    ck_assert_int_eq(s21_calc_complements(&a, &comp), OK);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        ck_assert_double_eq_tol(comp.matrix[j][i] / det, inv.matrix[i][j],
+                                1e-12);
+      }
+    }
+    s21_remove_matrix(&a);
+    s21_remove_matrix(&b);
+    s21_remove_matrix(&inv);
+    s21_remove_matrix(&comp);
+  }
+}
+END_TEST
+
+START_TEST(s21_small_mult_01) {
+  for (int n = 2; n <= 4; n++) {
+    matrix_t a = {0}, b = {0}, prod = {0};
+    small_operands(n, 11 + n, &a, &b);
+    ck_assert_int_eq(s21_mult_matrix(&a, &b, &prod), OK);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        double sum = 0;
+        for (int p = 0; p < n; p++) sum += a.matrix[i][p] * b.matrix[p][j];
+        ck_assert_double_eq(prod.matrix[i][j], sum);
+      }
+    }
+    s21_remove_matrix(&a);
+    s21_remove_matrix(&b);
+    s21_remove_matrix(&prod);
+  }
+}
+END_TEST
+
+/*
+ * Создаёт систему из n уравнений с k правыми частями: псевдослучайную
+ * матрицу a и целочисленные правые части b.
+ */
+static void solve_operands(int n, int k, matrix_t *a, matrix_t *b) {
+  s21_create_matrix(n, n, a);
+  s21_create_matrix(n, k, b);
+  unsigned seed = 3;
+  for (int i = 0; i < n * n; i++) {
+    seed = seed * 1103515245 + 12345;
+    a->matrix[i / n][i % n] = (double)(seed >> 16 & 0x7fff) / 0x7fff - 0.5;
+  }
+  for (int i = 0; i < n * k; i++) b->matrix[i / k][i % k] = i % 5 - 2;
+}
+
+/*
+ * Создаёт вырожденную матрицу 5 x 5, последняя строка которой равна сумме
+ * первых двух, и правую часть из одного столбца.
+ */
+static void dependent_operands(matrix_t *a, matrix_t *b) {
+  double values[4][5] = {{4, 9, 3, 6, 8},
+                         {2, 1, 8, 5, 9},
+                         {4, 4, 8, 9, 9},
+                         {8, 7, 3, 4, 3}};
+  s21_create_matrix(5, 5, a);
+  s21_create_matrix(5, 1, b);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 5; j++) a->matrix[i][j] = values[i][j];
+    b->matrix[i][0] = i;
+  }
+  for (int j = 0; j < 5; j++) {
+    a->matrix[4][j] = a->matrix[0][j] + a->matrix[1][j];
+  }
+}
+
+START_TEST(s21_solve_01) {
+  matrix_t a = {0}, b = {0}, x = {0}, ax = {0};
+  solve_operands(7, 3, &a, &b);
+  ck_assert_int_eq(s21_solve(&a, &b, &x), OK);
+  ck_assert_int_eq(s21_mult_matrix(&a, &x, &ax), OK);
+  for (int i = 0; i < 7; i++) {
+    for (int j = 0; j < 3; j++) {
+      ck_assert_double_eq_tol(ax.matrix[i][j], b.matrix[i][j], 1e-12);
+    }
+  }
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&x);
+  s21_remove_matrix(&ax);
+}
+END_TEST
+
+START_TEST(s21_solve_02) {
+  matrix_t a = {0}, b = {0}, x = {0}, singular = {0};
+  solve_operands(7, 3, &a, &b);
+  s21_create_matrix(7, 7, &singular);
+  ck_assert_int_eq(s21_solve(&singular, &b, &x), CALC_ERROR);
+  ck_assert_ptr_null(x.matrix);
+  ck_assert_int_eq(s21_solve(&a, &singular, NULL), INCORRECT_MATRIX);
+  s21_remove_matrix(&singular);
+  s21_create_matrix(6, 3, &singular);
+  ck_assert_int_eq(s21_solve(&a, &singular, &x), CALC_ERROR);
+  ck_assert_int_eq(s21_solve(&singular, &b, &x), CALC_ERROR);
+  ck_assert_ptr_null(x.matrix);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&singular);
+}
+END_TEST
+
+START_TEST(s21_solve_03) {
+  matrix_t a = {0}, b = {0}, x = {0};
+  dependent_operands(&a, &b);
+  ck_assert_int_eq(s21_solve(&a, &b, &x), CALC_ERROR);
+  ck_assert_ptr_null(x.matrix);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_factor_lu_01) {
+  matrix_t a = {0}, b = {0}, x = {0}, y = {0};
+  solve_operands(7, 3, &a, &b);
+  s21_factor_t lu = {0};
+  s21_solve(&a, &b, &x);
+  ck_assert_int_eq(s21_factor_lu(&a, &lu), OK);
+  ck_assert_int_eq(s21_factor_solve(&lu, &b, &y), OK);
+  ck_assert_int_eq(s21_eq_matrix(&x, &y), SUCCESS);
+  s21_factor_remove(&lu);
+  ck_assert_ptr_null(lu.data);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&x);
+  s21_remove_matrix(&y);
+}
+END_TEST
+
+START_TEST(s21_factor_lu_02) {
+  matrix_t singular = {0}, b = {0}, x = {0};
+  s21_create_matrix(7, 7, &singular);
+  s21_create_matrix(7, 3, &b);
+  s21_factor_t lu = {0};
+  int rank = 7;
+  ck_assert_int_eq(s21_factor_lu(&singular, &lu), OK);
+  ck_assert_int_eq(s21_factor_rank(&lu, &rank), OK);
+  ck_assert_int_eq(rank, 0);
+  ck_assert_int_eq(s21_factor_solve(&lu, &b, &x), CALC_ERROR);
+  ck_assert_ptr_null(x.matrix);
+  s21_factor_remove(&lu);
+  s21_remove_matrix(&singular);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_factor_lu_03) {
+  matrix_t a = {0}, b = {0}, x = {0}, inv = {0};
+  dependent_operands(&a, &b);
+  s21_factor_t lu = {0};
+  double determ = 1;
+  int rank = 0;
+  ck_assert_int_eq(s21_factor_lu(&a, &lu), OK);
+  ck_assert_int_eq(s21_factor_rank(&lu, &rank), OK);
+  ck_assert_int_eq(rank, 4);
+  ck_assert_int_eq(s21_factor_determinant(&lu, &determ), OK);
+  ck_assert_double_eq(determ, 0);
+  ck_assert_int_eq(s21_factor_solve(&lu, &b, &x), CALC_ERROR);
+  ck_assert_ptr_null(x.matrix);
+  ck_assert_int_eq(s21_factor_inverse(&lu, &inv), CALC_ERROR);
+  ck_assert_ptr_null(inv.matrix);
+  s21_factor_remove(&lu);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_factor_lu_04) {
+  matrix_t wide = {0};
+  s21_factor_t lu = {0};
+  s21_create_matrix(3, 4, &wide);
+  ck_assert_int_eq(s21_factor_lu(&wide, &lu), CALC_ERROR);
+  ck_assert_ptr_null(lu.data);
+  ck_assert_int_eq(s21_factor_lu(NULL, &lu), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_factor_lu(&wide, NULL), INCORRECT_MATRIX);
+  s21_remove_matrix(&wide);
+}
+END_TEST
+
+START_TEST(s21_factor_solve_01) {
+  matrix_t a = {0}, b = {0}, x = {0}, none = {0};
+  solve_operands(7, 3, &a, &b);
+  s21_factor_t lu = {0};
+  s21_factor_lu(&a, &lu);
+  s21_create_matrix(6, 3, &none);
+  ck_assert_int_eq(s21_factor_solve(&lu, &none, &x), CALC_ERROR);
+  ck_assert_ptr_null(x.matrix);
+  ck_assert_int_eq(s21_factor_solve(&lu, &b, NULL), INCORRECT_MATRIX);
+  s21_factor_remove(&lu);
+  ck_assert_int_eq(s21_factor_solve(&lu, &b, &x), INCORRECT_MATRIX);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&none);
+}
+END_TEST
+
+START_TEST(s21_factor_solve_into_01) {
+  matrix_t a = {0}, b = {0}, x = {0}, in_place = {0};
+  solve_operands(7, 3, &a, &b);
+  s21_factor_t lu = {0};
+  s21_solve(&a, &b, &x);
+  s21_factor_lu(&a, &lu);
+  s21_create_matrix(7, 3, &in_place);
+  memcpy(in_place.matrix[0], b.matrix[0], sizeof(double) * 7 * 3);
+  ck_assert_int_eq(s21_factor_solve_into(&lu, &in_place, &in_place), OK);
+  ck_assert_int_eq(s21_eq_matrix(&in_place, &x), SUCCESS);
+  s21_factor_remove(&lu);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&x);
+  s21_remove_matrix(&in_place);
+}
+END_TEST
+
+START_TEST(s21_factor_solve_into_02) {
+  matrix_t a = {0}, b = {0};
+  solve_operands(7, 3, &a, &b);
+  s21_factor_t lu = {0};
+  s21_factor_lu(&a, &lu);
+  ck_assert_int_eq(s21_factor_solve_into(&lu, &b, &a), CALC_ERROR);
+  ck_assert_int_eq(s21_factor_solve_into(&lu, &b, NULL), INCORRECT_MATRIX);
+  s21_factor_remove(&lu);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+/*
+ * Создаёт псевдослучайную матрицу m порядка n, симметричную положительно
+ * определённую spd = m * m^T + E и правую часть b из одного столбца.
+ */
+static void factor_operands(int n, matrix_t *m, matrix_t *spd, matrix_t *b) {
+  matrix_t mt = {0};
+  s21_create_matrix(n, n, m);
+  s21_create_matrix(n, 1, b);
+  unsigned seed = 9;
+  for (int i = 0; i < n * n; i++) {
+    seed = seed * 1103515245 + 12345;
+    m->matrix[i / n][i % n] = (double)(seed >> 16 & 0x7fff) / 0x7fff - 0.5;
+  }
+  for (int i = 0; i < n; i++) b->matrix[i][0] = i % 7 - 3;
+  s21_transpose(m, &mt);
+  s21_mult_matrix(m, &mt, spd);
+  for (int i = 0; i < n; i++) spd->matrix[i][i] += 1;
+  s21_remove_matrix(&mt);
+}
+
+/*
+ * Создаёт матрицы 8 x 4 с последним столбцом, равным сумме первых двух
+ * (ранг 3), 8 x 3 полного ранга из тех же столбцов и правую часть rhs.
+ */
+static void least_squares_operands(matrix_t *tall, matrix_t *narrow,
+                                   matrix_t *rhs) {
+  matrix_t m = {0}, spd = {0}, b = {0};
+  factor_operands(8, &m, &spd, &b);
+  s21_create_matrix(8, 4, tall);
+  s21_create_matrix(8, 3, narrow);
+  s21_create_matrix(8, 1, rhs);
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 3; j++) {
+      tall->matrix[i][j] = narrow->matrix[i][j] = m.matrix[i][j];
+    }
+    tall->matrix[i][3] = tall->matrix[i][0] + tall->matrix[i][1];
+    rhs->matrix[i][0] = i;
+  }
+  s21_remove_matrix(&m);
+  s21_remove_matrix(&spd);
+  s21_remove_matrix(&b);
+}
+
+START_TEST(s21_factor_cholesky_01) {
+  matrix_t m = {0}, spd = {0}, b = {0}, x_lu = {0}, x_ch = {0};
+  factor_operands(70, &m, &spd, &b);
+  s21_factor_t lu = {0}, ch = {0};
+  s21_factor_lu(&spd, &lu);
+  ck_assert_int_eq(s21_factor_cholesky(&spd, &ch), OK);
+  s21_factor_solve(&lu, &b, &x_lu);
+  ck_assert_int_eq(s21_factor_solve(&ch, &b, &x_ch), OK);
+  for (int i = 0; i < 70; i++) {
+    ck_assert_double_eq_tol(x_ch.matrix[i][0], x_lu.matrix[i][0], 1e-9);
+  }
+  s21_factor_remove(&lu);
+  s21_factor_remove(&ch);
+  matrix_t *all[] = {&m, &spd, &b, &x_lu, &x_ch};
+  for (int i = 0; i < 5; i++) s21_remove_matrix(all[i]);
+}
+END_TEST
+
+START_TEST(s21_factor_cholesky_02) {
+  matrix_t m = {0}, spd = {0}, b = {0};
+  factor_operands(70, &m, &spd, &b);
+  s21_factor_t ch = {0};
+  ck_assert_int_eq(s21_factor_cholesky(&m, &ch), CALC_ERROR);
+  ck_assert_ptr_null(ch.data);
+  s21_remove_matrix(&m);
+  s21_remove_matrix(&spd);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_factor_qr_01) {
+  matrix_t m = {0}, spd = {0}, b = {0}, x_lu = {0}, x_qr = {0};
+  factor_operands(70, &m, &spd, &b);
+  s21_factor_t lu = {0}, qr = {0};
+  int rank = 0;
+  s21_factor_lu(&spd, &lu);
+  ck_assert_int_eq(s21_factor_qr(&spd, &qr), OK);
+  s21_factor_solve(&lu, &b, &x_lu);
+  ck_assert_int_eq(s21_factor_solve(&qr, &b, &x_qr), OK);
+  for (int i = 0; i < 70; i++) {
+    ck_assert_double_eq_tol(x_qr.matrix[i][0], x_lu.matrix[i][0], 1e-9);
+  }
+  ck_assert_int_eq(s21_factor_rank(&qr, &rank), OK);
+  ck_assert_int_eq(rank, 70);
+  s21_factor_remove(&lu);
+  s21_factor_remove(&qr);
+  matrix_t *all[] = {&m, &spd, &b, &x_lu, &x_qr};
+  for (int i = 0; i < 5; i++) s21_remove_matrix(all[i]);
+}
+END_TEST
+
+START_TEST(s21_factor_qr_02) {
+  matrix_t tall = {0}, narrow = {0}, rhs = {0}, x = {0};
+  least_squares_operands(&tall, &narrow, &rhs);
+  s21_factor_t qr = {0};
+  double det = 0;
+  int rank = 0;
+  ck_assert_int_eq(s21_factor_qr(&tall, &qr), OK);
+  s21_factor_rank(&qr, &rank);
+  ck_assert_int_eq(rank, 3);
+  ck_assert_int_eq(s21_factor_solve(&qr, &rhs, &x), CALC_ERROR);
+  ck_assert_ptr_null(x.matrix);
+  ck_assert_int_eq(s21_factor_determinant(&qr, &det), CALC_ERROR);
+  s21_factor_remove(&qr);
+  s21_remove_matrix(&tall);
+  s21_remove_matrix(&narrow);
+  s21_remove_matrix(&rhs);
+}
+END_TEST
+
+START_TEST(s21_factor_qr_03) {
+  matrix_t tall = {0}, narrow = {0}, rhs = {0}, x = {0};
+  least_squares_operands(&tall, &narrow, &rhs);
+  s21_factor_t qr = {0};
+  ck_assert_int_eq(s21_factor_qr(&narrow, &qr), OK);
+  ck_assert_int_eq(s21_factor_solve(&qr, &rhs, &x), OK);
+  for (int j = 0; j < 3; j++) {
+    double normal = 0;
+    for (int i = 0; i < 8; i++) {
+      double residual = rhs.matrix[i][0];
+      for (int p = 0; p < 3; p++) {
+        residual -= narrow.matrix[i][p] * x.matrix[p][0];
+      }
+      normal += narrow.matrix[i][j] * residual;
+    }
+    ck_assert_double_eq_tol(normal, 0, 1e-12);
+  }
+  s21_factor_remove(&qr);
+  matrix_t *all[] = {&tall, &narrow, &rhs, &x};
+  for (int i = 0; i < 4; i++) s21_remove_matrix(all[i]);
+}
+END_TEST
+
+START_TEST(s21_factor_qr_04) {
+  matrix_t wide = {0};
+  s21_factor_t qr = {0};
+  s21_create_matrix(3, 8, &wide);
+  ck_assert_int_eq(s21_factor_qr(&wide, &qr), CALC_ERROR);
+  ck_assert_ptr_null(qr.data);
+  ck_assert_int_eq(s21_factor_qr(&wide, NULL), INCORRECT_MATRIX);
+  s21_remove_matrix(&wide);
+}
+END_TEST
+
+START_TEST(s21_factor_determinant_01) {
+  matrix_t m = {0}, spd = {0}, b = {0};
+  factor_operands(70, &m, &spd, &b);
+  s21_factor_t lu = {0}, ch = {0}, qr = {0};
+  s21_factor_lu(&spd, &lu);
+  s21_factor_cholesky(&spd, &ch);
+  s21_factor_qr(&spd, &qr);
+  double det_lu = 0, det_ch = 0, det_qr = 0;
+  ck_assert_int_eq(s21_factor_determinant(&lu, &det_lu), OK);
+  ck_assert_int_eq(s21_factor_determinant(&ch, &det_ch), OK);
+  ck_assert_int_eq(s21_factor_determinant(&qr, &det_qr), OK);
+  ck_assert_double_eq_tol(det_ch / det_lu, 1, 1e-9);
+  ck_assert_double_eq_tol(det_qr / det_lu, 1, 1e-9);
+  ck_assert_int_eq(s21_factor_determinant(&lu, NULL), INCORRECT_MATRIX);
+  s21_factor_remove(&lu);
+  s21_factor_remove(&ch);
+  s21_factor_remove(&qr);
+  s21_remove_matrix(&m);
+  s21_remove_matrix(&spd);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_factor_inverse_01) {
+  matrix_t m = {0}, spd = {0}, b = {0}, inv = {0}, check = {0};
+  factor_operands(70, &m, &spd, &b);
+  s21_factor_t ch = {0};
+  s21_factor_cholesky(&spd, &ch);
+  ck_assert_int_eq(s21_factor_inverse(&ch, &inv), OK);
+  s21_mult_matrix(&spd, &inv, &check);
+  for (int i = 0; i < 70 * 70; i++) {
+    ck_assert_double_eq_tol(check.matrix[i / 70][i % 70], i / 70 == i % 70,
+                            1e-9);
+  }
+  ck_assert_int_eq(s21_factor_inverse(&ch, NULL), INCORRECT_MATRIX);
+  s21_factor_remove(&ch);
+  ck_assert_int_eq(s21_factor_inverse(&ch, &inv), INCORRECT_MATRIX);
+  matrix_t *all[] = {&m, &spd, &b, &inv, &check};
+  for (int i = 0; i < 5; i++) s21_remove_matrix(all[i]);
+}
+END_TEST
+
+/*
+ * Создаёт разреженную матрицу 40 x 30: в каждой строке сохраняются три
+ * элемента общего генератора, остальные обнуляются.
+ */
+static void sparse_operand(matrix_t *dense) {
+  s21_random_matrix(40, 30, 17, dense);
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 30; j++) {
+      if ((i * 7 + j) % 10 != 0) dense->matrix[i][j] = 0;
+    }
+  }
+}
+
+START_TEST(s21_sparse_01) {
+  matrix_t dense = {0}, b = {0}, expected = {0}, product = {0};
+  sparse_operand(&dense);
+  s21_random_matrix(30, 3, 2, &b);
+  s21_mult_matrix(&dense, &b, &expected);
+
+  s21_sparse_t csr = {0}, csc = {0};
+  ck_assert_int_eq(s21_sparse_from_dense(&dense, SPARSE_CSR, &csr), OK);
+  ck_assert_int_eq(s21_sparse_convert(&csr, SPARSE_CSC, &csc), OK);
+  ck_assert_int_eq(s21_sparse_mult_dense(&csr, &b, &product), OK);
+  ck_assert_int_eq(s21_eq_matrix(&product, &expected), SUCCESS);
+  s21_remove_matrix(&product);
+  ck_assert_int_eq(s21_sparse_mult_dense(&csc, &b, &product), OK);
+  ck_assert_int_eq(s21_eq_matrix(&product, &expected), SUCCESS);
+
+  s21_remove_sparse(&csr);
+  s21_remove_sparse(&csc);
+  s21_remove_matrix(&dense);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&expected);
+  s21_remove_matrix(&product);
+}
+END_TEST
+
+START_TEST(s21_sparse_02) {
+  matrix_t dense = {0};
+  sparse_operand(&dense);
+  double x[30], y[40];
+  for (int j = 0; j < 30; j++) x[j] = j % 5 - 2;
+
+  s21_sparse_t csr = {0}, csc = {0};
+  s21_sparse_from_dense(&dense, SPARSE_CSR, &csr);
+  s21_sparse_from_dense(&dense, SPARSE_CSC, &csc);
+  for (int f = 0; f < 2; f++) {
+    ck_assert_int_eq(s21_sparse_mult_vector(f ? &csc : &csr, x, y), OK);
+    for (int i = 0; i < 40; i++) {
+      double dot = 0;
+      for (int j = 0; j < 30; j++) dot += dense.matrix[i][j] * x[j];
+      ck_assert_double_eq(y[i], dot);
+    }
+  }
+
+  s21_remove_sparse(&csr);
+  s21_remove_sparse(&csc);
+  s21_remove_matrix(&dense);
+}
+END_TEST
+
+START_TEST(s21_sparse_03) {
+  matrix_t dense = {0}, b = {0}, expected = {0}, product = {0};
+  sparse_operand(&dense);
+  s21_random_matrix(30, 3, 2, &b);
+  s21_mult_matrix(&dense, &b, &expected);
+
+  s21_sparse_t csr = {0}, csc = {0};
+  s21_sparse_from_dense(&dense, SPARSE_CSR, &csr);
+  s21_sparse_from_dense(&dense, SPARSE_CSC, &csc);
+  s21_set_num_threads(3);
+  s21_set_parallel_threshold(0);
+  for (int f = 0; f < 2; f++) {
+    ck_assert_int_eq(s21_sparse_mult_dense(f ? &csc : &csr, &b, &product), OK);
+    ck_assert_int_eq(s21_eq_matrix(&product, &expected), SUCCESS);
+    s21_remove_matrix(&product);
+  }
+  s21_set_num_threads(1);
+  s21_set_parallel_threshold(POOL_DEFAULT_THRESHOLD);
+
+  s21_remove_sparse(&csr);
+  s21_remove_sparse(&csc);
+  s21_remove_matrix(&dense);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&expected);
+}
+END_TEST
+
+START_TEST(s21_sparse_04) {
+  matrix_t dense = {0}, back = {0};
+  sparse_operand(&dense);
+
+  s21_sparse_t csr = {0}, csc = {0}, sum = {0}, t = {0}, tt = {0};
+  s21_sparse_from_dense(&dense, SPARSE_CSR, &csr);
+  s21_sparse_from_dense(&dense, SPARSE_CSC, &csc);
+  ck_assert_int_eq(s21_sparse_add(&csr, &csc, &sum), OK);
+  ck_assert_uint_eq(sum.nonzeros, csr.nonzeros);
+  ck_assert_int_eq(s21_sparse_transpose(&sum, &t), OK);
+  ck_assert_int_eq(t.rows, 30);
+  ck_assert_int_eq(s21_sparse_transpose(&t, &tt), OK);
+  ck_assert_int_eq(s21_sparse_to_dense(&tt, &back), OK);
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 30; j++) {
+      ck_assert_double_eq(back.matrix[i][j], 2 * dense.matrix[i][j]);
+    }
+  }
+
+  s21_sparse_t *sparse[] = {&csr, &csc, &sum, &t, &tt};
+  for (int i = 0; i < 5; i++) s21_remove_sparse(sparse[i]);
+  s21_remove_matrix(&dense);
+  s21_remove_matrix(&back);
+}
+END_TEST
+
+START_TEST(s21_sparse_05) {
+  matrix_t dense = {0}, product = {0};
+  sparse_operand(&dense);
+  s21_sparse_t csr = {0};
+  s21_sparse_from_dense(&dense, SPARSE_CSR, &csr);
+
+  ck_assert_int_eq(s21_sparse_mult_dense(&csr, &dense, &product), CALC_ERROR);
+  ck_assert_ptr_null(product.matrix);
+
+  s21_remove_sparse(&csr);
+  s21_remove_matrix(&dense);
+}
+END_TEST
+
+START_TEST(s21_sparse_06) {
+  s21_sparse_t triplets = {0};
+  int r[] = {2, 0, 2, 1, 2}, c[] = {1, 3, 0, 1, 1};
+  double v[] = {1, 2, 3, 4, 5};
+
+  ck_assert_int_eq(
+      s21_sparse_from_triplets(3, 4, 5, r, c, v, SPARSE_CSR, &triplets), OK);
+  ck_assert_uint_eq(triplets.nonzeros, 4);
+  ck_assert_int_eq(triplets.indices[2], 0);
+  ck_assert_double_eq(triplets.values[3], 6);
+  ck_assert_uint_eq(triplets.offsets[3], 4);
+  s21_remove_sparse(&triplets);
+}
+END_TEST
+
+START_TEST(s21_sparse_07) {
+  s21_sparse_t triplets = {0};
+  int r[] = {3, 0, 2, 1, 2}, c[] = {1, 3, 0, 1, 1};
+  double v[] = {1, 2, 3, 4, 5};
+
+  ck_assert_int_eq(
+      s21_sparse_from_triplets(3, 4, 5, r, c, v, SPARSE_CSR, &triplets),
+      INCORRECT_MATRIX);
+  c[0] = 4;
+  r[0] = 0;
+  ck_assert_int_eq(
+      s21_sparse_from_triplets(3, 4, 5, r, c, v, SPARSE_CSR, &triplets),
+      INCORRECT_MATRIX);
+}
+END_TEST
+
+START_TEST(s21_save_matrix_01) {
+  const char *path = "test_io_save.bin";
+  matrix_t a = {0}, loaded = {0};
+  s21_create_matrix(3, 5, &a);
+  for (int i = 0; i < 15; i++) a.matrix[i / 5][i % 5] = i * 0.25 - 1;
+
+  ck_assert_int_eq(s21_save_matrix(&a, path), OK);
+  ck_assert_int_eq(s21_load_matrix(path, &loaded), OK);
+  ck_assert_int_eq(s21_eq_matrix(&a, &loaded), SUCCESS);
+
+  remove(path);
+  s21_remove_matrix(&loaded);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_save_matrix_02) {
+  const char *path = "test_io_rows.bin";
+  matrix_t a = {0}, loaded = {0};
+  s21_create_matrix(3, 5, &a);
+  for (int i = 0; i < 15; i++) a.matrix[i / 5][i % 5] = i * 0.25 - 1;
+  double *row = a.matrix[0];
+  a.matrix[0] = a.matrix[2];
+  a.matrix[2] = row;
+
+  ck_assert_int_eq(s21_save_matrix(&a, path), OK);
+  ck_assert_int_eq(s21_load_matrix(path, &loaded), OK);
+  ck_assert_int_eq(s21_eq_matrix(&a, &loaded), SUCCESS);
+
+  remove(path);
+  a.matrix[2] = a.matrix[0];
+  a.matrix[0] = row;
+  s21_remove_matrix(&loaded);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_save_matrix_03) {
+  matrix_t a = {0};
+  s21_create_matrix(2, 2, &a);
+
+  ck_assert_int_eq(s21_save_matrix(&a, NULL), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_save_matrix(NULL, "test_io_null.bin"),
+                   INCORRECT_MATRIX);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_load_matrix_01) {
+  const char *path = "test_io_magic.bin";
+  matrix_t a = {0}, loaded = {0};
+  s21_create_matrix(2, 3, &a);
+  s21_save_matrix(&a, path);
+  s21_remove_matrix(&a);
+
+  FILE *file = fopen(path, "r+b");
+  fputc('X', file);
+  fclose(file);
+  ck_assert_int_eq(s21_load_matrix(path, &loaded), INCORRECT_MATRIX);
+  ck_assert_ptr_null(loaded.matrix);
+  remove(path);
+}
+END_TEST
+
+START_TEST(s21_load_matrix_02) {
+  matrix_t loaded = {0};
+
+  ck_assert_int_eq(s21_load_matrix("test_io_missing.bin", &loaded),
+                   CALC_ERROR);
+  ck_assert_int_eq(s21_load_matrix(NULL, &loaded), INCORRECT_MATRIX);
+  ck_assert_ptr_null(loaded.matrix);
+}
+END_TEST
+
+START_TEST(s21_load_matrix_03) {
+  const char *path = "test_io_overflow.bin";
+  matrix_t a = {0}, loaded = {0}, mapped = {0};
+  s21_create_matrix(1, 1, &a);
+  ck_assert_int_eq(s21_save_matrix(&a, path), OK);
+  s21_remove_matrix(&a);
+
+  uint64_t rows = (1ull << 30) + 23170, columns = (1ull << 31) - 46339;
+  uint64_t data_size = rows * columns * sizeof(double);
+  ck_assert_uint_eq(data_size, 537552);
+  FILE *file = fopen(path, "r+b");
+  fseek(file, 24, SEEK_SET);
+  fwrite(&rows, sizeof(rows), 1, file);
+  fwrite(&columns, sizeof(columns), 1, file);
+  fseek(file, 48, SEEK_SET);
+  fwrite(&data_size, sizeof(data_size), 1, file);
+  fseek(file, 64 + (long)data_size - 1, SEEK_SET);
+  fputc(0, file);
+  fclose(file);
+
+  ck_assert_int_eq(s21_load_matrix(path, &loaded), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_map_matrix(path, &mapped), INCORRECT_MATRIX);
+  remove(path);
+}
+END_TEST
+
+START_TEST(s21_map_matrix_01) {
+  const char *path = "test_io_map.bin";
+  matrix_t a = {0}, mapped = {0};
+  s21_create_matrix(3, 5, &a);
+  for (int i = 0; i < 15; i++) a.matrix[i / 5][i % 5] = i * 0.25 - 1;
+  s21_save_matrix(&a, path);
+
+  ck_assert_int_eq(s21_map_matrix(path, &mapped), OK);
+  ck_assert_int_eq(s21_eq_matrix(&a, &mapped), SUCCESS);
+  ck_assert_int_eq((uintptr_t)mapped.matrix[0] % MATRIX_ALIGN, 0);
+  s21_unmap_matrix(&mapped);
+  ck_assert_ptr_null(mapped.matrix);
+
+  remove(path);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_map_matrix_02) {
+  const char *path = "test_io_map_magic.bin";
+  matrix_t a = {0}, mapped = {0};
+  s21_create_matrix(2, 3, &a);
+  s21_save_matrix(&a, path);
+  s21_remove_matrix(&a);
+
+  FILE *file = fopen(path, "r+b");
+  fputc('X', file);
+  fclose(file);
+  ck_assert_int_eq(s21_map_matrix(path, &mapped), INCORRECT_MATRIX);
+  ck_assert_ptr_null(mapped.matrix);
+  remove(path);
+}
+END_TEST
+
+static void save_file_operands(const char *a_path, const char *b_path,
+                               matrix_t *expected) {
+  matrix_t a = {0}, b = {0};
+  s21_random_matrix(37, 23, 18, &a);
+  s21_random_matrix(23, 29, 19, &b);
+  s21_save_matrix(&a, a_path);
+  s21_save_matrix(&b, b_path);
+  if (expected != NULL) s21_mult_matrix(&a, &b, expected);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+}
+
+START_TEST(s21_mult_matrix_file_01) {
+  const char *paths[] = {"test_file_a.bin", "test_file_b.bin",
+                         "test_file_c.bin"};
+  matrix_t expected = {0}, c = {0};
+  save_file_operands(paths[0], paths[1], &expected);
+
+  size_t tile = 3 * sizeof(double) + 3 * sizeof(double *);
+  ck_assert_int_eq(s21_mult_matrix_file(paths[0], paths[1], paths[2], tile),
+                   OK);
+  ck_assert_int_eq(s21_load_matrix(paths[2], &c), OK);
+  ck_assert_int_eq(s21_eq_matrix(&expected, &c), SUCCESS);
+
+  for (int i = 0; i < 3; i++) remove(paths[i]);
+  s21_remove_matrix(&c);
+  s21_remove_matrix(&expected);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_file_02) {
+  const char *paths[] = {"test_file_a.bin", "test_file_b.bin",
+                         "test_file_c.bin"};
+  matrix_t expected = {0}, c = {0};
+  save_file_operands(paths[0], paths[1], &expected);
+
+  size_t tile = 3 * sizeof(double) + 3 * sizeof(double *);
+  size_t limits[] = {tile * 64, tile * 100, 1 << 20};
+  for (int i = 0; i < 3; i++) {
+    ck_assert_int_eq(
+        s21_mult_matrix_file(paths[0], paths[1], paths[2], limits[i]), OK);
+    ck_assert_int_eq(s21_load_matrix(paths[2], &c), OK);
+    ck_assert_int_eq(s21_eq_matrix(&expected, &c), SUCCESS);
+    s21_remove_matrix(&c);
+  }
+
+  for (int i = 0; i < 3; i++) remove(paths[i]);
+  s21_remove_matrix(&expected);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_file_03) {
+  const char *paths[] = {"test_file_a.bin", "test_file_b.bin",
+                         "test_file_c.bin"};
+  save_file_operands(paths[0], paths[1], NULL);
+
+  size_t tile = 3 * sizeof(double) + 3 * sizeof(double *);
+  ck_assert_int_eq(
+      s21_mult_matrix_file(paths[0], paths[1], paths[2], tile - 1),
+      CALC_ERROR);
+
+  for (int i = 0; i < 3; i++) remove(paths[i]);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_file_04) {
+  const char *paths[] = {"test_file_a.bin", "test_file_b.bin",
+                         "test_file_c.bin"};
+  save_file_operands(paths[0], paths[1], NULL);
+
+  ck_assert_int_eq(
+      s21_mult_matrix_file(paths[1], paths[1], paths[2], 1 << 20), CALC_ERROR);
+
+  for (int i = 0; i < 3; i++) remove(paths[i]);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_file_05) {
+  const char *paths[] = {"test_file_a.bin", "test_file_b.bin"};
+  save_file_operands(paths[0], paths[1], NULL);
+
+  ck_assert_int_eq(s21_mult_matrix_file(paths[0], paths[1], NULL, 1 << 20),
+                   INCORRECT_MATRIX);
+  ck_assert_int_eq(
+      s21_mult_matrix_file(NULL, paths[1], "test_file_c.bin", 1 << 20),
+      INCORRECT_MATRIX);
+
+  for (int i = 0; i < 2; i++) remove(paths[i]);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_file_06) {
+  const char *paths[] = {"test_io_a.bin", "test_io_b.bin"};
+  matrix_t a = {0}, loaded = {0};
+  s21_create_matrix(3, 3, &a);
+  s21_init_matrix(1.0, &a);
+  s21_save_matrix(&a, paths[0]);
+  s21_save_matrix(&a, paths[1]);
+
+  for (int i = 0; i < 2; i++) {
+    ck_assert_int_eq(
+        s21_mult_matrix_file(paths[0], paths[1], paths[i], 1 << 20),
+        INCORRECT_MATRIX);
+    ck_assert_int_eq(s21_load_matrix(paths[i], &loaded), OK);
+    ck_assert_int_eq(s21_eq_matrix(&a, &loaded), SUCCESS);
+    s21_remove_matrix(&loaded);
+  }
+  for (int i = 0; i < 2; i++) remove(paths[i]);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+/*
+ * Создаёт операнды float 40 x 300 и 300 x 35 и, если exact не NULL, их точное
+ * произведение в double. Значения генератора сдвигаются в [0, 1], чтобы
+ * суммы в произведении не сокращались и ошибка float сравнивалась с
+ * величиной результата.
+ */
+static void f32_operands(matrix_f32_t *fa, matrix_f32_t *fb, matrix_t *exact) {
+  matrix_t a = {0}, b = {0};
+  s21_random_matrix(40, 300, 20, &a);
+  s21_random_matrix(300, 35, 21, &b);
+  for (int i = 0; i < 40 * 300; i++) a.matrix[i / 300][i % 300] += 0.5;
+  for (int i = 0; i < 300 * 35; i++) b.matrix[i / 35][i % 35] += 0.5;
+  s21_matrix_to_f32(&a, fa);
+  s21_matrix_to_f32(&b, fb);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  if (exact != NULL) {
+    s21_matrix_from_f32(fa, &a);
+    s21_matrix_from_f32(fb, &b);
+    s21_mult_matrix(&a, &b, exact);
+    s21_remove_matrix(&a);
+    s21_remove_matrix(&b);
+  }
+}
+
+static double f32_error(matrix_f32_t *r, matrix_t *exact) {
+  double err = 0;
+  for (int i = 0; i < exact->rows; i++) {
+    for (int j = 0; j < exact->columns; j++) {
+      err = fmax(err, fabs(r->matrix[i][j] - exact->matrix[i][j]));
+    }
+  }
+  return err;
+}
+
+START_TEST(s21_matrix_to_f32_01) {
+  matrix_t a = {0}, back = {0};
+  matrix_f32_t fa = {0};
+  s21_create_matrix(3, 4, &a);
+  for (int i = 0; i < 12; i++) a.matrix[i / 4][i % 4] = i * 0.5 - 2;
+
+  ck_assert_int_eq(s21_matrix_to_f32(&a, &fa), OK);
+  ck_assert_int_eq(s21_matrix_from_f32(&fa, &back), OK);
+  ck_assert_int_eq(s21_eq_matrix(&a, &back), SUCCESS);
+
+  s21_remove_matrix_f32(&fa);
+  s21_remove_matrix(&back);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_matrix_to_f32_02) {
+  matrix_t a = {0};
+  matrix_f32_t fa = {0};
+  s21_create_matrix(2, 2, &a);
+  a.matrix[0][0] = 1e300;
+
+  ck_assert_int_eq(s21_matrix_to_f32(&a, &fa), CALC_ERROR);
+  ck_assert_ptr_null(fa.matrix);
+  ck_assert_int_eq(s21_matrix_to_f32(&a, NULL), INCORRECT_MATRIX);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_f32_01) {
+  matrix_t exact = {0};
+  matrix_f32_t fa = {0}, fb = {0}, fr = {0};
+  f32_operands(&fa, &fb, &exact);
+
+  ck_assert_int_eq(s21_mult_matrix_f32(&fa, &fb, &fr), OK);
+  ck_assert_double_le(f32_error(&fr, &exact), 1e-3);
+
+  s21_remove_matrix_f32(&fa);
+  s21_remove_matrix_f32(&fb);
+  s21_remove_matrix_f32(&fr);
+  s21_remove_matrix(&exact);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_f32_02) {
+  matrix_f32_t fa = {0}, fb = {0}, fr = {0};
+  f32_operands(&fa, &fb, NULL);
+
+  ck_assert_int_eq(s21_mult_matrix_f32(&fa, &fa, &fr), CALC_ERROR);
+  ck_assert_ptr_null(fr.matrix);
+
+  s21_remove_matrix_f32(&fa);
+  s21_remove_matrix_f32(&fb);
+}
+END_TEST
+
+START_TEST(s21_mult_matrix_f32_mixed_01) {
+  matrix_t exact = {0};
+  matrix_f32_t fa = {0}, fb = {0}, fr = {0}, fm = {0};
+  f32_operands(&fa, &fb, &exact);
+
+  ck_assert_int_eq(s21_mult_matrix_f32(&fa, &fb, &fr), OK);
+  ck_assert_int_eq(s21_mult_matrix_f32_mixed(&fa, &fb, &fm), OK);
+  double err_mixed = f32_error(&fm, &exact);
+  ck_assert_double_lt(err_mixed, f32_error(&fr, &exact));
+  ck_assert_double_le(err_mixed, 2e-5);
+  ck_assert_int_eq(s21_eq_matrix_f32(&fr, &fm), SUCCESS);
+
+  s21_remove_matrix_f32(&fa);
+  s21_remove_matrix_f32(&fb);
+  s21_remove_matrix_f32(&fr);
+  s21_remove_matrix_f32(&fm);
+  s21_remove_matrix(&exact);
+}
+END_TEST
+
+START_TEST(s21_transpose_f32_01) {
+  matrix_f32_t fa = {0}, fb = {0}, ft = {0}, fr = {0};
+  f32_operands(&fa, &fb, NULL);
+
+  ck_assert_int_eq(s21_transpose_f32(&fa, &ft), OK);
+  ck_assert_int_eq(ft.rows, 300);
+  ck_assert_double_eq(ft.matrix[299][39], fa.matrix[39][299]);
+  ck_assert_int_eq(s21_transpose_f32(&ft, &fr), OK);
+  ck_assert_int_eq(s21_eq_matrix_f32(&fa, &fr), SUCCESS);
+
+  s21_remove_matrix_f32(&fa);
+  s21_remove_matrix_f32(&fb);
+  s21_remove_matrix_f32(&ft);
+  s21_remove_matrix_f32(&fr);
+}
+END_TEST
+
+START_TEST(s21_sum_matrix_f32_01) {
+  matrix_f32_t fa = {0}, fb = {0}, fr = {0}, fm = {0};
+  f32_operands(&fa, &fb, NULL);
+
+  ck_assert_int_eq(s21_sum_matrix_f32(&fa, &fa, &fr), OK);
+  ck_assert_int_eq(s21_mult_number_f32(&fa, 2, &fm), OK);
+  ck_assert_int_eq(s21_eq_matrix_f32(&fr, &fm), SUCCESS);
+
+  s21_remove_matrix_f32(&fa);
+  s21_remove_matrix_f32(&fb);
+  s21_remove_matrix_f32(&fr);
+  s21_remove_matrix_f32(&fm);
+}
+END_TEST
+
+START_TEST(s21_sum_matrix_f32_02) {
+  matrix_f32_t fa = {0}, fb = {0}, fr = {0};
+  f32_operands(&fa, &fb, NULL);
+
+  ck_assert_int_eq(s21_sum_matrix_f32(&fa, &fb, &fr), CALC_ERROR);
+  ck_assert_ptr_null(fr.matrix);
+
+  s21_remove_matrix_f32(&fa);
+  s21_remove_matrix_f32(&fb);
+}
+END_TEST
+
+START_TEST(s21_sub_matrix_f32_01) {
+  matrix_f32_t fa = {0}, fb = {0}, fr = {0}, fm = {0};
+  f32_operands(&fa, &fb, NULL);
+
+  s21_mult_number_f32(&fa, 2, &fr);
+  ck_assert_int_eq(s21_sub_matrix_f32(&fr, &fa, &fm), OK);
+  ck_assert_int_eq(s21_eq_matrix_f32(&fm, &fa), SUCCESS);
+
+  s21_remove_matrix_f32(&fa);
+  s21_remove_matrix_f32(&fb);
+  s21_remove_matrix_f32(&fr);
+  s21_remove_matrix_f32(&fm);
+}
+END_TEST
+
+START_TEST(s21_mult_number_f32_01) {
+  matrix_f32_t fa = {0}, fb = {0}, fr = {0};
+  f32_operands(&fa, &fb, NULL);
+
+  ck_assert_int_eq(s21_mult_number_f32(&fa, NAN, &fr), CALC_ERROR);
+
+  s21_remove_matrix_f32(&fr);
+  s21_remove_matrix_f32(&fa);
+  s21_remove_matrix_f32(&fb);
+}
+END_TEST
+
+static void f32_square(matrix_t *m, matrix_f32_t *fm) {
+  double values[] = {2, 5, 7, 6, 3, 4, 5, -2, -3};
+  s21_create_matrix(3, 3, m);
+  for (int i = 0; i < 9; i++) m->matrix[i / 3][i % 3] = values[i];
+  s21_matrix_to_f32(m, fm);
+}
+
+START_TEST(s21_determinant_f32_01) {
+  matrix_t m = {0};
+  matrix_f32_t fsq = {0};
+  double det = 0;
+  f32_square(&m, &fsq);
+
+  ck_assert_int_eq(s21_determinant_f32(&fsq, &det), OK);
+  ck_assert_double_eq_tol(det, -1, 1e-12);
+
+  s21_remove_matrix_f32(&fsq);
+  s21_remove_matrix(&m);
+}
+END_TEST
+
+START_TEST(s21_inverse_matrix_f32_01) {
+  matrix_t m = {0}, inverse = {0}, back = {0};
+  matrix_f32_t fsq = {0}, fr = {0};
+  f32_square(&m, &fsq);
+
+  ck_assert_int_eq(s21_inverse_matrix_f32(&fsq, &fr), OK);
+  s21_inverse_matrix(&m, &inverse);
+  s21_matrix_from_f32(&fr, &back);
+  ck_assert_int_eq(s21_eq_matrix(&back, &inverse), SUCCESS);
+
+  s21_remove_matrix_f32(&fsq);
+  s21_remove_matrix_f32(&fr);
+  s21_remove_matrix(&m);
+  s21_remove_matrix(&inverse);
+  s21_remove_matrix(&back);
+}
+END_TEST
+
+START_TEST(s21_calc_complements_f32_01) {
+  matrix_t m = {0};
+  matrix_f32_t fsq = {0}, fr = {0};
+  f32_square(&m, &fsq);
+
+  ck_assert_int_eq(s21_calc_complements_f32(&fsq, &fr), OK);
+  ck_assert_double_eq_tol(fr.matrix[0][0], -1, 1e-6);
+  ck_assert_double_eq_tol(fr.matrix[2][2], -24, 1e-6);
+
+  s21_remove_matrix_f32(&fsq);
+  s21_remove_matrix_f32(&fr);
+  s21_remove_matrix(&m);
+}
+END_TEST
+
+static void mixed_system(int n, matrix_t *a, matrix_t *b) {
+  s21_create_matrix(n, n, a);
+  s21_create_matrix(n, 3, b);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a->matrix[i][j] = ((i * 31 + j * 17) % 23) / 7.0;
+    }
+    a->matrix[i][i] += n;
+    for (int j = 0; j < 3; j++) b->matrix[i][j] = (i + j) % 5 - 2.0 / 3;
+  }
+}
+
+static void hilbert_system(matrix_t *h, matrix_t *e) {
+  s21_create_matrix(9, 9, h);
+  s21_create_matrix(9, 1, e);
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 9; j++) h->matrix[i][j] = 1.0 / (i + j + 1);
+    e->matrix[i][0] = 1;
+  }
+}
+
+START_TEST(s21_solve_mixed_01) {
+  matrix_t a = {0}, b = {0}, x = {0}, expected = {0};
+  mixed_system(150, &a, &b);
+
+  ck_assert_int_eq(s21_solve(&a, &b, &expected), OK);
+  ck_assert_int_eq(s21_solve_mixed(&a, &b, &x), OK);
+  for (int i = 0; i < 150; i++) {
+    for (int j = 0; j < 3; j++) {
+      ck_assert_double_eq_tol(x.matrix[i][j], expected.matrix[i][j], 1e-14);
+    }
+  }
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&x);
+  s21_remove_matrix(&expected);
+}
+END_TEST
+
+START_TEST(s21_solve_mixed_02) {
+  matrix_t h = {0}, e = {0}, x = {0}, expected = {0};
+  hilbert_system(&h, &e);
+
+  ck_assert_int_eq(s21_solve(&h, &e, &expected), OK);
+  ck_assert_int_eq(s21_solve_mixed(&h, &e, &x), OK);
+  ck_assert_int_eq(s21_eq_matrix(&x, &expected), SUCCESS);
+
+  s21_remove_matrix(&h);
+  s21_remove_matrix(&e);
+  s21_remove_matrix(&x);
+  s21_remove_matrix(&expected);
+}
+END_TEST
+
+START_TEST(s21_solve_mixed_03) {
+  matrix_t h = {0}, e = {0}, x = {0};
+  hilbert_system(&h, &e);
+  for (int j = 0; j < 9; j++) h.matrix[8][j] = h.matrix[7][j];
+
+  ck_assert_int_eq(s21_solve_mixed(&h, &e, &x), CALC_ERROR);
+  ck_assert_ptr_null(x.matrix);
+
+  s21_remove_matrix(&h);
+  s21_remove_matrix(&e);
+}
+END_TEST
+
+START_TEST(s21_solve_mixed_04) {
+  matrix_t a = {0}, b = {0}, h = {0}, e = {0}, x = {0};
+  mixed_system(150, &a, &b);
+  hilbert_system(&h, &e);
+
+  ck_assert_int_eq(s21_solve_mixed(&a, &e, &x), CALC_ERROR);
+  ck_assert_int_eq(s21_solve_mixed(&a, &b, NULL), INCORRECT_MATRIX);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&h);
+  s21_remove_matrix(&e);
+}
+END_TEST
+
+static void count_events(s21_probe probe, s21_trace_event event, void *user) {
+  if (probe == PROBE_MULT_MATRIX) ((int *)user)[event]++;
+}
+
+static void multiply_once(void) {
+  matrix_t a = {0}, b = {0}, c = {0};
+  s21_create_matrix(3, 4, &a);
+  s21_create_matrix(4, 5, &b);
+  s21_mult_matrix(&a, &b, &c);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&c);
+}
+
+START_TEST(s21_stats_snapshot_01) {
+  s21_stats_reset();
+  multiply_once();
+
+  s21_stats_t stats[PROBE_COUNT];
+  ck_assert_int_eq(s21_stats_snapshot(stats), OK);
+#ifdef S21_INSTRUMENT
+  unsigned long long total = 0;
+  for (int i = 0; i < STATS_BUCKETS; i++) {
+    total += stats[PROBE_MULT_MATRIX].histogram[i];
+  }
+  ck_assert_uint_eq(total, 1);
+  ck_assert_uint_eq(stats[PROBE_MULT_MATRIX].calls, 1);
+  ck_assert_uint_eq(stats[PROBE_MULT_MATRIX].flops, 120);
+  ck_assert_uint_eq(stats[PROBE_CREATE_MATRIX].calls, 3);
+  ck_assert_int_ge(stats[PROBE_CREATE_MATRIX].bytes, (12 + 20 + 15) * 8);
+#else
+  ck_assert_uint_eq(stats[PROBE_MULT_MATRIX].calls, 0);
+#endif
+}
+END_TEST
+
+START_TEST(s21_stats_snapshot_02) {
+  ck_assert_int_eq(s21_stats_snapshot(NULL), INCORRECT_MATRIX);
+}
+END_TEST
+
+START_TEST(s21_stats_snapshot_03) {
+  matrix_t a = {0};
+  s21_stats_reset();
+  ck_assert_int_eq(s21_create_matrix(INT32_MAX, INT32_MAX, &a), CALC_ERROR);
+
+  s21_stats_t stats[PROBE_COUNT];
+  s21_stats_snapshot(stats);
+#ifdef S21_INSTRUMENT
+  ck_assert_uint_eq(stats[PROBE_CREATE_MATRIX].calls, 1);
+#endif
+  ck_assert_uint_eq(stats[PROBE_CREATE_MATRIX].bytes, 0);
+}
+END_TEST
+
+START_TEST(s21_stats_reset_01) {
+  multiply_once();
+  s21_stats_reset();
+
+  s21_stats_t stats[PROBE_COUNT];
+  s21_stats_snapshot(stats);
+  ck_assert_uint_eq(stats[PROBE_MULT_MATRIX].calls, 0);
+  ck_assert_uint_eq(stats[PROBE_CREATE_MATRIX].bytes, 0);
+}
+END_TEST
+
+START_TEST(s21_stats_json_01) {
+  s21_stats_reset();
+  multiply_once();
+
+  size_t length = s21_stats_json(NULL, 0);
+  char *json = malloc(length + 1);
+  ck_assert_uint_eq(s21_stats_json(json, length + 1), length);
+  ck_assert_uint_eq(strlen(json), length);
+  ck_assert_ptr_nonnull(strstr(json, "\"s21_mult_matrix\": {\"calls\": "));
+#ifdef S21_INSTRUMENT
+  ck_assert_ptr_nonnull(strstr(json, "\"enabled\": true"));
+#else
+  ck_assert_ptr_nonnull(strstr(json, "\"enabled\": false"));
+#endif
+  free(json);
+}
+END_TEST
+
+START_TEST(s21_probe_name_01) {
+  ck_assert_str_eq(s21_probe_name(PROBE_SOLVE), "s21_solve");
+  ck_assert_str_eq(s21_probe_name(PROBE_MULT_MATRIX), "s21_mult_matrix");
+}
+END_TEST
+
+START_TEST(s21_set_trace_hook_01) {
+  int events[2] = {0, 0};
+  s21_set_trace_hook(count_events, events);
+  multiply_once();
+  s21_set_trace_hook(NULL, NULL);
+  multiply_once();
+
+#ifdef S21_INSTRUMENT
+  ck_assert_int_eq(events[TRACE_BEGIN], 1);
+  ck_assert_int_eq(events[TRACE_END], 1);
+#else
+  ck_assert_int_eq(events[TRACE_BEGIN], 0);
+  ck_assert_int_eq(events[TRACE_END], 0);
+#endif
+}
+END_TEST
+
+static double *view_at(const s21_view_t *V, int i, int j) {
+  return V->base + V->offset + i * V->row_stride + j * V->column_stride;
+}
+
+static void view_source(matrix_t *a, s21_view_t *whole) {
+  s21_random_matrix(6, 7, 22, a);
+  s21_view_matrix(a, whole);
+}
+
+START_TEST(s21_view_matrix_01) {
+  matrix_t a = {0};
+  s21_view_t whole;
+  view_source(&a, &whole);
+
+  ck_assert_ptr_eq(view_at(&whole, 4, 5), &a.matrix[4][5]);
+  double *row = a.matrix[0];
+  a.matrix[0] = a.matrix[2];
+  a.matrix[2] = row;
+  ck_assert_int_eq(s21_view_matrix(&a, &whole), CALC_ERROR);
+  ck_assert_int_eq(s21_view_matrix(&a, NULL), INCORRECT_MATRIX);
+
+  a.matrix[2] = a.matrix[0];
+  a.matrix[0] = row;
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_block_01) {
+  matrix_t a = {0};
+  s21_view_t whole, block;
+  view_source(&a, &whole);
+
+  ck_assert_int_eq(s21_view_block(&whole, 1, 2, 4, 4, &block), OK);
+  ck_assert_int_eq(block.rows, 4);
+  ck_assert_ptr_eq(view_at(&block, 3, 3), &a.matrix[4][5]);
+  ck_assert_int_eq(s21_view_block(&whole, 3, 4, 4, 4, &block), CALC_ERROR);
+  ck_assert_int_eq(s21_view_block(NULL, 0, 0, 1, 1, &block),
+                   INCORRECT_MATRIX);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_row_01) {
+  matrix_t a = {0};
+  s21_view_t whole, block, row;
+  view_source(&a, &whole);
+  s21_view_block(&whole, 1, 2, 4, 4, &block);
+
+  ck_assert_int_eq(s21_view_row(&block, 3, &row), OK);
+  ck_assert_double_eq(row.base[row.offset + 3], a.matrix[4][5]);
+  ck_assert_int_eq(s21_view_row(&block, 4, &row), CALC_ERROR);
+  ck_assert_int_eq(s21_view_row(NULL, 0, &row), INCORRECT_MATRIX);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_column_01) {
+  matrix_t a = {0};
+  s21_view_t whole, column;
+  view_source(&a, &whole);
+
+  ck_assert_int_eq(s21_view_column(&whole, 6, &column), OK);
+  ck_assert_int_eq(column.rows, 6);
+  ck_assert_double_eq(column.base[column.offset + 5 * column.row_stride],
+                      a.matrix[5][6]);
+  ck_assert_int_eq(s21_view_column(&whole, 7, &column), CALC_ERROR);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_transpose_01) {
+  matrix_t a = {0};
+  s21_view_t whole, transposed;
+  view_source(&a, &whole);
+
+  ck_assert_int_eq(s21_view_transpose(&whole, &transposed), OK);
+  ck_assert_int_eq(transposed.rows, 7);
+  ck_assert_int_eq(transposed.columns, 6);
+  ck_assert_ptr_eq(view_at(&transposed, 5, 4), &a.matrix[4][5]);
+  ck_assert_int_eq(s21_view_transpose(&whole, NULL), INCORRECT_MATRIX);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_as_matrix_01) {
+  matrix_t a = {0}, window = {0};
+  s21_view_t whole, block;
+  view_source(&a, &whole);
+  s21_view_block(&whole, 1, 2, 4, 4, &block);
+  double corner = a.matrix[1][2], outside = a.matrix[1][1];
+  arena_t arena;
+  s21_arena_create(0, &arena);
+
+  ck_assert_int_eq(s21_view_as_matrix(&block, &arena, &window), OK);
+  ck_assert_ptr_eq(window.matrix[0], &a.matrix[1][2]);
+  ck_assert_int_eq(window.rows, 4);
+  ck_assert_int_eq(s21_sum_matrix_inplace(&window, &window), OK);
+  ck_assert_double_eq(a.matrix[1][2], 2 * corner);
+  ck_assert_double_eq(a.matrix[1][1], outside);
+
+  s21_arena_destroy(&arena);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_as_matrix_02) {
+  matrix_t a = {0}, t = {0};
+  s21_view_t whole, transposed;
+  view_source(&a, &whole);
+  s21_view_transpose(&whole, &transposed);
+  arena_t arena;
+  s21_arena_create(0, &arena);
+
+  ck_assert_int_eq(s21_view_as_matrix(&transposed, &arena, &t), CALC_ERROR);
+  ck_assert_int_eq(s21_view_as_matrix(&whole, NULL, &t), INCORRECT_MATRIX);
+
+  s21_arena_destroy(&arena);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_as_matrix_03) {
+  matrix_t a = {0}, left = {0}, right = {0}, shifted = {0}, check = {0};
+  s21_random_matrix(6, 6, 23, &a);
+  s21_view_t whole, view;
+  s21_view_matrix(&a, &whole);
+  arena_t arena;
+  s21_arena_create(0, &arena);
+  s21_view_block(&whole, 0, 0, 3, 3, &view);
+  s21_view_as_matrix(&view, &arena, &left);
+  s21_view_block(&whole, 0, 3, 3, 3, &view);
+  s21_view_as_matrix(&view, &arena, &right);
+  s21_view_block(&whole, 1, 1, 3, 3, &view);
+  s21_view_as_matrix(&view, &arena, &shifted);
+
+  ck_assert_int_eq(s21_mult_matrix_into(&left, &left, &shifted), CALC_ERROR);
+  ck_assert_int_eq(s21_mult_matrix_into(&right, &shifted, &left),
+                   CALC_ERROR);
+  ck_assert_int_eq(s21_transpose_into(&left, &shifted), CALC_ERROR);
+  ck_assert_int_eq(s21_transpose_into(&shifted, &right), CALC_ERROR);
+
+  ck_assert_int_eq(s21_transpose_into(&left, &right), OK);
+  s21_transpose(&right, &check);
+  ck_assert_int_eq(s21_eq_matrix(&left, &check), SUCCESS);
+  s21_remove_matrix(&check);
+  s21_mult_matrix(&left, &left, &check);
+  ck_assert_int_eq(s21_mult_matrix_into(&left, &left, &right), OK);
+  ck_assert_int_eq(s21_eq_matrix(&right, &check), SUCCESS);
+
+  s21_remove_matrix(&check);
+  s21_arena_destroy(&arena);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_copy_01) {
+  matrix_t a = {0}, t = {0}, expected = {0};
+  s21_view_t whole, transposed, result;
+  view_source(&a, &whole);
+  s21_view_transpose(&whole, &transposed);
+  s21_create_matrix(7, 6, &t);
+  s21_view_matrix(&t, &result);
+
+  ck_assert_int_eq(s21_view_copy(&transposed, &result), OK);
+  s21_transpose(&a, &expected);
+  ck_assert_int_eq(s21_eq_matrix(&t, &expected), SUCCESS);
+  ck_assert_int_eq(s21_view_copy(&whole, &result), CALC_ERROR);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&t);
+  s21_remove_matrix(&expected);
+}
+END_TEST
+
+START_TEST(s21_view_sum_01) {
+  matrix_t a = {0}, expected = {0};
+  s21_view_t whole, top, bottom;
+  view_source(&a, &whole);
+  s21_create_matrix(2, 7, &expected);
+  for (int j = 0; j < 7; j++) {
+    expected.matrix[1][j] = a.matrix[1][j] + a.matrix[5][j];
+  }
+  s21_view_block(&whole, 0, 0, 2, 7, &top);
+  s21_view_block(&whole, 4, 0, 2, 7, &bottom);
+
+  ck_assert_int_eq(s21_view_sum(&top, &bottom, &top), OK);
+  for (int j = 0; j < 7; j++) {
+    ck_assert_double_eq(a.matrix[1][j], expected.matrix[1][j]);
+  }
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&expected);
+}
+END_TEST
+
+START_TEST(s21_view_sum_02) {
+  matrix_t a = {0};
+  s21_view_t whole, top, transposed;
+  view_source(&a, &whole);
+  s21_view_block(&whole, 0, 0, 2, 7, &top);
+  s21_view_transpose(&whole, &transposed);
+
+  ck_assert_int_eq(s21_view_sum(&top, &transposed, &top), CALC_ERROR);
+  ck_assert_int_eq(s21_view_sum(&top, NULL, &top), INCORRECT_MATRIX);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_sub_01) {
+  matrix_t a = {0}, expected = {0};
+  s21_view_t whole, top, bottom;
+  view_source(&a, &whole);
+  s21_create_matrix(2, 7, &expected);
+  for (int j = 0; j < 7; j++) {
+    expected.matrix[1][j] = a.matrix[5][j] - a.matrix[1][j];
+  }
+  s21_view_block(&whole, 0, 0, 2, 7, &top);
+  s21_view_block(&whole, 4, 0, 2, 7, &bottom);
+
+  ck_assert_int_eq(s21_view_sub(&bottom, &top, &bottom), OK);
+  for (int j = 0; j < 7; j++) {
+    ck_assert_double_eq(a.matrix[5][j], expected.matrix[1][j]);
+  }
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&expected);
+}
+END_TEST
+
+START_TEST(s21_view_scale_01) {
+  matrix_t a = {0};
+  s21_view_t whole, column;
+  view_source(&a, &whole);
+  s21_view_column(&whole, 6, &column);
+  double inside = a.matrix[2][6], outside = a.matrix[2][5];
+
+  ck_assert_int_eq(s21_view_scale(&column, 2, &column), OK);
+  ck_assert_double_eq(a.matrix[2][6], 2 * inside);
+  ck_assert_double_eq(a.matrix[2][5], outside);
+  ck_assert_int_eq(s21_view_scale(&column, NAN, &column), CALC_ERROR);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_mult_01) {
+  matrix_t a = {0}, t = {0}, block = {0}, block_t = {0}, expected = {0};
+  s21_view_t whole, view, transposed, result;
+  view_source(&a, &whole);
+  s21_view_block(&whole, 1, 2, 4, 4, &view);
+  s21_view_transpose(&view, &transposed);
+  s21_create_matrix(4, 4, &t);
+  s21_view_matrix(&t, &result);
+  s21_create_matrix(4, 4, &block);
+  for (int i = 0; i < 16; i++) {
+    block.matrix[i / 4][i % 4] = a.matrix[1 + i / 4][2 + i % 4];
+  }
+  s21_transpose(&block, &block_t);
+  s21_mult_matrix(&block_t, &block, &expected);
+
+  ck_assert_int_eq(s21_view_mult(&transposed, &view, &result), OK);
+  ck_assert_int_eq(s21_eq_matrix(&t, &expected), SUCCESS);
+
+  matrix_t *all[] = {&a, &t, &block, &block_t, &expected};
+  for (int i = 0; i < 5; i++) s21_remove_matrix(all[i]);
+}
+END_TEST
+
+START_TEST(s21_view_mult_02) {
+  matrix_t a = {0}, t = {0}, block = {0}, product = {0}, expected = {0};
+  s21_view_t whole, view, result, r_view;
+  view_source(&a, &whole);
+  s21_view_block(&whole, 1, 2, 4, 4, &view);
+  s21_create_matrix(4, 4, &t);
+  s21_view_matrix(&t, &result);
+  s21_view_transpose(&result, &r_view);
+  s21_create_matrix(4, 4, &block);
+  for (int i = 0; i < 16; i++) {
+    block.matrix[i / 4][i % 4] = a.matrix[1 + i / 4][2 + i % 4];
+  }
+  s21_mult_matrix(&block, &block, &product);
+  s21_transpose(&product, &expected);
+
+  ck_assert_int_eq(s21_view_mult(&view, &view, &r_view), OK);
+  ck_assert_int_eq(s21_eq_matrix(&t, &expected), SUCCESS);
+
+  matrix_t *all[] = {&a, &t, &block, &product, &expected};
+  for (int i = 0; i < 5; i++) s21_remove_matrix(all[i]);
+}
+END_TEST
+
+START_TEST(s21_view_mult_03) {
+  matrix_t a = {0};
+  s21_view_t whole, top, block;
+  view_source(&a, &whole);
+  s21_view_block(&whole, 0, 0, 2, 7, &top);
+  s21_view_block(&whole, 1, 2, 4, 4, &block);
+
+  ck_assert_int_eq(s21_view_mult(&top, &top, &block), CALC_ERROR);
+  ck_assert_int_eq(s21_view_mult(&top, NULL, &block), INCORRECT_MATRIX);
+  s21_remove_matrix(&a);
+}
+END_TEST
+
+START_TEST(s21_view_determinant_01) {
+  matrix_t a = {0}, block = {0};
+  s21_view_t whole, view, transposed;
+  view_source(&a, &whole);
+  s21_view_block(&whole, 1, 2, 4, 4, &view);
+  s21_view_transpose(&view, &transposed);
+  s21_create_matrix(4, 4, &block);
+  for (int i = 0; i < 16; i++) {
+    block.matrix[i / 4][i % 4] = a.matrix[1 + i / 4][2 + i % 4];
+  }
+  double det = 0, expected = 0;
+  s21_determinant(&block, &expected);
+
+  ck_assert_int_eq(s21_view_determinant(&view, &det), OK);
+  ck_assert_double_eq(det, expected);
+  ck_assert_int_eq(s21_view_determinant(&transposed, &det), OK);
+  ck_assert_double_eq_tol(det, expected, 1e-9);
+  ck_assert_int_eq(s21_view_determinant(&whole, &det), CALC_ERROR);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&block);
+}
+END_TEST
+
+static void strassen_operands(int n, matrix_t *a, matrix_t *b) {
+  s21_random_matrix(n, n, 23, a);
+  s21_random_matrix(n, n, 24, b);
+}
+
+START_TEST(s21_set_strassen_crossover_01) {
+  s21_set_strassen_crossover(5);
+  ck_assert_int_eq(s21_get_strassen_crossover(), 16);
+  s21_set_strassen_crossover(32);
+  ck_assert_int_eq(s21_get_strassen_crossover(), 32);
+  s21_set_strassen_crossover(-1);
+  ck_assert_int_eq(s21_get_strassen_crossover(), 0);
+  s21_set_strassen_crossover(STRASSEN_DEFAULT_CROSSOVER);
+  ck_assert_int_eq(s21_get_strassen_crossover(), STRASSEN_DEFAULT_CROSSOVER);
+}
+END_TEST
+
+START_TEST(s21_strassen_01) {
+  matrix_t a = {0}, b = {0}, fast = {0}, classic = {0};
+  strassen_operands(129, &a, &b);
+
+  s21_set_strassen_crossover(32);
+  ck_assert_int_eq(s21_mult_matrix(&a, &b, &fast), OK);
+  s21_set_strassen_crossover(0);
+  ck_assert_int_eq(s21_mult_matrix(&a, &b, &classic), OK);
+  ck_assert_int_eq(s21_eq_matrix(&fast, &classic), SUCCESS);
+
+  s21_set_strassen_crossover(STRASSEN_DEFAULT_CROSSOVER);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&fast);
+  s21_remove_matrix(&classic);
+}
+END_TEST
+
+START_TEST(s21_strassen_02) {
+  int n = 129;
+  matrix_t a = {0}, b = {0}, fast = {0}, classic = {0};
+  strassen_operands(n, &a, &b);
+  s21_create_matrix(n, n, &fast);
+  s21_create_matrix(n, n, &classic);
+
+  s21_set_strassen_crossover(0);
+  ck_assert_int_eq(s21_mult_matrix_into(&a, &b, &classic), OK);
+  s21_set_strassen_crossover(32);
+  ck_assert_int_eq(s21_mult_matrix_into(&a, &b, &fast), OK);
+  double error = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      error = fmax(error, fabs(fast.matrix[i][j] - classic.matrix[i][j]));
+    }
+  }
+  ck_assert_double_gt(error, 0);
+  ck_assert_double_le(error, 18.0 * 18 * 18 * n * DBL_EPSILON);
+
+  s21_set_strassen_crossover(STRASSEN_DEFAULT_CROSSOVER);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&fast);
+  s21_remove_matrix(&classic);
+}
+END_TEST
+
+START_TEST(s21_strassen_03) {
+  int n = 129;
+  matrix_t a = {0}, b = {0}, fast = {0};
+  strassen_operands(n, &a, &b);
+  s21_create_matrix(n, n, &fast);
+  a.matrix[n - 1][0] = INFINITY;
+
+  s21_set_strassen_crossover(32);
+  ck_assert_int_eq(s21_mult_matrix_into(&a, &b, &fast), CALC_ERROR);
+
+  s21_set_strassen_crossover(STRASSEN_DEFAULT_CROSSOVER);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&fast);
+}
+END_TEST
+
+static void vector_operands(matrix_t *a, matrix_t *column) {
+  s21_random_matrix(37, 45, 24, a);
+  s21_random_matrix(45, 1, 25, column);
+}
+
+START_TEST(s21_create_vector_01) {
+  vector_t x;
+  ck_assert_int_eq(s21_create_vector(5, &x), OK);
+  ck_assert_int_eq(x.size, 5);
+  ck_assert_int_eq((uintptr_t)x.data % MATRIX_ALIGN, 0);
+  for (int i = 0; i < 5; i++) ck_assert_double_eq(x.data[i], 0);
+  s21_remove_vector(&x);
+  ck_assert_ptr_null(x.data);
+  ck_assert_int_eq(s21_create_vector(0, &x), INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_create_vector(5, NULL), INCORRECT_MATRIX);
+}
+END_TEST
+
+START_TEST(s21_matrix_as_vector_01) {
+  matrix_t a = {0}, column = {0};
+  vector_operands(&a, &column);
+  vector_t x;
+
+  ck_assert_int_eq(s21_matrix_as_vector(&column, &x), OK);
+  ck_assert_int_eq(x.size, 45);
+  ck_assert_ptr_eq(x.data, column.matrix[0]);
+  ck_assert_int_eq(s21_matrix_as_vector(&a, &x), CALC_ERROR);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&column);
+}
+END_TEST
+
+START_TEST(s21_gemv_01) {
+  matrix_t a = {0}, column = {0}, product = {0};
+  vector_operands(&a, &column);
+  vector_t x, y;
+  s21_matrix_as_vector(&column, &x);
+  s21_create_vector(37, &y);
+
+  ck_assert_int_eq(s21_gemv(&a, &x, &y), OK);
+  s21_mult_matrix(&a, &column, &product);
+  for (int i = 0; i < 37; i++) {
+    ck_assert_double_eq_tol(y.data[i], product.matrix[i][0], 1e-12);
+  }
+
+  s21_remove_vector(&y);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&column);
+  s21_remove_matrix(&product);
+}
+END_TEST
+
+START_TEST(s21_gemv_02) {
+  matrix_t a = {0}, column = {0};
+  vector_operands(&a, &column);
+  vector_t x, y, z;
+  s21_matrix_as_vector(&column, &x);
+  s21_create_vector(37, &y);
+  s21_create_vector(45, &z);
+
+  ck_assert_int_eq(s21_gemv(&a, &y, &z), CALC_ERROR);
+  ck_assert_int_eq(s21_gemv(&a, &x, NULL), INCORRECT_MATRIX);
+
+  s21_remove_vector(&y);
+  s21_remove_vector(&z);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&column);
+}
+END_TEST
+
+START_TEST(s21_gemv_t_01) {
+  matrix_t a = {0}, column = {0}, product = {0};
+  vector_operands(&a, &column);
+  vector_t y, z;
+  s21_create_vector(37, &y);
+  s21_create_vector(45, &z);
+  for (int i = 0; i < 37; i++) y.data[i] = i % 5 - 2.5;
+
+  matrix_t row = {.matrix = &y.data, .rows = 1, .columns = 37};
+  ck_assert_int_eq(s21_gemv_t(&a, &y, &z), OK);
+  s21_mult_matrix(&row, &a, &product);
+  for (int j = 0; j < 45; j++) {
+    ck_assert_double_eq_tol(z.data[j], product.matrix[0][j], 1e-12);
+  }
+
+  s21_remove_vector(&y);
+  s21_remove_vector(&z);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&column);
+  s21_remove_matrix(&product);
+}
+END_TEST
+
+START_TEST(s21_gemv_t_02) {
+  matrix_t a = {0}, column = {0};
+  vector_operands(&a, &column);
+  vector_t y;
+  s21_create_vector(37, &y);
+
+  ck_assert_int_eq(s21_gemv_t(&a, &y, &y), CALC_ERROR);
+
+  s21_remove_vector(&y);
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&column);
+}
+END_TEST
+
+START_TEST(s21_dot_01) {
+  matrix_t a = {0}, column = {0};
+  vector_operands(&a, &column);
+  vector_t x;
+  s21_matrix_as_vector(&column, &x);
+  double dot = 0, expected = 0;
+  for (int i = 0; i < 45; i++) expected += x.data[i] * x.data[i];
+
+  ck_assert_int_eq(s21_dot(&x, &x, &dot), OK);
+  ck_assert_double_eq_tol(dot, expected, 1e-12);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&column);
+}
+END_TEST
+
+START_TEST(s21_dot_02) {
+  vector_t x, y;
+  s21_create_vector(45, &x);
+  s21_create_vector(37, &y);
+  double dot = 0;
+
+  ck_assert_int_eq(s21_dot(&x, &y, &dot), CALC_ERROR);
+  ck_assert_int_eq(s21_dot(&x, &x, NULL), INCORRECT_MATRIX);
+
+  s21_remove_vector(&x);
+  s21_remove_vector(&y);
+}
+END_TEST
+
+START_TEST(s21_axpy_01) {
+  vector_t x, y;
+  s21_create_vector(40, &x);
+  s21_create_vector(40, &y);
+  for (int i = 0; i < 40; i++) {
+    x.data[i] = i;
+    y.data[i] = 1;
+  }
+
+  ck_assert_int_eq(s21_axpy(2, &x, &y), OK);
+  for (int i = 0; i < 40; i++) ck_assert_double_eq(y.data[i], 2 * i + 1);
+
+  s21_remove_vector(&x);
+  s21_remove_vector(&y);
+}
+END_TEST
+
+START_TEST(s21_axpy_02) {
+  vector_t x, y;
+  s21_create_vector(40, &x);
+  s21_create_vector(41, &y);
+
+  ck_assert_int_eq(s21_axpy(2, &x, &x), CALC_ERROR);
+  ck_assert_int_eq(s21_axpy(2, &x, &y), CALC_ERROR);
+  x.data[0] = 1e308;
+  y.size = 40;
+  ck_assert_int_eq(s21_axpy(2, &x, &y), CALC_ERROR);
+  y.size = 41;
+
+  s21_remove_vector(&x);
+  s21_remove_vector(&y);
+}
+END_TEST
+
+START_TEST(s21_norm1_01) {
+  matrix_t a = {0}, column = {0};
+  vector_operands(&a, &column);
+  vector_t x;
+  s21_matrix_as_vector(&column, &x);
+  double norm = 0, expected = 0;
+  for (int i = 0; i < 45; i++) expected += fabs(x.data[i]);
+
+  ck_assert_int_eq(s21_norm1(&x, &norm), OK);
+  ck_assert_double_eq_tol(norm, expected, 1e-12);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&column);
+}
+END_TEST
+
+START_TEST(s21_norm2_01) {
+  matrix_t a = {0}, column = {0};
+  vector_operands(&a, &column);
+  vector_t x;
+  s21_matrix_as_vector(&column, &x);
+  double norm = 0, dot = 0;
+
+  ck_assert_int_eq(s21_norm2(&x, &norm), OK);
+  s21_dot(&x, &x, &dot);
+  ck_assert_double_eq_tol(norm * norm, dot, 1e-9);
+  ck_assert_int_eq(s21_norm2(NULL, &norm), INCORRECT_MATRIX);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&column);
+}
+END_TEST
+
+START_TEST(s21_norm2_02) {
+  vector_t y;
+  s21_create_vector(50000, &y);
+  for (int i = 0; i < 50000; i++) y.data[i] = 1e200 / (i % 97 + 1);
+  double norm = 0;
+
+  ck_assert_int_eq(s21_norm2(&y, &norm), OK);
+  ck_assert_double_eq_tol(norm / 1e200, sqrt(50000 / 97.0 * 1.6331), 2);
+
+  s21_remove_vector(&y);
+}
+END_TEST
+
+START_TEST(s21_norm_inf_01) {
+  matrix_t a = {0}, column = {0};
+  vector_operands(&a, &column);
+  vector_t x;
+  s21_matrix_as_vector(&column, &x);
+  double norm = 0, expected = 0;
+  for (int i = 0; i < 45; i++) expected = fmax(expected, fabs(x.data[i]));
+
+  ck_assert_int_eq(s21_norm_inf(&x, &norm), OK);
+  ck_assert_double_eq(norm, expected);
+
+  s21_remove_matrix(&a);
+  s21_remove_matrix(&column);
+}
+END_TEST
+
+START_TEST(s21_norm_inf_02) {
+  vector_t y;
+  s21_create_vector(50000, &y);
+  y.data[49999] = NAN;
+  double norm = 0;
+
+  ck_assert_int_eq(s21_norm_inf(&y, &norm), CALC_ERROR);
+  ck_assert(isnan(norm));
+
+  s21_remove_vector(&y);
+}
+END_TEST
+
+START_TEST(s21_vector_01) {
+  int big = 50000;
+  double single[3], pooled[3];
+  vector_t y, z;
+  s21_create_vector(big, &y);
+  s21_create_vector(big, &z);
+  for (int i = 0; i < big; i++) y.data[i] = 1e200 / (i % 97 + 1);
+
+  for (int threads = 1; threads <= 4; threads += 3) {
+    double *out = threads == 1 ? single : pooled;
+    for (int i = 0; i < big; i++) z.data[i] = (i % 13) / 7.0;
+    s21_set_num_threads(threads);
+    s21_set_parallel_threshold(0);
+    ck_assert_int_eq(s21_norm2(&y, &out[0]), OK);
+    ck_assert_int_eq(s21_dot(&z, &z, &out[1]), OK);
+    ck_assert_int_eq(s21_axpy(1e-200, &y, &z), OK);
+    ck_assert_int_eq(s21_norm1(&z, &out[2]), OK);
+  }
+  s21_set_num_threads(1);
+  s21_set_parallel_threshold(POOL_DEFAULT_THRESHOLD);
+  for (int i = 0; i < 3; i++) ck_assert_double_eq(single[i], pooled[i]);
+
+  s21_remove_vector(&y);
+  s21_remove_vector(&z);
+}
+END_TEST
+
+/*
+ * Случаи для тестов структурированных матриц: 0 — симметричная положительно
+ * определённая, 1 — симметричная неопределённая, 2 и 3 — нижняя и верхняя
+ * треугольные, 4 — ленточная (2, 1) с нулём на диагонали, 5 —
+ * трёхдиагональная с преобладанием диагонали, 6 — трёхдиагональная, на
+ * которой прогонка встречает нулевой знаменатель. Значения берутся из общего
+ * генератора (симметрично отражённые относительно диагонали), к диагонали
+ * добавляется n для преобладания; структура задаётся только маской ленты и
+ * правкой первых элементов.
+ */
+static void structured_case(int c, matrix_t *dense, s21_structured_t *S) {
+  const int n = 9;
+  structure_kind kinds[7] = {STRUCTURE_SYMMETRIC, STRUCTURE_SYMMETRIC,
+                             STRUCTURE_LOWER,     STRUCTURE_UPPER,
+                             STRUCTURE_BANDED,    STRUCTURE_BANDED,
+                             STRUCTURE_BANDED};
+  int lower[7] = {0, 0, 0, 0, 2, 1, 1}, upper[7] = {0, 0, 0, 0, 1, 1, 1};
+  matrix_t values = {0};
+  s21_random_matrix(n, n, 25, &values);
+  s21_create_matrix(n, n, dense);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      int inside = kinds[c] == STRUCTURE_SYMMETRIC ||
+                   (j >= i - lower[c] && j <= i + upper[c]);
+      if (kinds[c] == STRUCTURE_LOWER) inside = j <= i;
+      if (kinds[c] == STRUCTURE_UPPER) inside = j >= i;
+      double value = values.matrix[i < j ? i : j][i < j ? j : i];
+      dense->matrix[i][j] = inside ? value + (i == j) * n : 0;
+    }
+  }
+  s21_remove_matrix(&values);
+  if (c == 1 || c == 4 || c == 6) dense->matrix[0][0] = c == 1 ? -1 : 0;
+  if (c == 6) dense->matrix[1][0] = 1;
+  s21_structured_from_dense(dense, kinds[c], lower[c], upper[c], S);
+}
+
+static void structured_rhs(matrix_t *b) { s21_random_matrix(9, 2, 26, b); }
+
+static void check_structured_solve(int c) {
+  matrix_t dense = {0}, b = {0}, expected = {0}, actual = {0};
+  s21_structured_t S;
+  structured_case(c, &dense, &S);
+  structured_rhs(&b);
+
+  ck_assert_int_eq(s21_structured_solve(&S, &b, &actual), OK);
+  ck_assert_int_eq(s21_solve(&dense, &b, &expected), OK);
+  ck_assert_int_eq(s21_eq_matrix(&actual, &expected), SUCCESS);
+
+  s21_remove_structured(&S);
+  s21_remove_matrix(&dense);
+  s21_remove_matrix(&b);
+  s21_remove_matrix(&expected);
+  s21_remove_matrix(&actual);
+}
+
+START_TEST(s21_create_structured_01) {
+  s21_structured_t S;
+  ck_assert_int_eq(s21_create_structured(9, STRUCTURE_UPPER, 0, 0, &S), OK);
+  ck_assert_int_eq(S.upper, 8);
+  ck_assert_int_eq(S.lower, 0);
+  s21_remove_structured(&S);
+  ck_assert_ptr_null(S.data);
+
+  ck_assert_int_eq(s21_create_structured(9, STRUCTURE_BANDED, -1, 0, &S),
+                   INCORRECT_MATRIX);
+  ck_assert_int_eq(s21_create_structured(0, STRUCTURE_LOWER, 0, 0, &S),
+                   INCORRECT_MATRIX);
+}
+END_TEST
+
+START_TEST(s21_structured_from_dense_01) {
+  for (int c = 0; c < 7; c++) {
+    matrix_t dense = {0}, actual = {0};
+    s21_structured_t S;
+    structured_case(c, &dense, &S);
+
+    ck_assert_int_eq(s21_structured_to_dense(&S, &actual), OK);
+    ck_assert_int_eq(s21_eq_matrix(&actual, &dense), SUCCESS);
+
+    s21_remove_structured(&S);
+    s21_remove_matrix(&dense);
+    s21_remove_matrix(&actual);
+  }
+}
+END_TEST
+
+START_TEST(s21_structured_mult_dense_01) {
+  matrix_t b = {0};
+  structured_rhs(&b);
+  for (int c = 0; c < 7; c++) {
+    matrix_t dense = {0}, expected = {0}, actual = {0};
+    s21_structured_t S;
+    structured_case(c, &dense, &S);
+
+    ck_assert_int_eq(s21_structured_mult_dense(&S, &b, &actual), OK);
+    s21_mult_matrix(&dense, &b, &expected);
+    ck_assert_int_eq(s21_eq_matrix(&actual, &expected), SUCCESS);
+
+    s21_remove_structured(&S);
+    s21_remove_matrix(&dense);
+    s21_remove_matrix(&expected);
+    s21_remove_matrix(&actual);
+  }
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_structured_mult_vector_01) {
+  vector_t x, y;
+  s21_create_vector(9, &x);
+  s21_create_vector(9, &y);
+  for (int i = 0; i < 9; i++) x.data[i] = i - 4;
+  for (int c = 0; c < 7; c++) {
+    matrix_t dense = {0};
+    s21_structured_t S;
+    structured_case(c, &dense, &S);
+
+    ck_assert_int_eq(s21_structured_mult_vector(&S, &x, &y), OK);
+    for (int i = 0; i < 9; i++) {
+      double sum = 0;
+      for (int j = 0; j < 9; j++) sum += dense.matrix[i][j] * x.data[j];
+      ck_assert_double_eq_tol(y.data[i], sum, 1e-12);
+    }
+
+    s21_remove_structured(&S);
+    s21_remove_matrix(&dense);
+  }
+  s21_remove_vector(&x);
+  s21_remove_vector(&y);
+}
+END_TEST
+
+START_TEST(s21_structured_mult_vector_02) {
+  vector_t x, y;
+  s21_create_vector(9, &x);
+  s21_create_vector(8, &y);
+  s21_structured_t S;
+  s21_create_structured(9, STRUCTURE_UPPER, 0, 0, &S);
+
+  ck_assert_int_eq(s21_structured_mult_vector(&S, &x, &x), CALC_ERROR);
+  ck_assert_int_eq(s21_structured_mult_vector(&S, &x, &y), CALC_ERROR);
+
+  s21_remove_structured(&S);
+  s21_remove_vector(&x);
+  s21_remove_vector(&y);
+}
+END_TEST
+
+START_TEST(s21_structured_solve_01) { check_structured_solve(0); }
+END_TEST
+
+START_TEST(s21_structured_solve_02) { check_structured_solve(1); }
+END_TEST
+
+START_TEST(s21_structured_solve_03) {
+  check_structured_solve(2);
+  check_structured_solve(3);
+}
+END_TEST
+
+START_TEST(s21_structured_solve_04) { check_structured_solve(4); }
+END_TEST
+
+START_TEST(s21_structured_solve_05) { check_structured_solve(5); }
+END_TEST
+
+START_TEST(s21_structured_solve_06) { check_structured_solve(6); }
+END_TEST
+
+START_TEST(s21_structured_solve_07) {
+  matrix_t b = {0}, X = {0};
+  structured_rhs(&b);
+  s21_structured_t S;
+
+  s21_create_structured(9, STRUCTURE_UPPER, 0, 0, &S);
+  ck_assert_int_eq(s21_structured_solve(&S, &b, &X), CALC_ERROR);
+  ck_assert_ptr_null(X.matrix);
+  s21_remove_structured(&S);
+  s21_create_structured(9, STRUCTURE_BANDED, 1, 1, &S);
+  ck_assert_int_eq(s21_structured_solve(&S, &b, &X), CALC_ERROR);
+  ck_assert_ptr_null(X.matrix);
+
+  s21_remove_structured(&S);
+  s21_remove_matrix(&b);
+}
+END_TEST
+
+START_TEST(s21_structured_determinant_01) {
+  for (int c = 0; c < 7; c++) {
+    matrix_t dense = {0};
+    s21_structured_t S;
+    structured_case(c, &dense, &S);
+    double det = 0, expected = 0;
+
+    ck_assert_int_eq(s21_structured_determinant(&S, &det), OK);
+    s21_determinant(&dense, &expected);
+    ck_assert_double_eq_tol(det / expected, 1, 1e-12);
+
+    s21_remove_structured(&S);
+    s21_remove_matrix(&dense);
+  }
+}
+END_TEST
+
+START_TEST(s21_structured_determinant_02) {
+  s21_structured_t S;
+  double det = 1;
+
+  s21_create_structured(9, STRUCTURE_UPPER, 0, 0, &S);
+  ck_assert_int_eq(s21_structured_determinant(&S, &det), OK);
+  ck_assert_double_eq(det, 0);
+  s21_remove_structured(&S);
+  det = 1;
+  s21_create_structured(4, STRUCTURE_BANDED, 1, 1, &S);
+  ck_assert_int_eq(s21_structured_determinant(&S, &det), OK);
+  ck_assert_double_eq(det, 0);
+  s21_remove_structured(&S);
+}
+END_TEST
+
 int main() {
   Suite *s1 = suite_create("Core");
   TCase *tc_core = tcase_create("Core");
@@ -771,6 +3861,8 @@ int main() {
   tcase_add_test(tc_core, s21_create_matrix_04);
   tcase_add_test(tc_core, s21_create_matrix_05);
   tcase_add_test(tc_core, s21_create_matrix_06);
+  tcase_add_test(tc_core, s21_create_matrix_07);
+  tcase_add_test(tc_core, s21_create_matrix_08);
   tcase_add_test(tc_core, s21_eq_matrix_01);
   tcase_add_test(tc_core, s21_eq_matrix_02);
   tcase_add_test(tc_core, s21_eq_matrix_03);
@@ -778,6 +3870,8 @@ int main() {
   tcase_add_test(tc_core, s21_eq_matrix_05);
   tcase_add_test(tc_core, s21_sum_matrix_01);
   tcase_add_test(tc_core, s21_sum_matrix_02);
+  tcase_add_test(tc_core, s21_sum_matrix_03);
+  tcase_add_test(tc_core, s21_sum_matrix_04);
   tcase_add_test(tc_core, s21_sub_matrix_01);
   tcase_add_test(tc_core, s21_sub_matrix_02);
   tcase_add_test(tc_core, s21_sub_matrix_03);
@@ -787,20 +3881,176 @@ int main() {
   tcase_add_test(tc_core, s21_mult_matrix_04);
   tcase_add_test(tc_core, s21_mult_matrix_05);
   tcase_add_test(tc_core, s21_mult_matrix_06);
+  tcase_add_test(tc_core, s21_mult_matrix_07);
+  tcase_add_test(tc_core, s21_mult_matrix_08);
+  tcase_add_test(tc_core, s21_mult_matrix_09);
+  tcase_add_test(tc_core, s21_mult_matrix_10);
   tcase_add_test(tc_core, s21_mult_number_01);
   tcase_add_test(tc_core, s21_mult_number_03);
   tcase_add_test(tc_core, s21_mult_number_04);
+  tcase_add_test(tc_core, s21_mult_number_05);
   tcase_add_test(tc_core, s21_transpose_01);
   tcase_add_test(tc_core, s21_transpose_02);
   tcase_add_test(tc_core, s21_transpose_03);
+  tcase_add_test(tc_core, s21_transpose_04);
+  tcase_add_test(tc_core, s21_transpose_05);
   tcase_add_test(tc_core, s21_determinant_01);
   tcase_add_test(tc_core, s21_determinant_02);
+  tcase_add_test(tc_core, s21_determinant_03);
+  tcase_add_test(tc_core, s21_determinant_04);
+  tcase_add_test(tc_core, s21_determinant_05);
   tcase_add_test(tc_core, s21_calc_complements_01);
+  tcase_add_test(tc_core, s21_calc_complements_02);
   tcase_add_test(tc_core, s21_inverse_matrix_01);
   tcase_add_test(tc_core, s21_inverse_matrix_02);
   tcase_add_test(tc_core, s21_inverse_matrix_03);
   tcase_add_test(tc_core, s21_inverse_matrix_04);
   tcase_add_test(tc_core, s21_inverse_matrix_05);
+  tcase_add_test(tc_core, s21_inverse_matrix_06);
+  tcase_add_test(tc_core, s21_inverse_matrix_07);
+  tcase_add_test(tc_core, s21_arena_create_01);
+  tcase_add_test(tc_core, s21_arena_matrix_01);
+  tcase_add_test(tc_core, s21_arena_matrix_02);
+  tcase_add_test(tc_core, s21_arena_release_01);
+  tcase_add_test(tc_core, s21_arena_reset_01);
+  tcase_add_test(tc_core, s21_arena_destroy_01);
+  tcase_add_test(tc_core, s21_expr_eval_01);
+  tcase_add_test(tc_core, s21_expr_eval_02);
+  tcase_add_test(tc_core, s21_expr_eval_into_01);
+  tcase_add_test(tc_core, s21_expr_eval_into_02);
+  tcase_add_test(tc_core, s21_expr_eval_into_03);
+  tcase_add_test(tc_core, s21_expr_eval_into_04);
+  tcase_add_test(tc_core, s21_expr_load_01);
+  tcase_add_test(tc_core, s21_expr_load_02);
+  tcase_add_test(tc_core, s21_create_batch_01);
+  tcase_add_test(tc_core, s21_create_batch_02);
+  tcase_add_test(tc_core, s21_batch_pack_01);
+  tcase_add_test(tc_core, s21_batch_determinant_01);
+  tcase_add_test(tc_core, s21_batch_inverse_01);
+  tcase_add_test(tc_core, s21_batch_inverse_02);
+  tcase_add_test(tc_core, s21_batch_mult_01);
+  tcase_add_test(tc_core, s21_batch_mult_02);
+  tcase_add_test(tc_core, s21_batch_transpose_01);
+  tcase_add_test(tc_core, s21_batch_transpose_02);
+  tcase_add_test(tc_core, s21_small_determinant_01);
+  tcase_add_test(tc_core, s21_small_inverse_01);
+  tcase_add_test(tc_core, s21_small_inverse_02);
+  tcase_add_test(tc_core, s21_small_complements_01);
+  tcase_add_test(tc_core, s21_small_mult_01);
+  tcase_add_test(tc_core, s21_solve_01);
+  tcase_add_test(tc_core, s21_solve_02);
+  tcase_add_test(tc_core, s21_solve_03);
+  tcase_add_test(tc_core, s21_factor_lu_01);
+  tcase_add_test(tc_core, s21_factor_lu_02);
+  tcase_add_test(tc_core, s21_factor_lu_03);
+  tcase_add_test(tc_core, s21_factor_lu_04);
+  tcase_add_test(tc_core, s21_factor_solve_01);
+  tcase_add_test(tc_core, s21_factor_solve_into_01);
+  tcase_add_test(tc_core, s21_factor_solve_into_02);
+  tcase_add_test(tc_core, s21_factor_cholesky_01);
+  tcase_add_test(tc_core, s21_factor_cholesky_02);
+  tcase_add_test(tc_core, s21_factor_qr_01);
+  tcase_add_test(tc_core, s21_factor_qr_02);
+  tcase_add_test(tc_core, s21_factor_qr_03);
+  tcase_add_test(tc_core, s21_factor_qr_04);
+  tcase_add_test(tc_core, s21_factor_determinant_01);
+  tcase_add_test(tc_core, s21_factor_inverse_01);
+  tcase_add_test(tc_core, s21_sparse_01);
+  tcase_add_test(tc_core, s21_sparse_02);
+  tcase_add_test(tc_core, s21_sparse_03);
+  tcase_add_test(tc_core, s21_sparse_04);
+  tcase_add_test(tc_core, s21_sparse_05);
+  tcase_add_test(tc_core, s21_sparse_06);
+  tcase_add_test(tc_core, s21_sparse_07);
+  tcase_add_test(tc_core, s21_save_matrix_01);
+  tcase_add_test(tc_core, s21_save_matrix_02);
+  tcase_add_test(tc_core, s21_save_matrix_03);
+  tcase_add_test(tc_core, s21_load_matrix_01);
+  tcase_add_test(tc_core, s21_load_matrix_02);
+  tcase_add_test(tc_core, s21_load_matrix_03);
+  tcase_add_test(tc_core, s21_map_matrix_01);
+  tcase_add_test(tc_core, s21_map_matrix_02);
+  tcase_add_test(tc_core, s21_mult_matrix_file_01);
+  tcase_add_test(tc_core, s21_mult_matrix_file_02);
+  tcase_add_test(tc_core, s21_mult_matrix_file_03);
+  tcase_add_test(tc_core, s21_mult_matrix_file_04);
+  tcase_add_test(tc_core, s21_mult_matrix_file_05);
+  tcase_add_test(tc_core, s21_mult_matrix_file_06);
+  tcase_add_test(tc_core, s21_matrix_to_f32_01);
+  tcase_add_test(tc_core, s21_matrix_to_f32_02);
+  tcase_add_test(tc_core, s21_mult_matrix_f32_01);
+  tcase_add_test(tc_core, s21_mult_matrix_f32_02);
+  tcase_add_test(tc_core, s21_mult_matrix_f32_mixed_01);
+  tcase_add_test(tc_core, s21_transpose_f32_01);
+  tcase_add_test(tc_core, s21_sum_matrix_f32_01);
+  tcase_add_test(tc_core, s21_sum_matrix_f32_02);
+  tcase_add_test(tc_core, s21_sub_matrix_f32_01);
+  tcase_add_test(tc_core, s21_mult_number_f32_01);
+  tcase_add_test(tc_core, s21_determinant_f32_01);
+  tcase_add_test(tc_core, s21_inverse_matrix_f32_01);
+  tcase_add_test(tc_core, s21_calc_complements_f32_01);
+  tcase_add_test(tc_core, s21_solve_mixed_01);
+  tcase_add_test(tc_core, s21_solve_mixed_02);
+  tcase_add_test(tc_core, s21_solve_mixed_03);
+  tcase_add_test(tc_core, s21_solve_mixed_04);
+  tcase_add_test(tc_core, s21_stats_snapshot_01);
+  tcase_add_test(tc_core, s21_stats_snapshot_02);
+  tcase_add_test(tc_core, s21_stats_snapshot_03);
+  tcase_add_test(tc_core, s21_stats_reset_01);
+  tcase_add_test(tc_core, s21_stats_json_01);
+  tcase_add_test(tc_core, s21_probe_name_01);
+  tcase_add_test(tc_core, s21_set_trace_hook_01);
+  tcase_add_test(tc_core, s21_view_matrix_01);
+  tcase_add_test(tc_core, s21_view_block_01);
+  tcase_add_test(tc_core, s21_view_row_01);
+  tcase_add_test(tc_core, s21_view_column_01);
+  tcase_add_test(tc_core, s21_view_transpose_01);
+  tcase_add_test(tc_core, s21_view_as_matrix_01);
+  tcase_add_test(tc_core, s21_view_as_matrix_02);
+  tcase_add_test(tc_core, s21_view_as_matrix_03);
+  tcase_add_test(tc_core, s21_view_copy_01);
+  tcase_add_test(tc_core, s21_view_sum_01);
+  tcase_add_test(tc_core, s21_view_sum_02);
+  tcase_add_test(tc_core, s21_view_sub_01);
+  tcase_add_test(tc_core, s21_view_scale_01);
+  tcase_add_test(tc_core, s21_view_mult_01);
+  tcase_add_test(tc_core, s21_view_mult_02);
+  tcase_add_test(tc_core, s21_view_mult_03);
+  tcase_add_test(tc_core, s21_view_determinant_01);
+  tcase_add_test(tc_core, s21_set_strassen_crossover_01);
+  tcase_add_test(tc_core, s21_strassen_01);
+  tcase_add_test(tc_core, s21_strassen_02);
+  tcase_add_test(tc_core, s21_strassen_03);
+  tcase_add_test(tc_core, s21_create_vector_01);
+  tcase_add_test(tc_core, s21_matrix_as_vector_01);
+  tcase_add_test(tc_core, s21_gemv_01);
+  tcase_add_test(tc_core, s21_gemv_02);
+  tcase_add_test(tc_core, s21_gemv_t_01);
+  tcase_add_test(tc_core, s21_gemv_t_02);
+  tcase_add_test(tc_core, s21_dot_01);
+  tcase_add_test(tc_core, s21_dot_02);
+  tcase_add_test(tc_core, s21_axpy_01);
+  tcase_add_test(tc_core, s21_axpy_02);
+  tcase_add_test(tc_core, s21_norm1_01);
+  tcase_add_test(tc_core, s21_norm2_01);
+  tcase_add_test(tc_core, s21_norm2_02);
+  tcase_add_test(tc_core, s21_norm_inf_01);
+  tcase_add_test(tc_core, s21_norm_inf_02);
+  tcase_add_test(tc_core, s21_vector_01);
+  tcase_add_test(tc_core, s21_create_structured_01);
+  tcase_add_test(tc_core, s21_structured_from_dense_01);
+  tcase_add_test(tc_core, s21_structured_mult_dense_01);
+  tcase_add_test(tc_core, s21_structured_mult_vector_01);
+  tcase_add_test(tc_core, s21_structured_mult_vector_02);
+  tcase_add_test(tc_core, s21_structured_solve_01);
+  tcase_add_test(tc_core, s21_structured_solve_02);
+  tcase_add_test(tc_core, s21_structured_solve_03);
+  tcase_add_test(tc_core, s21_structured_solve_04);
+  tcase_add_test(tc_core, s21_structured_solve_05);
+  tcase_add_test(tc_core, s21_structured_solve_06);
+  tcase_add_test(tc_core, s21_structured_solve_07);
+  tcase_add_test(tc_core, s21_structured_determinant_01);
+  tcase_add_test(tc_core, s21_structured_determinant_02);
 
   srunner_run_all(sr, CK_ENV);
   nf = srunner_ntests_failed(sr);